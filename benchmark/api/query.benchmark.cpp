@@ -11,6 +11,7 @@
 #include <mbgl/util/image.hpp>
 #include <mbgl/util/io.hpp>
 #include <mbgl/util/run_loop.hpp>
+#include <mbgl/util/async_request.hpp>
 
 using namespace mbgl;
 
@@ -67,6 +68,45 @@ static void API_queryRenderedFeaturesLayerFromHighDensity(::benchmark::State& st
     }
 }
 
+// Reads only the identifier and one property of each feature, as most callers do.
+static void API_queryRenderedFeaturesAllLazy(::benchmark::State& state) {
+    QueryBenchmark bench;
+
+    while (state.KeepRunning()) {
+        for (const auto& feature : bench.map.queryRenderedFeaturesLazy(bench.box)) {
+            ::benchmark::DoNotOptimize(bool(feature.getID()));
+            ::benchmark::DoNotOptimize(bool(feature.getProperty("class")));
+        }
+    }
+}
+
+// Converts each feature with only the properties it needs.
+static void API_queryRenderedFeaturesAllSelectedProperties(::benchmark::State& state) {
+    QueryBenchmark bench;
+    const std::vector<std::string> keys { "class", "name" };
+
+    while (state.KeepRunning()) {
+        for (const auto& feature : bench.map.queryRenderedFeaturesLazy(bench.box)) {
+            ::benchmark::DoNotOptimize(feature.toFeature(keys).properties.size());
+        }
+    }
+}
+
+// Queries the tiles in parallel on the thread pool, and waits for the result.
+static void API_queryRenderedFeaturesAllAsync(::benchmark::State& state) {
+    QueryBenchmark bench;
+
+    while (state.KeepRunning()) {
+        auto request = bench.map.queryRenderedFeatures(bench.box, {}, [&] (std::vector<Feature>) {
+            bench.loop.stop();
+        });
+        bench.loop.run();
+    }
+}
+
 BENCHMARK(API_queryRenderedFeaturesAll);
 BENCHMARK(API_queryRenderedFeaturesLayerFromLowDensity);
 BENCHMARK(API_queryRenderedFeaturesLayerFromHighDensity);
+BENCHMARK(API_queryRenderedFeaturesAllLazy);
+BENCHMARK(API_queryRenderedFeaturesAllSelectedProperties);
+BENCHMARK(API_queryRenderedFeaturesAllAsync);
@@ -0,0 +1,96 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/map/map.hpp>
+#include <mbgl/gl/headless_backend.hpp>
+#include <mbgl/gl/offscreen_view.hpp>
+#include <mbgl/util/default_thread_pool.hpp>
+#include <mbgl/sprite/sprite_image.hpp>
+#include <mbgl/storage/default_file_source.hpp>
+#include <mbgl/storage/network_status.hpp>
+#include <mbgl/util/image.hpp>
+#include <mbgl/util/io.hpp>
+#include <mbgl/util/run_loop.hpp>
+
+using namespace mbgl;
+
+namespace {
+
+// Continuous rendering is driven by the benchmark itself, so repaint requests are ignored.
+class RenderBackend : public HeadlessBackend {
+public:
+    void invalidate() override {}
+};
+
+class RenderBenchmark {
+public:
+    RenderBenchmark() {
+        NetworkStatus::Set(NetworkStatus::Status::Offline);
+        fileSource.setAccessToken("foobar");
+
+        map.setStyleJSON(util::read_file("benchmark/fixtures/api/query_style.json"));
+        map.setLatLngZoom({ 40.726989, -73.992857 }, 15); // Manhattan
+
+        auto decoded = decodeImage(util::read_file("benchmark/fixtures/api/default_marker.png"));
+        auto image = std::make_unique<SpriteImage>(std::move(decoded), 1.0);
+        map.addImage("test-icon", std::move(image));
+
+        renderFrame();
+    }
+
+    // Renders frames until every tile has been laid out and placed for the current camera.
+    void renderFrame() {
+        map.render(view);
+        while (!map.isFullyLoaded()) {
+            loop.runOnce();
+            map.render(view);
+        }
+    }
+
+    util::RunLoop loop;
+    RenderBackend backend;
+    OffscreenView view{ backend.getContext(), { 1000, 1000 } };
+    DefaultFileSource fileSource{ "benchmark/fixtures/api/cache.db", "." };
+    ThreadPool threadPool{ 4 };
+    Map map{ backend, view.size, 1, fileSource, threadPool, MapMode::Continuous };
+};
+
+} // end namespace
+
+// A rotation gesture that sweeps back and forth, one degree per frame.
+static void API_renderRotation(::benchmark::State& state) {
+    RenderBenchmark bench;
+    int bearing = 0;
+    int step = 1;
+
+    while (state.KeepRunning()) {
+        if (bearing == 30) {
+            step = -1;
+        } else if (bearing == -30) {
+            step = 1;
+        }
+        bearing += step;
+        bench.map.setBearing(bearing);
+        bench.renderFrame();
+    }
+}
+
+// A pitch gesture that sweeps back and forth, one degree per frame.
+static void API_renderPitch(::benchmark::State& state) {
+    RenderBenchmark bench;
+    int pitch = 0;
+    int step = 1;
+
+    while (state.KeepRunning()) {
+        if (pitch == 60) {
+            step = -1;
+        } else if (pitch == 0) {
+            step = 1;
+        }
+        pitch += step;
+        bench.map.setPitch(pitch);
+        bench.renderFrame();
+    }
+}
+
+BENCHMARK(API_renderRotation);
+BENCHMARK(API_renderPitch);
@@ -0,0 +1,91 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/style/function/camera_function.hpp>
+#include <mbgl/style/function/composite_function.hpp>
+#include <mbgl/tile/geometry_tile_data.hpp>
+
+using namespace mbgl;
+using namespace mbgl::style;
+
+namespace {
+
+// A typical road width function: exponential growth over a wide zoom range.
+ExponentialStops<float> roadWidth() {
+    return { { { 5, 0.5 }, { 10, 1 }, { 13, 2 }, { 16, 8 }, { 18, 24 }, { 20, 64 } }, 1.5 };
+}
+
+// A typical fade-in: linear opacity over a couple of zoom levels.
+ExponentialStops<float> opacity() {
+    return { { { 12, 0 }, { 14, 1 } }, 1 };
+}
+
+// Sweeps the zoom level the way a continuous zoom gesture would.
+template <class Evaluate>
+void evaluateAcrossZooms(benchmark::State& state, Evaluate&& evaluate) {
+    std::size_t evaluations = 0;
+    while (state.KeepRunning()) {
+        for (float zoom = 0; zoom < 22; zoom += 0.1f) {
+            benchmark::DoNotOptimize(evaluate(zoom));
+            ++evaluations;
+        }
+    }
+    state.SetItemsProcessed(evaluations);
+}
+
+class RoadFeature : public GeometryTileFeature {
+public:
+    FeatureType getType() const override { return FeatureType::LineString; }
+    optional<Value> getValue(const std::string&) const override { return { uint64_t(3) }; }
+    GeometryCollection getGeometries() const override { return {}; }
+};
+
+} // namespace
+
+static void Function_RoadWidthStops(benchmark::State& state) {
+    const ExponentialStops<float> stops = roadWidth();
+    evaluateAcrossZooms(state, [&] (float zoom) {
+        return stops.evaluate(Value(double(zoom))).value_or(0.0f);
+    });
+}
+
+static void Function_RoadWidthCompiled(benchmark::State& state) {
+    const CameraFunction<float> function(roadWidth());
+    evaluateAcrossZooms(state, [&] (float zoom) {
+        return function.evaluate(zoom);
+    });
+}
+
+static void Function_OpacityStops(benchmark::State& state) {
+    const ExponentialStops<float> stops = opacity();
+    evaluateAcrossZooms(state, [&] (float zoom) {
+        return stops.evaluate(Value(double(zoom))).value_or(0.0f);
+    });
+}
+
+static void Function_OpacityCompiled(benchmark::State& state) {
+    const CameraFunction<float> function(opacity());
+    evaluateAcrossZooms(state, [&] (float zoom) {
+        return function.evaluate(zoom);
+    });
+}
+
+// Road width by zoom and road class, evaluated per feature as during symbol layout.
+static void Function_RoadWidthComposite(benchmark::State& state) {
+    std::map<float, ExponentialStops<float>> stops;
+    for (float zoom : { 5, 10, 13, 16, 18, 20 }) {
+        stops.emplace(zoom, ExponentialStops<float> { { { 1, zoom / 4 }, { 3, zoom / 2 }, { 5, zoom } }, 1 });
+    }
+
+    const CompositeFunction<float> function("class", stops);
+    const RoadFeature feature;
+
+    evaluateAcrossZooms(state, [&] (float zoom) {
+        return function.evaluate(zoom, feature, 0.0f);
+    });
+}
+
+BENCHMARK(Function_RoadWidthStops);
+BENCHMARK(Function_RoadWidthCompiled);
+BENCHMARK(Function_OpacityStops);
+BENCHMARK(Function_OpacityCompiled);
+BENCHMARK(Function_RoadWidthComposite);
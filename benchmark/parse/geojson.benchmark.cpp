@@ -0,0 +1,112 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/style/sources/geojson_reader.hpp>
+#include <mbgl/style/conversion/geojson.hpp>
+#include <mbgl/util/rapidjson.hpp>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+
+using namespace mbgl;
+
+namespace {
+
+// A feature collection of alternating point and polygon features, roughly `count` * 250 bytes.
+std::string generateGeoJSON(std::size_t count) {
+    std::ostringstream out;
+    out << R"({"type":"FeatureCollection","features":[)";
+    for (std::size_t i = 0; i < count; i++) {
+        const double x = double(i % 360) - 180;
+        const double y = double(i % 170) - 85;
+        out << (i ? "," : "") << R"({"type":"Feature","id":)" << i
+            << R"(,"properties":{"name":"feature )" << i << R"(","rank":)" << i % 10 << "},";
+        if (i % 2) {
+            out << R"("geometry":{"type":"Polygon","coordinates":[[)"
+                << "[" << x << "," << y << "],[" << x + 0.5 << "," << y << "],"
+                << "[" << x + 0.5 << "," << y + 0.5 << "],[" << x << "," << y + 0.5 << "],"
+                << "[" << x << "," << y << "]]]}}";
+        } else {
+            out << R"("geometry":{"type":"Point","coordinates":[)" << x << "," << y << "]}}";
+        }
+    }
+    out << "]}";
+    return out.str();
+}
+
+const std::string& largeGeoJSON() {
+    static const std::string json = generateGeoJSON(200000);
+    return json;
+}
+
+// Measures the growth of peak resident memory while running a benchmark. On Linux, the peak
+// can be reset between benchmarks; elsewhere no measurement is reported.
+class PeakMemory {
+public:
+    PeakMemory() {
+#if defined(__linux__)
+        std::ofstream("/proc/self/clear_refs") << "5";
+        baseline = read("VmRSS:");
+#endif
+    }
+
+    std::string label() const {
+#if defined(__linux__)
+        std::ostringstream out;
+        out << "peak RSS +" << (read("VmHWM:") - baseline) / 1024 << " MiB";
+        return out.str();
+#else
+        return {};
+#endif
+    }
+
+private:
+#if defined(__linux__)
+    // Returns the named /proc/self/status entry, in KiB.
+    static std::size_t read(const std::string& name) {
+        std::ifstream status("/proc/self/status");
+        std::string line;
+        while (std::getline(status, line)) {
+            if (line.compare(0, name.size(), name) == 0) {
+                return std::stoul(line.substr(name.size()));
+            }
+        }
+        return 0;
+    }
+
+    std::size_t baseline = 0;
+#endif
+};
+
+} // namespace
+
+static void Parse_GeoJSONDocument(benchmark::State& state) {
+    const std::string& json = largeGeoJSON();
+    PeakMemory memory;
+
+    while (state.KeepRunning()) {
+        rapidjson::GenericDocument<rapidjson::UTF8<>, rapidjson::CrtAllocator> document;
+        document.Parse<0>(json.c_str());
+        auto geoJSON = style::conversion::convertGeoJSON<JSValue>(document);
+        benchmark::DoNotOptimize(geoJSON);
+    }
+
+    state.SetBytesProcessed(state.iterations() * json.size());
+    state.SetLabel(memory.label());
+}
+
+static void Parse_GeoJSONStream(benchmark::State& state) {
+    const std::string& json = largeGeoJSON();
+    PeakMemory memory;
+
+    while (state.KeepRunning()) {
+        auto geoJSON = style::readGeoJSON(json);
+        benchmark::DoNotOptimize(geoJSON);
+    }
+
+    state.SetBytesProcessed(state.iterations() * json.size());
+    state.SetLabel(memory.label());
+}
+
+BENCHMARK(Parse_GeoJSONDocument);
+BENCHMARK(Parse_GeoJSONStream);
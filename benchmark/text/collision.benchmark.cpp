@@ -0,0 +1,234 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/text/collision_tile.hpp>
+#include <mbgl/util/constants.hpp>
+#include <mbgl/util/math.hpp>
+#include <mbgl/math/minmax.hpp>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#pragma GCC diagnostic ignored "-Wshadow"
+#ifdef __clang__
+#pragma GCC diagnostic ignored "-Wunknown-pragmas"
+#endif
+#pragma GCC diagnostic ignored "-Wpragmas"
+#pragma GCC diagnostic ignored "-Wdeprecated-register"
+#pragma GCC diagnostic ignored "-Wshorten-64-to-32"
+#pragma GCC diagnostic ignored "-Wunused-local-typedefs"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#include <boost/geometry.hpp>
+#include <boost/geometry/geometries/point.hpp>
+#include <boost/geometry/geometries/box.hpp>
+#include <boost/geometry/index/rtree.hpp>
+#pragma GCC diagnostic pop
+
+#include <array>
+#include <cmath>
+#include <limits>
+#include <random>
+
+using namespace mbgl;
+
+namespace bg = boost::geometry;
+namespace bgi = boost::geometry::index;
+
+namespace {
+
+// A dense label tile: point labels scattered over the tile, each sized like a short name in
+// a 12px font at a tile pixel ratio of 16.
+std::vector<CollisionFeature> denseLabels(std::size_t count) {
+    std::mt19937 rng(0);
+    std::uniform_int_distribution<int16_t> position(0, util::EXTENT);
+    std::uniform_real_distribution<float> width(20, 80);
+
+    std::vector<CollisionFeature> features;
+    features.reserve(count);
+    for (std::size_t i = 0; i < count; i++) {
+        const GeometryCoordinate point(position(rng), position(rng));
+        const float halfWidth = width(rng);
+        features.emplace_back(GeometryCoordinates(), Anchor(point.x, point.y, 0, 0.5f, 0),
+                              -10, 10, -halfWidth, halfWidth, 16, 0, style::SymbolPlacementType::Point,
+                              IndexedSubfeature { i, 0, 0, i }, false);
+    }
+    return features;
+}
+
+// CollisionTile's placement as it was before boxes moved into a grid: the same rotation,
+// y-stretch, overlap and edge handling, with boxes in boost R-trees. Kept here so both
+// implementations run on identical inputs.
+class RTreeCollisionTile {
+public:
+    explicit RTreeCollisionTile(PlacementConfig config_) : config(std::move(config_)) {
+        const float angle_sin = std::sin(config.angle);
+        const float angle_cos = std::cos(config.angle);
+        rotationMatrix = { { angle_cos, -angle_sin, angle_sin, angle_cos } };
+        reverseRotationMatrix = { { angle_cos, angle_sin, -angle_sin, angle_cos } };
+        yStretch = std::pow(1.0f / std::cos(config.pitch), 1.3f);
+    }
+
+    float placeFeature(const CollisionFeature& feature, bool allowOverlap, bool avoidEdges) {
+        static const float infinity = std::numeric_limits<float>::infinity();
+        static const std::array<CollisionBox, 4> edges {{
+            CollisionBox(Point<float>(0, 0), 0, -infinity, 0, infinity, infinity),
+            CollisionBox(Point<float>(util::EXTENT, 0), 0, -infinity, 0, infinity, infinity),
+            CollisionBox(Point<float>(0, 0), -infinity, 0, infinity, 0, infinity),
+            CollisionBox(Point<float>(0, util::EXTENT), -infinity, 0, infinity, 0, infinity)
+        }};
+
+        float minPlacementScale = minScale;
+
+        for (auto& box : feature.boxes) {
+            const auto anchor = util::matrixMultiply(rotationMatrix, box.anchor);
+
+            if (!allowOverlap) {
+                for (auto it = tree.qbegin(bgi::intersects(getTreeBox(anchor, box))); it != tree.qend(); ++it) {
+                    const CollisionBox& blocking = std::get<1>(*it);
+                    Point<float> blockingAnchor = util::matrixMultiply(rotationMatrix, blocking.anchor);
+
+                    minPlacementScale = util::max(minPlacementScale, findPlacementScale(anchor, box, blockingAnchor, blocking));
+                    if (minPlacementScale >= maxScale) return minPlacementScale;
+                }
+            }
+
+            if (avoidEdges) {
+                const Point<float> rtl = util::matrixMultiply(reverseRotationMatrix, { box.x1, box.y1 });
+                const Point<float> rtr = util::matrixMultiply(reverseRotationMatrix, { box.x2, box.y1 });
+                const Point<float> rbl = util::matrixMultiply(reverseRotationMatrix, { box.x1, box.y2 });
+                const Point<float> rbr = util::matrixMultiply(reverseRotationMatrix, { box.x2, box.y2 });
+                CollisionBox rotatedBox(box.anchor,
+                        util::min(rtl.x, rtr.x, rbl.x, rbr.x),
+                        util::min(rtl.y, rtr.y, rbl.y, rbr.y),
+                        util::max(rtl.x, rtr.x, rbl.x, rbr.x),
+                        util::max(rtl.y, rtr.y, rbl.y, rbr.y),
+                        box.maxScale);
+
+                for (auto& blocking : edges) {
+                    minPlacementScale = util::max(minPlacementScale, findPlacementScale(box.anchor, rotatedBox, blocking.anchor, blocking));
+                    if (minPlacementScale >= maxScale) return minPlacementScale;
+                }
+            }
+        }
+
+        return minPlacementScale;
+    }
+
+    void insertFeature(CollisionFeature& feature, float minPlacementScale, bool ignorePlacement) {
+        for (auto& box : feature.boxes) {
+            box.placementScale = minPlacementScale;
+        }
+
+        if (minPlacementScale < maxScale) {
+            std::vector<TreeBox> treeBoxes;
+            for (auto& box : feature.boxes) {
+                treeBoxes.emplace_back(getTreeBox(util::matrixMultiply(rotationMatrix, box.anchor), box), box, feature.indexedFeature);
+            }
+            if (ignorePlacement) {
+                ignoredTree.insert(treeBoxes.begin(), treeBoxes.end());
+            } else {
+                tree.insert(treeBoxes.begin(), treeBoxes.end());
+            }
+        }
+    }
+
+private:
+    using TreePoint = bg::model::point<float, 2, bg::cs::cartesian>;
+    using Box = bg::model::box<TreePoint>;
+    using TreeBox = std::tuple<Box, CollisionBox, IndexedSubfeature>;
+    using Tree = bgi::rtree<TreeBox, bgi::linear<16, 4>>;
+
+    float findPlacementScale(const Point<float>& anchor, const CollisionBox& box,
+                             const Point<float>& blockingAnchor, const CollisionBox& blocking) const {
+        float minPlacementScale = minScale;
+
+        float s1 = (blocking.x1 - box.x2) / (anchor.x - blockingAnchor.x);
+        float s2 = (blocking.x2 - box.x1) / (anchor.x - blockingAnchor.x);
+        float s3 = (blocking.y1 - box.y2) * yStretch / (anchor.y - blockingAnchor.y);
+        float s4 = (blocking.y2 - box.y1) * yStretch / (anchor.y - blockingAnchor.y);
+
+        if (std::isnan(s1) || std::isnan(s2)) s1 = s2 = 1;
+        if (std::isnan(s3) || std::isnan(s4)) s3 = s4 = 1;
+
+        float collisionFreeScale = util::min(util::max(s1, s2), util::max(s3, s4));
+
+        if (collisionFreeScale > blocking.maxScale) {
+            collisionFreeScale = blocking.maxScale;
+        }
+
+        if (collisionFreeScale > box.maxScale) {
+            collisionFreeScale = box.maxScale;
+        }
+
+        if (collisionFreeScale > minPlacementScale &&
+                collisionFreeScale >= blocking.placementScale) {
+            minPlacementScale = collisionFreeScale;
+        }
+
+        return minPlacementScale;
+    }
+
+    Box getTreeBox(const Point<float>& anchor, const CollisionBox& box) const {
+        return Box {
+            TreePoint { anchor.x + box.x1, anchor.y + box.y1 * yStretch },
+            TreePoint { anchor.x + box.x2, anchor.y + box.y2 * yStretch }
+        };
+    }
+
+    const PlacementConfig config;
+    const float minScale = 0.5f;
+    const float maxScale = 2.0f;
+    float yStretch;
+    std::array<float, 4> rotationMatrix;
+    std::array<float, 4> reverseRotationMatrix;
+
+    Tree tree;
+    Tree ignoredTree;
+};
+
+// The second benchmark argument selects the camera: 0 for a flat, north-up map, 1 for a
+// rotated and pitched one.
+PlacementConfig placementConfig(int64_t camera) {
+    return camera ? PlacementConfig { 0.5f, 0.5f } : PlacementConfig {};
+}
+
+// Places every label as SymbolLayout does for text that neither overlaps nor ignores
+// placement, and avoids the tile edges.
+template <class Tile>
+void placeLabels(Tile& tile, std::vector<CollisionFeature>& features) {
+    for (auto& feature : features) {
+        const float scale = tile.placeFeature(feature, false, true);
+        tile.insertFeature(feature, scale, false);
+        benchmark::DoNotOptimize(scale);
+    }
+}
+
+} // namespace
+
+static void Collision_PlaceRTree(benchmark::State& state) {
+    const std::vector<CollisionFeature> labels = denseLabels(state.range(0));
+    const PlacementConfig config = placementConfig(state.range(1));
+    while (state.KeepRunning()) {
+        RTreeCollisionTile tile(config);
+        std::vector<CollisionFeature> features = labels;
+        placeLabels(tile, features);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void Collision_PlaceGrid(benchmark::State& state) {
+    const std::vector<CollisionFeature> labels = denseLabels(state.range(0));
+    const PlacementConfig config = placementConfig(state.range(1));
+    while (state.KeepRunning()) {
+        CollisionTile tile(config);
+        std::vector<CollisionFeature> features = labels;
+        placeLabels(tile, features);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(Collision_PlaceRTree)
+    ->ArgPair(500, 0)->ArgPair(2000, 0)->ArgPair(8000, 0)
+    ->ArgPair(500, 1)->ArgPair(2000, 1)->ArgPair(8000, 1);
+BENCHMARK(Collision_PlaceGrid)
+    ->ArgPair(500, 0)->ArgPair(2000, 0)->ArgPair(8000, 0)
+    ->ArgPair(500, 1)->ArgPair(2000, 1)->ArgPair(8000, 1);
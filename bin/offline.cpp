@@ -25,6 +25,8 @@ int main(int argc, char *argv[]) {
     double north = 37.2, west = -122.8, south = 38.1, east = -121.7; // Bay area
     double minZoom = 0.0, maxZoom = 15.0, pixelRatio = 1.0;
     std::string output = "offline.db";
+    std::string importPath;
+    std::string exportPath;
 
     const char* tokenEnv = getenv("MAPBOX_ACCESS_TOKEN");
     std::string token = tokenEnv ? tokenEnv : std::string();
@@ -41,6 +43,8 @@ int main(int argc, char *argv[]) {
         ("pixelRatio", po::value(&pixelRatio)->value_name("number")->default_value(pixelRatio), "Pixel ratio")
         ("token,t", po::value(&token)->value_name("key")->default_value(token), "Mapbox access token")
         ("output,o", po::value(&output)->value_name("file")->default_value(output), "Output database file name")
+        ("import", po::value(&importPath)->value_name("file"), "Import the regions in an exported database file into the output database instead of downloading")
+        ("export", po::value(&exportPath)->value_name("file"), "Export the region to a standalone database file once it has been downloaded")
     ;
 
     try {
@@ -60,16 +64,35 @@ int main(int argc, char *argv[]) {
 
     fileSource.setAccessToken(token);
 
+    if (!importPath.empty()) {
+        auto start = util::now();
+        fileSource.importOfflineRegions(importPath, [&] (std::exception_ptr error, optional<std::vector<OfflineRegion>> regions) {
+            if (error) {
+                std::cerr << "Error importing regions: " << util::toString(error) << std::endl;
+                loop.stop();
+                exit(1);
+            }
+
+            std::cout << "Imported " << regions->size() << " region(s) in "
+                      << std::chrono::duration_cast<Seconds>(util::now() - start).count() << " seconds" << std::endl;
+            loop.stop();
+        });
+
+        loop.run();
+        return 0;
+    }
+
     LatLngBounds boundingBox = LatLngBounds::hull(LatLng(north, west), LatLng(south, east));
     OfflineTilePyramidRegionDefinition definition(style, boundingBox, minZoom, maxZoom, pixelRatio);
     OfflineRegionMetadata metadata;
 
     class Observer : public OfflineRegionObserver {
     public:
-        Observer(OfflineRegion& region_, DefaultFileSource& fileSource_, util::RunLoop& loop_)
+        Observer(OfflineRegion& region_, DefaultFileSource& fileSource_, util::RunLoop& loop_, std::string exportPath_)
             : region(region_),
               fileSource(fileSource_),
               loop(loop_),
+              exportPath(std::move(exportPath_)),
               start(util::now()) {
         }
 
@@ -96,7 +119,19 @@ int main(int argc, char *argv[]) {
 
             if (status.complete()) {
                 std::cout << "Finished" << std::endl;
-                loop.stop();
+                if (exportPath.empty()) {
+                    loop.stop();
+                    return;
+                }
+
+                fileSource.exportOfflineRegion(region, exportPath, [this] (std::exception_ptr error) {
+                    if (error) {
+                        std::cerr << "Error exporting region: " << util::toString(error) << std::endl;
+                    } else {
+                        std::cout << "Exported to " << exportPath << std::endl;
+                    }
+                    loop.stop();
+                });
             }
         }
 
@@ -111,6 +146,7 @@ int main(int argc, char *argv[]) {
         OfflineRegion& region;
         DefaultFileSource& fileSource;
         util::RunLoop& loop;
+        std::string exportPath;
         Timestamp start;
     };
 
@@ -131,7 +167,7 @@ int main(int argc, char *argv[]) {
         } else {
             assert(region_);
             region = std::make_unique<OfflineRegion>(std::move(*region_));
-            fileSource.setOfflineRegionObserver(*region, std::make_unique<Observer>(*region, fileSource, loop));
+            fileSource.setOfflineRegionObserver(*region, std::make_unique<Observer>(*region, fileSource, loop, exportPath));
             fileSource.setOfflineRegionDownloadState(*region, OfflineRegionDownloadState::Active);
         }
     });
@@ -0,0 +1,48 @@
+#include <mbgl/style/binary_style.hpp>
+#include <mbgl/util/io.hpp>
+
+#include <cstdlib>
+#include <iostream>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunknown-pragmas"
+#pragma GCC diagnostic ignored "-Wunused-local-typedefs"
+#pragma GCC diagnostic ignored "-Wshadow"
+#include <boost/program_options.hpp>
+#pragma GCC diagnostic pop
+
+namespace po = boost::program_options;
+
+int main(int argc, char *argv[]) {
+    std::string input;
+    std::string output;
+    bool decode = false;
+
+    po::options_description desc("Allowed options");
+    desc.add_options()
+        ("input,i", po::value(&input)->value_name("file")->required(), "Style file to convert")
+        ("output,o", po::value(&output)->value_name("file")->required(), "Converted style file name")
+        ("decode,d", po::bool_switch(&decode), "Convert a binary style back to JSON instead of encoding JSON")
+    ;
+
+    try {
+        po::variables_map vm;
+        po::store(po::parse_command_line(argc, argv, desc), vm);
+        po::notify(vm);
+    } catch(std::exception& e) {
+        std::cout << "Error: " << e.what() << std::endl << desc;
+        exit(1);
+    }
+
+    using namespace mbgl;
+
+    try {
+        const std::string data = util::read_file(input);
+        util::write_file(output, decode ? style::decodeBinaryStyle(data) : style::encodeBinaryStyle(data));
+    } catch (std::exception& e) {
+        std::cerr << "Error converting " << input << ": " << e.what() << std::endl;
+        exit(1);
+    }
+
+    return 0;
+}
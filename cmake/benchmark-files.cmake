@@ -3,12 +3,17 @@
 set(MBGL_BENCHMARK_FILES
     # api
     benchmark/api/query.benchmark.cpp
+    benchmark/api/render.benchmark.cpp
+
+    # function
+    benchmark/function/function.benchmark.cpp
 
     # include/mbgl
     benchmark/include/mbgl/benchmark.hpp
 
     # parse
     benchmark/parse/filter.benchmark.cpp
+    benchmark/parse/geojson.benchmark.cpp
 
     # src
     benchmark/src/main.cpp
@@ -17,4 +22,7 @@ set(MBGL_BENCHMARK_FILES
     benchmark/src/mbgl/benchmark/benchmark.cpp
     benchmark/src/mbgl/benchmark/util.cpp
     benchmark/src/mbgl/benchmark/util.hpp
+
+    # text
+    benchmark/text/collision.benchmark.cpp
 )
@@ -107,6 +107,7 @@ set(MBGL_CORE_FILES
     include/mbgl/map/camera.hpp
     include/mbgl/map/map.hpp
     include/mbgl/map/mode.hpp
+    include/mbgl/map/query.hpp
     include/mbgl/map/view.hpp
     src/mbgl/map/backend.cpp
     src/mbgl/map/change.hpp
@@ -229,11 +230,13 @@ set(MBGL_CORE_FILES
     src/mbgl/storage/asset_file_source.hpp
     src/mbgl/storage/http_file_source.hpp
     src/mbgl/storage/local_file_source.hpp
+    src/mbgl/storage/mbtiles_file_source.hpp
     src/mbgl/storage/network_status.cpp
     src/mbgl/storage/resource.cpp
     src/mbgl/storage/response.cpp
 
     # style
+    include/mbgl/style/binary_style.hpp
     include/mbgl/style/conversion.hpp
     include/mbgl/style/data_driven_property_value.hpp
     include/mbgl/style/filter.hpp
@@ -244,6 +247,8 @@ set(MBGL_CORE_FILES
     include/mbgl/style/transition_options.hpp
     include/mbgl/style/types.hpp
     include/mbgl/style/undefined.hpp
+    src/mbgl/style/binary_style.cpp
+    src/mbgl/style/binary_style_reader.hpp
     src/mbgl/style/bucket_parameters.cpp
     src/mbgl/style/bucket_parameters.hpp
     src/mbgl/style/cascade_parameters.hpp
@@ -262,8 +267,11 @@ set(MBGL_CORE_FILES
     src/mbgl/style/observer.hpp
     src/mbgl/style/paint_property.hpp
     src/mbgl/style/paint_property_binder.hpp
+    src/mbgl/style/parallel_tile_query.hpp
     src/mbgl/style/parser.cpp
     src/mbgl/style/parser.hpp
+    src/mbgl/style/parser_worker.cpp
+    src/mbgl/style/parser_worker.hpp
     src/mbgl/style/possibly_evaluated_property_value.hpp
     src/mbgl/style/property_evaluation_parameters.hpp
     src/mbgl/style/property_evaluator.hpp
@@ -271,10 +279,14 @@ set(MBGL_CORE_FILES
     src/mbgl/style/property_parsing.hpp
     src/mbgl/style/query_parameters.hpp
     src/mbgl/style/rapidjson_conversion.hpp
+    src/mbgl/style/rendered_query.cpp
+    src/mbgl/style/rendered_query.hpp
     src/mbgl/style/source.cpp
     src/mbgl/style/source_impl.cpp
     src/mbgl/style/source_impl.hpp
     src/mbgl/style/source_observer.hpp
+    src/mbgl/style/source_query.cpp
+    src/mbgl/style/source_query.hpp
     src/mbgl/style/style.cpp
     src/mbgl/style/style.hpp
     src/mbgl/style/tile_source_impl.cpp
@@ -301,6 +313,7 @@ set(MBGL_CORE_FILES
     # style/function
     include/mbgl/style/function/camera_function.hpp
     include/mbgl/style/function/categorical_stops.hpp
+    include/mbgl/style/function/compiled_stops.hpp
     include/mbgl/style/function/composite_function.hpp
     include/mbgl/style/function/exponential_stops.hpp
     include/mbgl/style/function/identity_stops.hpp
@@ -361,9 +374,13 @@ set(MBGL_CORE_FILES
     include/mbgl/style/sources/geojson_source.hpp
     include/mbgl/style/sources/raster_source.hpp
     include/mbgl/style/sources/vector_source.hpp
+    src/mbgl/style/sources/geojson_reader.cpp
+    src/mbgl/style/sources/geojson_reader.hpp
     src/mbgl/style/sources/geojson_source.cpp
     src/mbgl/style/sources/geojson_source_impl.cpp
     src/mbgl/style/sources/geojson_source_impl.hpp
+    src/mbgl/style/sources/geojson_source_worker.cpp
+    src/mbgl/style/sources/geojson_source_worker.hpp
     src/mbgl/style/sources/raster_source.cpp
     src/mbgl/style/sources/raster_source_impl.cpp
     src/mbgl/style/sources/raster_source_impl.hpp
@@ -377,6 +394,8 @@ set(MBGL_CORE_FILES
     src/mbgl/text/check_max_angle.hpp
     src/mbgl/text/collision_feature.cpp
     src/mbgl/text/collision_feature.hpp
+    src/mbgl/text/collision_grid.cpp
+    src/mbgl/text/collision_grid.hpp
     src/mbgl/text/collision_tile.cpp
     src/mbgl/text/collision_tile.hpp
     src/mbgl/text/get_anchors.cpp
@@ -388,6 +407,8 @@ set(MBGL_CORE_FILES
     src/mbgl/text/glyph_atlas_observer.hpp
     src/mbgl/text/glyph_pbf.cpp
     src/mbgl/text/glyph_pbf.hpp
+    src/mbgl/text/glyph_pbf_worker.cpp
+    src/mbgl/text/glyph_pbf_worker.hpp
     src/mbgl/text/glyph_range.hpp
     src/mbgl/text/glyph_set.cpp
     src/mbgl/text/glyph_set.hpp
@@ -396,6 +417,8 @@ set(MBGL_CORE_FILES
     src/mbgl/text/quads.hpp
     src/mbgl/text/shaping.cpp
     src/mbgl/text/shaping.hpp
+    src/mbgl/text/shaping_cache.cpp
+    src/mbgl/text/shaping_cache.hpp
 
     # tile
     src/mbgl/tile/geojson_tile.cpp
@@ -439,6 +462,7 @@ set(MBGL_CORE_FILES
     include/mbgl/util/geojson.hpp
     include/mbgl/util/geometry.hpp
     include/mbgl/util/image.hpp
+    include/mbgl/util/lazy_feature.hpp
     include/mbgl/util/logging.hpp
     include/mbgl/util/noncopyable.hpp
     include/mbgl/util/optional.hpp
@@ -488,6 +512,8 @@ set(MBGL_CORE_FILES
     src/mbgl/util/intersection_tests.hpp
     src/mbgl/util/io.cpp
     src/mbgl/util/io.hpp
+    src/mbgl/util/lazy_feature.cpp
+    src/mbgl/util/lazy_feature_impl.hpp
     src/mbgl/util/logging.cpp
     src/mbgl/util/mapbox.cpp
     src/mbgl/util/mapbox.hpp
@@ -0,0 +1,23 @@
+add_executable(mbgl-style
+    bin/style.cpp
+)
+
+target_compile_options(mbgl-style
+    PRIVATE -fvisibility-inlines-hidden
+)
+
+target_include_directories(mbgl-style
+    PRIVATE include
+    PRIVATE src # TODO: eliminate
+)
+
+target_link_libraries(mbgl-style
+    PRIVATE mbgl-core
+)
+
+target_add_mason_package(mbgl-style PRIVATE boost)
+target_add_mason_package(mbgl-style PRIVATE boost_libprogram_options)
+
+mbgl_platform_style()
+
+create_source_groups(mbgl-style)
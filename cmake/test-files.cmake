@@ -11,6 +11,9 @@ set(MBGL_TEST_FILES
     test/algorithm/mock.hpp
     test/algorithm/update_renderables.test.cpp
 
+    # annotation
+    test/annotation/annotation_manager.test.cpp
+
     # api
     test/api/annotations.test.cpp
     test/api/api_misuse.test.cpp
@@ -64,6 +67,7 @@ set(MBGL_TEST_FILES
     test/storage/headers.test.cpp
     test/storage/http_file_source.test.cpp
     test/storage/local_file_source.test.cpp
+    test/storage/mbtiles_file_source.test.cpp
     test/storage/offline.test.cpp
     test/storage/offline_database.test.cpp
     test/storage/offline_download.test.cpp
@@ -78,6 +82,7 @@ set(MBGL_TEST_FILES
 
     # style
     test/style/filter.test.cpp
+    test/style/geojson_reader.test.cpp
 
     # style/function
     test/style/function/camera_function.test.cpp
@@ -93,9 +98,12 @@ set(MBGL_TEST_FILES
     test/style/tile_source.test.cpp
 
     # text
+    test/text/collision_grid.test.cpp
     test/text/glyph_atlas.test.cpp
     test/text/glyph_pbf.test.cpp
+    test/text/glyph_set.test.cpp
     test/text/quads.test.cpp
+    test/text/shaping_cache.test.cpp
 
     # tile
     test/tile/geojson_tile.test.cpp
@@ -5,6 +5,7 @@
 #include <mbgl/map/mode.hpp>
 #include <mbgl/util/geo.hpp>
 #include <mbgl/util/feature.hpp>
+#include <mbgl/util/lazy_feature.hpp>
 #include <mbgl/util/noncopyable.hpp>
 #include <mbgl/util/size.hpp>
 #include <mbgl/annotation/annotation.hpp>
@@ -23,8 +24,10 @@ class View;
 class FileSource;
 class Scheduler;
 class SpriteImage;
+class AsyncRequest;
 struct CameraOptions;
 struct AnimationOptions;
+struct SourceQueryOptions;
 
 namespace style {
 class Source;
@@ -68,6 +71,10 @@ public:
 
     void setStyleURL(const std::string&);
     void setStyleJSON(const std::string&);
+
+    // Loads a style encoded with style::encodeBinaryStyle(), skipping JSON tokenization.
+    // getStyleJSON() returns the style decoded back to JSON for styles loaded this way.
+    void setStyleBinary(const std::string&);
     std::string getStyleURL() const;
     std::string getStyleJSON() const;
 
@@ -183,6 +190,29 @@ public:
     // Feature queries
     std::vector<Feature> queryRenderedFeatures(const ScreenCoordinate&, const optional<std::vector<std::string>>& layerIDs = {});
     std::vector<Feature> queryRenderedFeatures(const ScreenBox&,        const optional<std::vector<std::string>>& layerIDs = {});
+
+    // Like queryRenderedFeatures(), but returns features that convert their geometry and copy
+    // their properties only when asked to, for callers that read just a few of them.
+    std::vector<LazyFeature> queryRenderedFeaturesLazy(const ScreenCoordinate&, const optional<std::vector<std::string>>& layerIDs = {});
+    std::vector<LazyFeature> queryRenderedFeaturesLazy(const ScreenBox&,        const optional<std::vector<std::string>>& layerIDs = {});
+
+    // Asynchronous variants of the feature queries above, which query tiles on the scheduler
+    // instead of blocking this thread. The callback is called on this thread with the same
+    // features that the synchronous query would have returned when the query was made.
+    // Destroying the returned request cancels the query and the callback isn't called, so a
+    // newer query supersedes an older one by replacing its request.
+    using RenderedFeaturesCallback = std::function<void (std::vector<Feature>)>;
+    std::unique_ptr<AsyncRequest> queryRenderedFeatures(const ScreenCoordinate&, const optional<std::vector<std::string>>& layerIDs, RenderedFeaturesCallback);
+    std::unique_ptr<AsyncRequest> queryRenderedFeatures(const ScreenBox&,        const optional<std::vector<std::string>>& layerIDs, RenderedFeaturesCallback);
+
+    // Reads the features of a source layer that match a filter from the source's loaded tiles,
+    // whether or not they're rendered. See SourceQueryOptions for limiting the query to bounds.
+    // Tiles are read on the scheduler, and features that are found in several tiles are returned
+    // once per identifier. The callback is called on this thread. Destroying the returned request
+    // cancels the query.
+    using SourceFeaturesCallback = std::function<void (std::vector<Feature>)>;
+    std::unique_ptr<AsyncRequest> querySourceFeatures(const std::string& sourceID, const SourceQueryOptions&, SourceFeaturesCallback);
+
     AnnotationIDs queryPointAnnotations(const ScreenBox&);
 
     // Memory
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <mbgl/style/filter.hpp>
+#include <mbgl/util/geo.hpp>
+#include <mbgl/util/optional.hpp>
+
+#include <string>
+
+namespace mbgl {
+
+/** Options for Map::querySourceFeatures(). */
+struct SourceQueryOptions {
+    /** Source layer to read features from. Required for vector sources;
+        ignored for GeoJSON sources, which have a single layer. */
+    std::string sourceLayer;
+
+    /** Only features that match the filter are returned. */
+    style::Filter filter;
+
+    /** Limits the query to the loaded tiles that cover these bounds at
+        `zoom`, and to features whose bounding boxes intersect them. If
+        unset, every loaded tile of the source is read. */
+    optional<LatLngBounds> bounds;
+
+    /** Zero-based zoom level at which to cover `bounds`. */
+    double zoom = 0;
+};
+
+} // namespace mbgl
@@ -4,6 +4,7 @@
 #include <mbgl/storage/offline.hpp>
 #include <mbgl/util/constants.hpp>
 
+#include <atomic>
 #include <vector>
 
 namespace mbgl {
@@ -107,6 +108,32 @@ public:
      */
     void deleteOfflineRegion(OfflineRegion&&, std::function<void (std::exception_ptr)>);
 
+    /*
+     * Write an offline region, along with all resources and tiles it has downloaded, to a
+     * standalone database file at the given path, replacing any file already there. The
+     * file can be moved to another device and imported there with `importOfflineRegions`.
+     *
+     * When the operation is complete or encounters an error, the given callback will be
+     * executed on the database thread; it is the responsibility of the SDK bindings
+     * to re-execute a user-provided callback on the main thread.
+     */
+    void exportOfflineRegion(OfflineRegion&, const std::string& path,
+                             std::function<void (std::exception_ptr)>);
+
+    /*
+     * Add all offline regions stored in a database file written by `exportOfflineRegion`
+     * (or by another offline database) to this one, in a single transaction. Resources
+     * and tiles that are already present are shared rather than duplicated. The imported
+     * regions are in an inactive download state.
+     *
+     * When the import is complete or encounters an error, the given callback will be
+     * executed on the database thread; it is the responsibility of the SDK bindings
+     * to re-execute a user-provided callback on the main thread.
+     */
+    void importOfflineRegions(const std::string& path,
+                              std::function<void (std::exception_ptr,
+                                                  optional<std::vector<OfflineRegion>>)>);
+
     /*
      * Changing or bypassing this limit without permission from Mapbox is prohibited
      * by the Mapbox Terms of Service.
@@ -117,11 +144,15 @@ public:
     void put(const Resource&, const Response&);
 
     class Impl;
+    class CacheReader;
 
 private:
     const std::unique_ptr<util::Thread<Impl>> thread;
+    std::vector<std::unique_ptr<util::Thread<CacheReader>>> readers;
+    std::atomic<std::size_t> nextReader { 0 };
     const std::unique_ptr<FileSource> assetFileSource;
     const std::unique_ptr<FileSource> localFileSource;
+    const std::unique_ptr<FileSource> mbtilesFileSource;
 };
 
 } // namespace mbgl
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <string>
+
+namespace mbgl {
+namespace style {
+
+/*
+ * Converts style JSON to a compact binary encoding, which Map::setStyleBinary() loads
+ * without tokenizing JSON text: strings arrive unescaped and deduplicated, and numbers
+ * arrive already converted.
+ *
+ * The encoded format is private and versioned. Binaries should be produced from the
+ * JSON at build time by the same version of the library that loads them.
+ *
+ * Throws std::runtime_error if the JSON is malformed.
+ */
+std::string encodeBinaryStyle(const std::string& json);
+
+/*
+ * Converts an encoded binary style back to JSON. Throws std::runtime_error if the data is
+ * not a valid binary style.
+ */
+std::string decodeBinaryStyle(const std::string& binary);
+
+} // namespace style
+} // namespace mbgl
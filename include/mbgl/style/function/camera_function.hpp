@@ -2,9 +2,12 @@
 
 #include <mbgl/style/function/exponential_stops.hpp>
 #include <mbgl/style/function/interval_stops.hpp>
+#include <mbgl/style/function/compiled_stops.hpp>
 #include <mbgl/util/interpolate.hpp>
 #include <mbgl/util/variant.hpp>
 
+#include <memory>
+
 namespace mbgl {
 namespace style {
 
@@ -20,13 +23,20 @@ public:
             IntervalStops<T>>>;
 
     CameraFunction(Stops stops_)
-        : stops(std::move(stops_)) {
+        : stops(std::move(stops_)),
+          compiled(std::make_shared<const CompiledStops<T>>(stops.match([] (const auto& s) {
+              return CompiledStops<T>(s);
+          }))) {
     }
 
     T evaluate(float zoom) const {
-        return stops.match([&] (const auto& s) {
-            return s.evaluate(Value(double(zoom))).value_or(T());
-        });
+        return compiled->evaluate(zoom);
+    }
+
+    // Read-only, because the stops are compiled on construction. Construct a new function to
+    // change them.
+    const Stops& getStops() const {
+        return stops;
     }
 
     friend bool operator==(const CameraFunction& lhs,
@@ -34,7 +44,12 @@ public:
         return lhs.stops == rhs.stops;
     }
 
+private:
     Stops stops;
+
+    // Camera functions are evaluated at least once per frame while zooming, so the stops are
+    // compiled once on construction. Shared because functions are copied along with property values.
+    std::shared_ptr<const CompiledStops<T>> compiled;
 };
 
 } // namespace style
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <mbgl/style/function/exponential_stops.hpp>
+#include <mbgl/style/function/interval_stops.hpp>
+#include <mbgl/util/interpolate.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <type_traits>
+#include <vector>
+
+namespace mbgl {
+namespace style {
+
+// A flattened form of exponential or interval stops, for evaluating a zoom function many
+// times. Stop inputs and outputs are kept in contiguous arrays that are binary-searched
+// directly, and each segment's zoom span and exponential denominator are computed up front.
+// The arithmetic matches util::interpolationFactor() step for step, so results are identical
+// to evaluating the original stops.
+template <class T>
+class CompiledStops {
+public:
+    explicit CompiledStops(const ExponentialStops<T>& stops)
+        : base(stops.base),
+          interpolated(true) {
+        flatten(stops.stops);
+    }
+
+    explicit CompiledStops(const IntervalStops<T>& stops)
+        : interpolated(false) {
+        flatten(stops.stops);
+    }
+
+    T evaluate(float z) const {
+        if (inputs.empty()) {
+            assert(false);
+            return T();
+        }
+
+        auto it = std::upper_bound(inputs.begin(), inputs.end(), z);
+        if (it == inputs.end()) {
+            return outputs.back();
+        } else if (it == inputs.begin()) {
+            return outputs.front();
+        }
+
+        const std::size_t segment = std::distance(inputs.begin(), it) - 1;
+        if (!interpolated) {
+            return outputs[segment];
+        }
+
+        return interpolate(segment, z, std::integral_constant<bool, util::Interpolatable<T>>());
+    }
+
+private:
+    // The type of `std::pow(float, float) - 1`, as used by util::interpolationFactor().
+    using Denominator = decltype(std::pow(1.0f, 1.0f) - 1);
+
+    struct Segment {
+        float zoomDiff;
+        Denominator denominator;
+    };
+
+    template <class Stops>
+    void flatten(const Stops& stops) {
+        inputs.reserve(stops.size());
+        outputs.reserve(stops.size());
+        for (const auto& stop : stops) {
+            inputs.push_back(stop.first);
+            outputs.push_back(stop.second);
+        }
+
+        if (interpolated) {
+            for (std::size_t i = 1; i < inputs.size(); ++i) {
+                const float zoomDiff = inputs[i] - inputs[i - 1];
+                segments.push_back({ zoomDiff, std::pow(base, zoomDiff) - 1 });
+            }
+        }
+    }
+
+    T interpolate(std::size_t segment, float z, std::true_type) const {
+        const float zoomProgress = z - inputs[segment];
+        const float factor = base == 1.0f
+            ? zoomProgress / segments[segment].zoomDiff
+            : (std::pow(base, zoomProgress) - 1) / segments[segment].denominator;
+        return util::interpolate(outputs[segment], outputs[segment + 1], factor);
+    }
+
+    T interpolate(std::size_t segment, float, std::false_type) const {
+        return outputs[segment];
+    }
+
+    std::vector<float> inputs;
+    std::vector<T> outputs;
+    std::vector<Segment> segments;
+    float base = 1.0f;
+    bool interpolated;
+};
+
+} // namespace style
+} // namespace mbgl
@@ -92,13 +92,33 @@ public:
         };
     }
 
+    // Equivalent to evaluating the result of coveringRanges(), but refers to the covering
+    // inner stops in place rather than copying them, since this runs once per feature.
     T evaluate(float zoom, const GeometryTileFeature& feature, T finalDefaultValue) const {
-        std::tuple<Range<float>, Range<InnerStops>> ranges = coveringRanges(zoom);
-        Range<T> resultRange = evaluate(std::get<1>(ranges), feature, finalDefaultValue);
-        return util::interpolate(
-            resultRange.min,
-            resultRange.max,
-            util::interpolationFactor(1.0f, std::get<0>(ranges), zoom));
+        return stops.match(
+            [&] (const auto& s) {
+                assert(!s.empty());
+                auto minIt = s.lower_bound(zoom);
+                auto maxIt = s.upper_bound(zoom);
+                if (minIt != s.begin()) {
+                    minIt--;
+                }
+
+                const auto& min = minIt == s.end() ? *s.rbegin() : *minIt;
+                const auto& max = maxIt == s.end() ? *s.rbegin() : *maxIt;
+
+                const optional<Value> v = feature.getValue(property);
+                auto eval = [&] (const auto& inner) {
+                    return v ? inner.evaluate(*v).value_or(defaultValue.value_or(finalDefaultValue))
+                             : defaultValue.value_or(finalDefaultValue);
+                };
+
+                return util::interpolate(
+                    eval(min.second),
+                    eval(max.second),
+                    util::interpolationFactor(1.0f, { min.first, max.first }, zoom));
+            }
+        );
     }
 
     friend bool operator==(const CompositeFunction& lhs,
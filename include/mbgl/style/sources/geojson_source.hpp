@@ -2,6 +2,7 @@
 
 #include <mbgl/style/source.hpp>
 #include <mbgl/util/geojson.hpp>
+#include <mbgl/util/feature.hpp>
 #include <mbgl/util/optional.hpp>
 
 #include <mapbox/geojson.hpp>
@@ -43,6 +44,11 @@ public:
     void setURL(const std::string& url);
     void setGeoJSON(const GeoJSON&);
 
+    // Adds features to the source, replacing existing features that have the same id. Only
+    // tiles that overlap the added, replaced or removed features are laid out again.
+    void updateFeatures(const FeatureCollection&);
+    void removeFeatures(const std::vector<FeatureIdentifier>&);
+
     optional<std::string> getURL() const;
 
     // Private implementation
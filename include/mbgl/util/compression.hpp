@@ -6,7 +6,14 @@ namespace mbgl {
 namespace util {
 
 std::string compress(const std::string& raw);
+
+// Accepts both zlib and gzip streams.
 std::string decompress(const std::string& raw);
 
+// Variants using a preset dictionary of strings likely to occur in the data. Data compressed
+// with a dictionary can only be decompressed with the exact same dictionary.
+std::string compress(const std::string& raw, const std::string& dictionary);
+std::string decompress(const std::string& raw, const std::string& dictionary);
+
 } // namespace util
 } // namespace mbgl
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <mbgl/util/feature.hpp>
+#include <mbgl/util/optional.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace mbgl {
+
+// A feature returned by a query that reads its geometry and properties from the tile data it was
+// found in only when they're asked for, so that callers that look at a feature's identifier and
+// a property or two don't pay for converting the rest.
+//
+// A LazyFeature keeps the tile data it refers to alive. It should only be used on the thread
+// that made the query.
+class LazyFeature {
+public:
+    class Impl;
+    explicit LazyFeature(std::shared_ptr<const Impl>);
+
+    optional<FeatureIdentifier> getID() const;
+    optional<Value> getProperty(const std::string& key) const;
+
+    // Copies all of the feature's properties, or only those with the given keys.
+    PropertyMap getProperties() const;
+    PropertyMap getProperties(const std::vector<std::string>& keys) const;
+
+    // Converts the feature's geometry from tile coordinates to latitude and longitude.
+    Feature::geometry_type getGeometry() const;
+
+    // Converts to a Feature with all of the feature's properties, or only those with the given keys.
+    Feature toFeature() const;
+    Feature toFeature(const std::vector<std::string>& keys) const;
+
+private:
+    std::shared_ptr<const Impl> impl;
+};
+
+} // namespace mbgl
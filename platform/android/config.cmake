@@ -44,11 +44,14 @@ macro(mbgl_platform_core)
         PRIVATE platform/android/src/http_file_source.cpp
         PRIVATE platform/default/default_file_source.cpp
         PRIVATE platform/default/local_file_source.cpp
+        PRIVATE platform/default/mbtiles_file_source.cpp
         PRIVATE platform/default/online_file_source.cpp
 
         # Offline
         # PRIVATE include/mbgl/storage/offline.hpp
         PRIVATE platform/default/mbgl/storage/offline.cpp
+        PRIVATE platform/default/mbgl/storage/offline_codec.cpp
+        PRIVATE platform/default/mbgl/storage/offline_codec.hpp
         PRIVATE platform/default/mbgl/storage/offline_database.cpp
         PRIVATE platform/default/mbgl/storage/offline_database.hpp
         PRIVATE platform/default/mbgl/storage/offline_download.cpp
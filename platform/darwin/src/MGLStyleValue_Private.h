@@ -573,7 +573,7 @@ private: // Private utilities for converting from mbgl to mgl values
 
         id operator()(const mbgl::style::CameraFunction<MBGLEnum> &mbglValue) const {
             CameraFunctionStopsVisitor visitor;
-            return apply_visitor(visitor, mbglValue.stops);
+            return apply_visitor(visitor, mbglValue.getStops());
         }
     };
 
@@ -728,7 +728,7 @@ private: // Private utilities for converting from mbgl to mgl values
 
         id operator()(const mbgl::style::CameraFunction<MBGLType> &mbglValue) const {
             CameraFunctionStopsVisitor visitor;
-            return apply_visitor(visitor, mbglValue.stops);
+            return apply_visitor(visitor, mbglValue.getStops());
         }
 
         id operator()(const mbgl::style::SourceFunction<MBGLType> &mbglValue) const {
@@ -1,11 +1,14 @@
 #include <mbgl/storage/default_file_source.hpp>
 #include <mbgl/storage/asset_file_source.hpp>
 #include <mbgl/storage/local_file_source.hpp>
+#include <mbgl/storage/mbtiles_file_source.hpp>
 #include <mbgl/storage/online_file_source.hpp>
 #include <mbgl/storage/offline_database.hpp>
 #include <mbgl/storage/offline_download.hpp>
 
 #include <mbgl/util/platform.hpp>
+#include <mbgl/util/logging.hpp>
+#include <mbgl/util/string.hpp>
 #include <mbgl/util/url.hpp>
 #include <mbgl/util/thread.hpp>
 #include <mbgl/util/work_request.hpp>
@@ -16,6 +19,9 @@ namespace {
 
 const std::string assetProtocol = "asset://";
 
+// Number of read-only database connections serving cache lookups, each on its own thread.
+const std::size_t cacheReaderCount = 2;
+
 bool isAssetURL(const std::string& url) {
     return std::equal(assetProtocol.begin(), assetProtocol.end(), url.begin());
 }
@@ -92,6 +98,23 @@ public:
         }
     }
 
+    void exportRegion(int64_t regionID, const std::string& path, std::function<void (std::exception_ptr)> callback) {
+        try {
+            offlineDatabase.exportRegion(regionID, path);
+            callback({});
+        } catch (...) {
+            callback(std::current_exception());
+        }
+    }
+
+    void importRegions(const std::string& path, std::function<void (std::exception_ptr, optional<std::vector<OfflineRegion>>)> callback) {
+        try {
+            callback({}, offlineDatabase.importRegions(path));
+        } catch (...) {
+            callback(std::current_exception(), {});
+        }
+    }
+
     void setRegionObserver(int64_t regionID, std::unique_ptr<OfflineRegionObserver> observer) {
         getDownload(regionID).setObserver(std::move(observer));
     }
@@ -125,13 +148,21 @@ public:
         }
 
         if (resource.necessity == Resource::Required) {
-            tasks[req] = onlineFileSource.request(revalidation, [=] (Response onlineResponse) {
-                this->offlineDatabase.put(revalidation, onlineResponse);
-                callback(onlineResponse);
-            });
+            requestOnline(req, revalidation, callback);
         }
     }
 
+    void requestOnline(AsyncRequest* req, Resource resource, Callback callback) {
+        tasks[req] = onlineFileSource.request(resource, [=] (Response onlineResponse) {
+            this->offlineDatabase.put(resource, onlineResponse);
+            callback(onlineResponse);
+        });
+    }
+
+    void touch(Resource resource) {
+        offlineDatabase.touch(resource);
+    }
+
     void cancel(AsyncRequest* req) {
         tasks.erase(req);
     }
@@ -160,13 +191,49 @@ private:
     std::unordered_map<int64_t, std::unique_ptr<OfflineDownload>> downloads;
 };
 
+// Serves cache lookups from a read-only connection, so that they don't queue behind
+// writes (such as offline downloads) on the DefaultFileSource thread.
+class DefaultFileSource::CacheReader {
+public:
+    CacheReader(const std::string& cachePath_)
+        : cachePath(cachePath_) {
+    }
+
+    void get(Resource resource, std::function<void (optional<Response>)> callback) {
+        try {
+            if (!offlineDatabase) {
+                offlineDatabase = OfflineDatabase::openReadOnly(cachePath);
+            }
+            callback(offlineDatabase->get(resource));
+        } catch (...) {
+            // Treat an unreadable cache as a cache miss; the request still goes online.
+            Log::Error(Event::Database, "Unable to read from cache: %s", util::toString(std::current_exception()).c_str());
+            offlineDatabase.reset();
+            callback({});
+        }
+    }
+
+private:
+    const std::string cachePath;
+    std::unique_ptr<OfflineDatabase> offlineDatabase;
+};
+
 DefaultFileSource::DefaultFileSource(const std::string& cachePath,
                                      const std::string& assetRoot,
                                      uint64_t maximumCacheSize)
     : thread(std::make_unique<util::Thread<Impl>>(util::ThreadContext{"DefaultFileSource", util::ThreadPriority::Low},
             cachePath, maximumCacheSize)),
       assetFileSource(std::make_unique<AssetFileSource>(assetRoot)),
-      localFileSource(std::make_unique<LocalFileSource>()) {
+      localFileSource(std::make_unique<LocalFileSource>()),
+      mbtilesFileSource(std::make_unique<MBTilesFileSource>()) {
+    // In-memory databases can't be shared between connections; all lookups then
+    // happen on the DefaultFileSource thread.
+    if (cachePath != ":memory:") {
+        for (std::size_t i = 0; i < cacheReaderCount; i++) {
+            readers.push_back(std::make_unique<util::Thread<CacheReader>>(
+                util::ThreadContext{"DefaultFileSourceReader"}, cachePath));
+        }
+    }
 }
 
 DefaultFileSource::~DefaultFileSource() = default;
@@ -190,16 +257,61 @@ std::string DefaultFileSource::getAccessToken() const {
 std::unique_ptr<AsyncRequest> DefaultFileSource::request(const Resource& resource, Callback callback) {
     class DefaultFileRequest : public AsyncRequest {
     public:
-        DefaultFileRequest(Resource resource_, FileSource::Callback callback_, util::Thread<DefaultFileSource::Impl>& thread_)
+        DefaultFileRequest(Resource resource_, FileSource::Callback callback_,
+                           util::Thread<DefaultFileSource::Impl>& thread_,
+                           util::Thread<DefaultFileSource::CacheReader>* reader)
             : thread(thread_),
-              workRequest(thread.invokeWithCallback(&DefaultFileSource::Impl::request, this, resource_, callback_)) {
+              callback(std::move(callback_)) {
+            const bool hasPrior = resource_.priorEtag || resource_.priorModified || resource_.priorExpires;
+            if (!reader || (hasPrior && resource_.necessity == Resource::Required)) {
+                workRequest = thread.invokeWithCallback(&DefaultFileSource::Impl::request, this, resource_, callback);
+            } else {
+                readRequest = reader->invokeWithCallback(&DefaultFileSource::CacheReader::get, resource_,
+                    [this, resource_] (optional<Response> offlineResponse) {
+                        cacheResponse(resource_, std::move(offlineResponse));
+                    });
+            }
         }
 
         ~DefaultFileRequest() override {
             thread.invoke(&DefaultFileSource::Impl::cancel, this);
         }
 
+        // Mirrors DefaultFileSource::Impl::request, with the lookup already done by a reader.
+        void cacheResponse(const Resource& resource, optional<Response> offlineResponse) {
+            Resource revalidation = resource;
+
+            if (offlineResponse) {
+                thread.invoke(&DefaultFileSource::Impl::touch, resource);
+            } else if (resource.necessity == Resource::Optional) {
+                // Ensure there's always a response that we can send, so the caller knows that
+                // there's no optional data available in the cache.
+                offlineResponse.emplace();
+                offlineResponse->noContent = true;
+                offlineResponse->error = std::make_unique<Response::Error>(
+                    Response::Error::Reason::NotFound, "Not found in offline database");
+            }
+
+            if (offlineResponse) {
+                revalidation.priorModified = offlineResponse->modified;
+                revalidation.priorExpires = offlineResponse->expires;
+                revalidation.priorEtag = offlineResponse->etag;
+            }
+
+            if (resource.necessity == Resource::Required) {
+                workRequest = thread.invokeWithCallback(&DefaultFileSource::Impl::requestOnline, this, revalidation, callback);
+            }
+
+            if (offlineResponse) {
+                // The callback may destroy this request, so it must come last.
+                FileSource::Callback callback_ = callback;
+                callback_(*offlineResponse);
+            }
+        }
+
         util::Thread<DefaultFileSource::Impl>& thread;
+        FileSource::Callback callback;
+        std::unique_ptr<AsyncRequest> readRequest;
         std::unique_ptr<AsyncRequest> workRequest;
     };
 
@@ -207,8 +319,14 @@ std::unique_ptr<AsyncRequest> DefaultFileSource::request(const Resource& resourc
         return assetFileSource->request(resource, callback);
     } else if (LocalFileSource::acceptsURL(resource.url)) {
         return localFileSource->request(resource, callback);
+    } else if (MBTilesFileSource::acceptsURL(resource.url)) {
+        return mbtilesFileSource->request(resource, callback);
     } else {
-        return std::make_unique<DefaultFileRequest>(resource, callback, *thread);
+        util::Thread<CacheReader>* reader = nullptr;
+        if (!readers.empty()) {
+            reader = readers[nextReader++ % readers.size()].get();
+        }
+        return std::make_unique<DefaultFileRequest>(resource, callback, *thread, reader);
     }
 }
 
@@ -232,6 +350,14 @@ void DefaultFileSource::deleteOfflineRegion(OfflineRegion&& region, std::functio
     thread->invoke(&Impl::deleteRegion, std::move(region), callback);
 }
 
+void DefaultFileSource::exportOfflineRegion(OfflineRegion& region, const std::string& path, std::function<void (std::exception_ptr)> callback) {
+    thread->invoke(&Impl::exportRegion, region.getID(), path, callback);
+}
+
+void DefaultFileSource::importOfflineRegions(const std::string& path, std::function<void (std::exception_ptr, optional<std::vector<OfflineRegion>>)> callback) {
+    thread->invoke(&Impl::importRegions, path, callback);
+}
+
 void DefaultFileSource::setOfflineRegionObserver(OfflineRegion& region, std::unique_ptr<OfflineRegionObserver> observer) {
     thread->invoke(&Impl::setRegionObserver, region.getID(), std::move(observer));
 }
@@ -24,23 +24,40 @@ OfflineTilePyramidRegionDefinition::OfflineTilePyramidRegionDefinition(
 }
 
 std::vector<CanonicalTileID> OfflineTilePyramidRegionDefinition::tileCover(SourceType type, uint16_t tileSize, const Range<uint8_t>& zoomRange) const {
+    std::vector<CanonicalTileID> result;
+
+    util::BoundsTileCover cover(bounds, coveringZoomRange(type, tileSize, zoomRange));
+    while (auto tile = cover.next()) {
+        result.emplace_back(tile->canonical);
+    }
+
+    return result;
+}
+
+uint64_t OfflineTilePyramidRegionDefinition::tileCount(SourceType type, uint16_t tileSize, const Range<uint8_t>& zoomRange) const {
+    const Range<uint8_t> zooms = coveringZoomRange(type, tileSize, zoomRange);
+
+    uint64_t result = 0;
+    for (int32_t z = zooms.min; z <= zooms.max; z++) {
+        result += util::tileCount(bounds, z);
+    }
+
+    return result;
+}
+
+// The result is empty, with min > max, if the region's zoom levels lie outside the given range.
+Range<uint8_t> OfflineTilePyramidRegionDefinition::coveringZoomRange(SourceType type, uint16_t tileSize, const Range<uint8_t>& zoomRange) const {
     double minZ = std::max<double>(util::coveringZoomLevel(minZoom, type, tileSize), zoomRange.min);
-    double maxZ = std::min<double>(util::coveringZoomLevel(maxZoom, type, tileSize), zoomRange.max);
+    double maxZ = std::isfinite(maxZoom)
+        ? std::min<double>(util::coveringZoomLevel(maxZoom, type, tileSize), zoomRange.max)
+        : zoomRange.max;
 
     assert(minZ >= 0);
     assert(maxZ >= 0);
     assert(minZ < std::numeric_limits<uint8_t>::max());
     assert(maxZ < std::numeric_limits<uint8_t>::max());
 
-    std::vector<CanonicalTileID> result;
-
-    for (uint8_t z = minZ; z <= maxZ; z++) {
-        for (const auto& tile : util::tileCover(bounds, z)) {
-            result.emplace_back(tile.canonical);
-        }
-    }
-
-    return result;
+    return { uint8_t(minZ), uint8_t(maxZ) };
 }
 
 OfflineRegionDefinition decodeOfflineRegionDefinition(const std::string& region) {
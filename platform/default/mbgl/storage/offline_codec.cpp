@@ -0,0 +1,110 @@
+#include <mbgl/storage/offline_codec.hpp>
+#include <mbgl/util/compression.hpp>
+
+#include <stdexcept>
+
+namespace mbgl {
+
+namespace {
+
+// A preset deflate dictionary of strings that occur in nearly every vector tile: the
+// layer names, attribute keys and most common attribute values of the Mapbox Streets v7
+// and Terrain v2 schemas, protobuf-encoded the way they appear in a tile. Priming the
+// compressor with them mostly benefits small tiles, where they make up a large share of
+// the data. Deflate encodes matches near the end of the dictionary most cheaply, so the
+// most frequent strings come last.
+//
+// Stored rows depend on the exact bytes of this dictionary; see OfflineCodec.
+const std::string& vectorTileDictionary() {
+    static const std::string dictionary = [] {
+        std::string result;
+
+        auto append = [&] (char tag, const char* value) {
+            const std::string string = value;
+            result += tag;
+            result += char(string.size());
+            result += string;
+        };
+
+        // tile.layer.values[]: a Value message wrapping a string_value.
+        for (const char* value : {
+            "ford", "true", "false", "canal", "stream", "river", "hospital", "school",
+            "cemetery", "pitch", "sand", "scrub", "grass", "wood", "park", "industrial",
+            "parking", "building", "link", "track", "footway", "path", "service",
+            "street_limited", "trunk", "tertiary", "secondary", "primary",
+            "motorway_link", "motorway", "main", "tunnel", "bridge", "none", "street" }) {
+            const std::string string = value;
+            result += '\x22';
+            result += char(string.size() + 2);
+            append('\x0a', value);
+        }
+
+        // tile.layer.keys[]
+        for (const char* key : {
+            "iso_3166_1", "iso_3166_2", "abbr", "capital", "labelrank", "disputed",
+            "maritime", "admin_level", "network", "shield", "reflen", "ref", "house_num",
+            "area", "extrude", "underground", "min_height", "height", "level", "index",
+            "ele", "code", "ldir", "localrank", "scalerank", "maki", "len", "layer",
+            "oneway", "structure", "name_zh-Hans", "name_zh", "name_pt", "name_ar",
+            "name_ru", "name_de", "name_fr", "name_es", "name_en", "name", "type",
+            "class" }) {
+            append('\x1a', key);
+        }
+
+        // tile.layer.name
+        for (const char* name : {
+            "contour", "hillshade", "landcover", "motorway_junction", "mountain_peak_label",
+            "rail_station_label", "airport_label", "housenum_label", "marine_label",
+            "water_label", "state_label", "country_label", "place_label", "poi_label",
+            "road_label", "admin", "aeroway", "barrier_line", "waterway", "landuse_overlay",
+            "landuse", "water", "building", "road" }) {
+            append('\x0a', name);
+        }
+
+        // tile.layer.extent = 4096, tile.layer.version = 2
+        result += "\x28\x80\x20\x78\x02";
+
+        return result;
+    }();
+
+    return dictionary;
+}
+
+// Vector tiles start with a tile.layers field (number 3, length-delimited). Raster
+// tiles and other resources don't.
+bool isVectorTile(const std::string& data) {
+    return !data.empty() && data[0] == '\x1a';
+}
+
+} // namespace
+
+std::pair<OfflineCodec, std::string> encodeOfflineData(const std::string& data) {
+    std::pair<OfflineCodec, std::string> result;
+
+    if (isVectorTile(data)) {
+        result = { OfflineCodec::ZlibVectorTileDictionary, util::compress(data, vectorTileDictionary()) };
+    } else {
+        result = { OfflineCodec::Zlib, util::compress(data) };
+    }
+
+    if (result.second.size() >= data.size()) {
+        return { OfflineCodec::None, {} };
+    }
+
+    return result;
+}
+
+std::string decodeOfflineData(OfflineCodec codec, const std::string& data) {
+    switch (codec) {
+    case OfflineCodec::None:
+        return data;
+    case OfflineCodec::Zlib:
+        return util::decompress(data);
+    case OfflineCodec::ZlibVectorTileDictionary:
+        return util::decompress(data, vectorTileDictionary());
+    }
+
+    throw std::runtime_error("Unknown offline data codec");
+}
+
+} // namespace mbgl
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <string>
+#include <utility>
+
+namespace mbgl {
+
+/*
+ * Identifies how the `data` column of a row in the `resources` or `tiles` table is
+ * encoded. The value is stored in the `compressed` column, whose original values of 0
+ * and 1 coincide with None and Zlib, so rows written by earlier schema versions need no
+ * migration. The numbering is persistent: never renumber or reuse a codec, and never
+ * change the behavior of an existing one.
+ */
+enum class OfflineCodec : int {
+    None = 0,
+    Zlib = 1,
+    ZlibVectorTileDictionary = 2,
+};
+
+/*
+ * Compresses data with the codec best suited to it. Returns OfflineCodec::None and an
+ * empty string if compression doesn't make the data any smaller.
+ */
+std::pair<OfflineCodec, std::string> encodeOfflineData(const std::string& data);
+
+std::string decodeOfflineData(OfflineCodec, const std::string& data);
+
+} // namespace mbgl
@@ -1,6 +1,6 @@
 #include <mbgl/storage/offline_database.hpp>
 #include <mbgl/storage/response.hpp>
-#include <mbgl/util/compression.hpp>
+#include <mbgl/storage/offline_codec.hpp>
 #include <mbgl/util/io.hpp>
 #include <mbgl/util/string.hpp>
 #include <mbgl/util/chrono.hpp>
@@ -10,6 +10,52 @@
 
 namespace mbgl {
 
+namespace {
+
+// Attaches another database file to a connection, under the schema name "archive", for
+// the lifetime of this object. Statements referring to it must be gone before it is.
+class AttachedArchive {
+public:
+    AttachedArchive(mapbox::sqlite::Database& db_, const std::string& path) : db(db_) {
+        mapbox::sqlite::Statement stmt = db.prepare("ATTACH DATABASE ?1 AS archive");
+        stmt.bind(1, path);
+        stmt.run();
+    }
+
+    ~AttachedArchive() {
+        try {
+            db.exec("DETACH DATABASE archive");
+        } catch (mapbox::sqlite::Exception& ex) {
+            Log::Error(Event::Database, ex.code, ex.what());
+        }
+    }
+
+private:
+    mapbox::sqlite::Database& db;
+};
+
+// The version of offline_schema.sql, stored in `PRAGMA user_version`. If you change the
+// schema you must bump it and write a migration from the previous version.
+const int schemaVersion = 6;
+
+// Secondary indexes from offline_schema.sql. Bulk imports may drop them and build them
+// again once all rows are in.
+const struct {
+    const char* drop;
+    const char* create;
+} secondaryIndexes[] = {
+    { "DROP INDEX main.resources_accessed",
+      "CREATE INDEX main.resources_accessed ON resources (accessed)" },
+    { "DROP INDEX main.tiles_accessed",
+      "CREATE INDEX main.tiles_accessed ON tiles (accessed)" },
+    { "DROP INDEX main.region_resources_resource_id",
+      "CREATE INDEX main.region_resources_resource_id ON region_resources (resource_id)" },
+    { "DROP INDEX main.region_tiles_tile_id",
+      "CREATE INDEX main.region_tiles_tile_id ON region_tiles (tile_id)" },
+};
+
+} // namespace
+
 OfflineDatabase::Statement::~Statement() {
     stmt.reset();
     stmt.clearBindings();
@@ -21,6 +67,17 @@ OfflineDatabase::OfflineDatabase(std::string path_, uint64_t maximumCacheSize_)
     ensureSchema();
 }
 
+OfflineDatabase::OfflineDatabase(std::string path_, ReadOnlyConnection)
+    : path(std::move(path_)),
+      readOnly(true),
+      maximumCacheSize(0) {
+    connect(mapbox::sqlite::ReadOnly);
+}
+
+std::unique_ptr<OfflineDatabase> OfflineDatabase::openReadOnly(std::string path) {
+    return std::unique_ptr<OfflineDatabase>(new OfflineDatabase(std::move(path), ReadOnlyConnection()));
+}
+
 OfflineDatabase::~OfflineDatabase() {
     // Deleting these SQLite objects may result in exceptions, but we're in a destructor, so we
     // can't throw anything.
@@ -49,7 +106,11 @@ void OfflineDatabase::ensureSchema() {
             case 2: migrateToVersion3(); // fall through
             case 3: // no-op and fall through
             case 4: migrateToVersion5(); // fall through
-            case 5: return;
+            case 5: migrateToVersion6(); // fall through
+            case 6:
+                // Unlike the journal mode, this setting isn't persistent.
+                db->exec("PRAGMA synchronous = NORMAL");
+                return;
             default: throw std::runtime_error("unknown schema version");
             }
 
@@ -78,12 +139,11 @@ void OfflineDatabase::ensureSchema() {
 
         connect(mapbox::sqlite::ReadWrite | mapbox::sqlite::Create);
 
-        // If you change the schema you must write a migration from the previous version.
         db->exec("PRAGMA auto_vacuum = INCREMENTAL");
-        db->exec("PRAGMA journal_mode = DELETE");
-        db->exec("PRAGMA synchronous = FULL");
+        db->exec("PRAGMA journal_mode = WAL");
+        db->exec("PRAGMA synchronous = NORMAL");
         db->exec(schema);
-        db->exec("PRAGMA user_version = 5");
+        db->exec("PRAGMA user_version = " + util::toString(schemaVersion));
     } catch (...) {
         Log::Error(Event::Database, "Unexpected error creating database schema: %s", util::toString(std::current_exception()).c_str());
         throw;
@@ -126,6 +186,15 @@ void OfflineDatabase::migrateToVersion5() {
     db->exec("PRAGMA user_version = 5");
 }
 
+// Version 6 switches back to a write-ahead log, now that cache reads are served from
+// separate read-only connections (see openReadOnly()) that must not block on downloads.
+// It also reinterprets the `compressed` column as an OfflineCodec, whose values 0 and 1
+// match the old ones, so the tables themselves are unchanged.
+void OfflineDatabase::migrateToVersion6() {
+    db->exec("PRAGMA journal_mode = WAL");
+    db->exec("PRAGMA user_version = 6");
+}
+
 OfflineDatabase::Statement OfflineDatabase::getStatement(const char * sql) {
     auto it = statements.find(sql);
 
@@ -159,7 +228,18 @@ optional<int64_t> OfflineDatabase::hasInternal(const Resource& resource) {
     }
 }
 
+void OfflineDatabase::touch(const Resource& resource) {
+    assert(!readOnly);
+    if (resource.kind == Resource::Kind::Tile) {
+        assert(resource.tileData);
+        touchTile(*resource.tileData);
+    } else {
+        touchResource(resource);
+    }
+}
+
 std::pair<bool, uint64_t> OfflineDatabase::put(const Resource& resource, const Response& response) {
+    assert(!readOnly);
     return putInternal(resource, response, true);
 }
 
@@ -169,13 +249,12 @@ std::pair<bool, uint64_t> OfflineDatabase::putInternal(const Resource& resource,
     }
 
     std::string compressedData;
-    bool compressed = false;
+    OfflineCodec codec = OfflineCodec::None;
     uint64_t size = 0;
 
     if (response.data) {
-        compressedData = util::compress(*response.data);
-        compressed = compressedData.size() < response.data->size();
-        size = compressed ? compressedData.size() : response.data->size();
+        std::tie(codec, compressedData) = encodeOfflineData(*response.data);
+        size = codec != OfflineCodec::None ? compressedData.size() : response.data->size();
     }
 
     if (evict_ && !evict(size)) {
@@ -188,18 +267,18 @@ std::pair<bool, uint64_t> OfflineDatabase::putInternal(const Resource& resource,
     if (resource.kind == Resource::Kind::Tile) {
         assert(resource.tileData);
         inserted = putTile(*resource.tileData, response,
-                compressed ? compressedData : *response.data,
-                compressed);
+                codec != OfflineCodec::None ? compressedData : *response.data,
+                codec);
     } else {
         inserted = putResource(resource, response,
-                compressed ? compressedData : *response.data,
-                compressed);
+                codec != OfflineCodec::None ? compressedData : *response.data,
+                codec);
     }
 
     return { inserted, size };
 }
 
-optional<std::pair<Response, uint64_t>> OfflineDatabase::getResource(const Resource& resource) {
+void OfflineDatabase::touchResource(const Resource& resource) {
     // clang-format off
     Statement accessedStmt = getStatement(
         "UPDATE resources SET accessed = ?1 WHERE url = ?2");
@@ -208,6 +287,12 @@ optional<std::pair<Response, uint64_t>> OfflineDatabase::getResource(const Resou
     accessedStmt->bind(1, util::now());
     accessedStmt->bind(2, resource.url);
     accessedStmt->run();
+}
+
+optional<std::pair<Response, uint64_t>> OfflineDatabase::getResource(const Resource& resource) {
+    if (!readOnly) {
+        touchResource(resource);
+    }
 
     // clang-format off
     Statement stmt = getStatement(
@@ -234,7 +319,7 @@ optional<std::pair<Response, uint64_t>> OfflineDatabase::getResource(const Resou
     if (!data) {
         response.noContent = true;
     } else if (stmt->get<int>(4)) {
-        response.data = std::make_shared<std::string>(util::decompress(*data));
+        response.data = std::make_shared<std::string>(decodeOfflineData(OfflineCodec(stmt->get<int>(4)), *data));
         size = data->length();
     } else {
         response.data = std::make_shared<std::string>(*data);
@@ -260,7 +345,7 @@ optional<int64_t> OfflineDatabase::hasResource(const Resource& resource) {
 bool OfflineDatabase::putResource(const Resource& resource,
                                   const Response& response,
                                   const std::string& data,
-                                  bool compressed) {
+                                  OfflineCodec codec) {
     if (response.notModified) {
         // clang-format off
         Statement update = getStatement(
@@ -308,7 +393,7 @@ bool OfflineDatabase::putResource(const Resource& resource,
         update->bind(7, false);
     } else {
         update->bindBlob(6, data.data(), data.size(), false);
-        update->bind(7, compressed);
+        update->bind(7, int(codec));
     }
 
     update->run();
@@ -335,7 +420,7 @@ bool OfflineDatabase::putResource(const Resource& resource,
         insert->bind(8, false);
     } else {
         insert->bindBlob(7, data.data(), data.size(), false);
-        insert->bind(8, compressed);
+        insert->bind(8, int(codec));
     }
 
     insert->run();
@@ -344,7 +429,7 @@ bool OfflineDatabase::putResource(const Resource& resource,
     return true;
 }
 
-optional<std::pair<Response, uint64_t>> OfflineDatabase::getTile(const Resource::TileData& tile) {
+void OfflineDatabase::touchTile(const Resource::TileData& tile) {
     // clang-format off
     Statement accessedStmt = getStatement(
         "UPDATE tiles "
@@ -363,6 +448,12 @@ optional<std::pair<Response, uint64_t>> OfflineDatabase::getTile(const Resource:
     accessedStmt->bind(5, tile.y);
     accessedStmt->bind(6, tile.z);
     accessedStmt->run();
+}
+
+optional<std::pair<Response, uint64_t>> OfflineDatabase::getTile(const Resource::TileData& tile) {
+    if (!readOnly) {
+        touchTile(tile);
+    }
 
     // clang-format off
     Statement stmt = getStatement(
@@ -397,7 +488,7 @@ optional<std::pair<Response, uint64_t>> OfflineDatabase::getTile(const Resource:
     if (!data) {
         response.noContent = true;
     } else if (stmt->get<int>(4)) {
-        response.data = std::make_shared<std::string>(util::decompress(*data));
+        response.data = std::make_shared<std::string>(decodeOfflineData(OfflineCodec(stmt->get<int>(4)), *data));
         size = data->length();
     } else {
         response.data = std::make_shared<std::string>(*data);
@@ -435,7 +526,7 @@ optional<int64_t> OfflineDatabase::hasTile(const Resource::TileData& tile) {
 bool OfflineDatabase::putTile(const Resource::TileData& tile,
                               const Response& response,
                               const std::string& data,
-                              bool compressed) {
+                              OfflineCodec codec) {
     if (response.notModified) {
         // clang-format off
         Statement update = getStatement(
@@ -497,7 +588,7 @@ bool OfflineDatabase::putTile(const Resource::TileData& tile,
         update->bind(6, false);
     } else {
         update->bindBlob(5, data.data(), data.size(), false);
-        update->bind(6, compressed);
+        update->bind(6, int(codec));
     }
 
     update->run();
@@ -527,7 +618,7 @@ bool OfflineDatabase::putTile(const Resource::TileData& tile,
         insert->bind(11, false);
     } else {
         insert->bindBlob(10, data.data(), data.size(), false);
-        insert->bind(11, compressed);
+        insert->bind(11, int(codec));
     }
 
     insert->run();
@@ -598,6 +689,185 @@ void OfflineDatabase::deleteRegion(OfflineRegion&& region) {
     offlineMapboxTileCount = {};
 }
 
+void OfflineDatabase::exportRegion(int64_t regionID, const std::string& exportPath) {
+    assert(!readOnly);
+
+    // Start out from an empty database with the current schema.
+    try {
+        util::deleteFile(exportPath);
+    } catch (util::IOException&) {
+        // Nothing to replace.
+    }
+    OfflineDatabase(exportPath, 0);
+
+    AttachedArchive archive(*db, exportPath);
+    mapbox::sqlite::Transaction transaction(*db);
+
+    // Row IDs are carried over unchanged; the exported database only holds this region.
+    // clang-format off
+    const char* queries[] = {
+        "INSERT INTO archive.regions (id, definition, description) "
+        "SELECT id, definition, description "
+        "FROM main.regions "
+        "WHERE id = ?1 ",
+
+        "INSERT INTO archive.resources (id, url, kind, expires, modified, etag, data, compressed, accessed) "
+        "SELECT id, url, kind, expires, modified, etag, data, compressed, accessed "
+        "FROM main.resources, main.region_resources "
+        "WHERE region_id = ?1 "
+        "AND resource_id = id ",
+
+        "INSERT INTO archive.tiles (id, url_template, pixel_ratio, z, x, y, expires, modified, etag, data, compressed, accessed) "
+        "SELECT id, url_template, pixel_ratio, z, x, y, expires, modified, etag, data, compressed, accessed "
+        "FROM main.tiles, main.region_tiles "
+        "WHERE region_id = ?1 "
+        "AND tile_id = id ",
+
+        "INSERT INTO archive.region_resources (region_id, resource_id) "
+        "SELECT region_id, resource_id "
+        "FROM main.region_resources "
+        "WHERE region_id = ?1 ",
+
+        "INSERT INTO archive.region_tiles (region_id, tile_id) "
+        "SELECT region_id, tile_id "
+        "FROM main.region_tiles "
+        "WHERE region_id = ?1 ",
+    };
+    // clang-format on
+
+    for (const char* sql : queries) {
+        mapbox::sqlite::Statement stmt = db->prepare(sql);
+        stmt.bind(1, regionID);
+        stmt.run();
+
+        if (sql == queries[0] && stmt.changes() == 0) {
+            throw std::runtime_error("Unknown offline region");
+        }
+    }
+
+    transaction.commit();
+}
+
+std::vector<OfflineRegion> OfflineDatabase::importRegions(const std::string& importPath) {
+    assert(!readOnly);
+
+    // Open the archive on its own first: ATTACH would quietly create a missing file, and
+    // wouldn't notice a file that isn't a database until it's read.
+    try {
+        mapbox::sqlite::Database archive(importPath, mapbox::sqlite::ReadOnly);
+        mapbox::sqlite::Statement stmt = archive.prepare("PRAGMA user_version");
+        stmt.run();
+        const int version = stmt.get<int>(0);
+
+        // The tables have been the same since version 3.
+        if (version < 3 || version > schemaVersion) {
+            throw std::runtime_error("Unsupported offline database version");
+        }
+    } catch (mapbox::sqlite::Exception& ex) {
+        throw std::runtime_error(std::string("Cannot read offline database: ") + ex.what());
+    }
+
+    AttachedArchive archive(*db, importPath);
+
+    // A single transaction for the whole import; committing row by row would spend most
+    // of the time syncing.
+    mapbox::sqlite::Transaction transaction(*db, mapbox::sqlite::Transaction::Immediate);
+
+    // Updating the secondary indexes row by row dominates large imports. If the import
+    // outweighs what's already stored, drop them and build them from scratch at the end,
+    // which takes time proportional to the size of the whole database.
+    bool deferIndexes;
+    {
+        // clang-format off
+        mapbox::sqlite::Statement stmt = db->prepare(
+            "SELECT (SELECT COUNT(*) FROM archive.resources) + (SELECT COUNT(*) FROM archive.tiles), "
+            "       (SELECT COUNT(*) FROM main.resources) + (SELECT COUNT(*) FROM main.tiles) ");
+        // clang-format on
+        stmt.run();
+        deferIndexes = stmt.get<int64_t>(0) > stmt.get<int64_t>(1);
+    }
+
+    if (deferIndexes) {
+        for (const auto& index : secondaryIndexes) {
+            db->exec(index.drop);
+        }
+    }
+
+    // Resources and tiles are unique by URL and tile coordinates respectively. Rows that
+    // are already present win, so existing regions see no change.
+    // clang-format off
+    db->exec(
+        "INSERT OR IGNORE INTO main.resources (url, kind, expires, modified, etag, data, compressed, accessed) "
+        "SELECT url, kind, expires, modified, etag, data, compressed, accessed "
+        "FROM archive.resources ");
+
+    db->exec(
+        "INSERT OR IGNORE INTO main.tiles (url_template, pixel_ratio, z, x, y, expires, modified, etag, data, compressed, accessed) "
+        "SELECT url_template, pixel_ratio, z, x, y, expires, modified, etag, data, compressed, accessed "
+        "FROM archive.tiles ");
+
+    mapbox::sqlite::Statement regionsStmt = db->prepare(
+        "SELECT id, definition, description "
+        "FROM archive.regions ");
+
+    mapbox::sqlite::Statement resourcesStmt = db->prepare(
+        "INSERT OR IGNORE INTO main.region_resources (region_id, resource_id) "
+        "SELECT ?1, main.resources.id "
+        "FROM archive.region_resources, archive.resources, main.resources "
+        "WHERE archive.region_resources.region_id = ?2 "
+        "AND archive.resources.id = archive.region_resources.resource_id "
+        "AND main.resources.url = archive.resources.url ");
+
+    mapbox::sqlite::Statement tilesStmt = db->prepare(
+        "INSERT OR IGNORE INTO main.region_tiles (region_id, tile_id) "
+        "SELECT ?1, main.tiles.id "
+        "FROM archive.region_tiles, archive.tiles, main.tiles "
+        "WHERE archive.region_tiles.region_id = ?2 "
+        "AND archive.tiles.id = archive.region_tiles.tile_id "
+        "AND main.tiles.url_template = archive.tiles.url_template "
+        "AND main.tiles.pixel_ratio = archive.tiles.pixel_ratio "
+        "AND main.tiles.z = archive.tiles.z "
+        "AND main.tiles.x = archive.tiles.x "
+        "AND main.tiles.y = archive.tiles.y ");
+    // clang-format on
+
+    std::vector<OfflineRegion> result;
+
+    while (regionsStmt.run()) {
+        const int64_t archiveID = regionsStmt.get<int64_t>(0);
+        OfflineRegion region = createRegion(
+            decodeOfflineRegionDefinition(regionsStmt.get<std::string>(1)),
+            regionsStmt.get<std::vector<uint8_t>>(2));
+
+        for (mapbox::sqlite::Statement* stmt : { &resourcesStmt, &tilesStmt }) {
+            stmt->reset();
+            stmt->bind(1, region.getID());
+            stmt->bind(2, archiveID);
+            stmt->run();
+        }
+
+        result.push_back(std::move(region));
+    }
+
+    if (deferIndexes) {
+        for (const auto& index : secondaryIndexes) {
+            db->exec(index.create);
+        }
+    }
+
+    // Like putRegionResource(), imports may not take the database past the Mapbox tile count
+    // limit. Leaving the transaction uncommitted rolls the whole import back.
+    offlineMapboxTileCount = {};
+    if (getOfflineMapboxTileCount() > offlineMapboxTileCountLimit) {
+        offlineMapboxTileCount = {};
+        throw std::runtime_error("Importing would exceed the offline Mapbox tile count limit");
+    }
+
+    transaction.commit();
+
+    return result;
+}
+
 optional<std::pair<Response, uint64_t>> OfflineDatabase::getRegionResource(int64_t regionID, const Resource& resource) {
     auto response = getInternal(resource);
 
@@ -22,6 +22,7 @@ namespace mbgl {
 
 class Response;
 class TileID;
+enum class OfflineCodec : int;
 
 class OfflineDatabase : private util::noncopyable {
 public:
@@ -30,8 +31,19 @@ public:
     OfflineDatabase(std::string path, uint64_t maximumCacheSize = util::DEFAULT_MAX_CACHE_SIZE);
     ~OfflineDatabase();
 
+    // Opens an additional read-only connection to a database that was already created by
+    // a read-write instance. Because the database uses a write-ahead log, reads on such a
+    // connection do not block on, and are not blocked by, the writer. Only get() may be
+    // used; it does not update access times, which must be recorded on the writer with
+    // touch() instead.
+    static std::unique_ptr<OfflineDatabase> openReadOnly(std::string path);
+
     optional<Response> get(const Resource&);
 
+    // Records a cache hit served by a read-only connection, so that eviction remains
+    // least-recently-used.
+    void touch(const Resource&);
+
     // Return value is (inserted, stored size)
     std::pair<bool, uint64_t> put(const Resource&, const Response&);
 
@@ -44,6 +56,15 @@ public:
 
     void deleteRegion(OfflineRegion&&);
 
+    // Writes a region, along with the resources and tiles it uses, to a new standalone
+    // offline database at the given path, replacing any file already there.
+    void exportRegion(int64_t regionID, const std::string& path);
+
+    // Adds all regions stored in an offline database (typically one written by
+    // exportRegion()) to this one. Resources and tiles that are already present are
+    // kept as they are and shared with the imported regions.
+    std::vector<OfflineRegion> importRegions(const std::string& path);
+
     // Return value is (response, stored size)
     optional<std::pair<Response, uint64_t>> getRegionResource(int64_t regionID, const Resource&);
     optional<int64_t> hasRegionResource(int64_t regionID, const Resource&);
@@ -58,12 +79,16 @@ public:
     uint64_t getOfflineMapboxTileCount();
 
 private:
+    struct ReadOnlyConnection {};
+    OfflineDatabase(std::string path, ReadOnlyConnection);
+
     void connect(int flags);
     int userVersion();
     void ensureSchema();
     void removeExisting();
     void migrateToVersion3();
     void migrateToVersion5();
+    void migrateToVersion6();
 
     class Statement {
     public:
@@ -81,14 +106,16 @@ private:
     Statement getStatement(const char *);
 
     optional<std::pair<Response, uint64_t>> getTile(const Resource::TileData&);
+    void touchTile(const Resource::TileData&);
     optional<int64_t> hasTile(const Resource::TileData&);
     bool putTile(const Resource::TileData&, const Response&,
-                 const std::string&, bool compressed);
+                 const std::string&, OfflineCodec);
 
     optional<std::pair<Response, uint64_t>> getResource(const Resource&);
+    void touchResource(const Resource&);
     optional<int64_t> hasResource(const Resource&);
     bool putResource(const Resource&, const Response&,
-                     const std::string&, bool compressed);
+                     const std::string&, OfflineCodec);
 
     optional<std::pair<Response, uint64_t>> getInternal(const Resource&);
     optional<int64_t> hasInternal(const Resource&);
@@ -101,6 +128,7 @@ private:
     std::pair<int64_t, int64_t> getCompletedTileCountAndSize(int64_t regionID);
 
     const std::string path;
+    const bool readOnly = false;
     std::unique_ptr<::mapbox::sqlite::Database> db;
     std::unordered_map<const char *, std::unique_ptr<::mapbox::sqlite::Statement>> statements;
 
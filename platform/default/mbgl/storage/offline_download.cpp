@@ -81,15 +81,15 @@ OfflineRegionStatus OfflineDownload::getStatus() const {
 
             if (urlOrTileset.is<Tileset>()) {
                 result.requiredResourceCount +=
-                    definition.tileCover(type, tileSize, urlOrTileset.get<Tileset>().zoomRange).size();
+                    definition.tileCount(type, tileSize, urlOrTileset.get<Tileset>().zoomRange);
             } else {
                 result.requiredResourceCount += 1;
                 const std::string& url = urlOrTileset.get<std::string>();
                 optional<Response> sourceResponse = offlineDatabase.get(Resource::source(url));
                 if (sourceResponse) {
                     result.requiredResourceCount +=
-                        definition.tileCover(type, tileSize, style::TileSourceImpl::parseTileJSON(
-                            *sourceResponse->data, url, type, tileSize).zoomRange).size();
+                        definition.tileCount(type, tileSize, style::TileSourceImpl::parseTileJSON(
+                            *sourceResponse->data, url, type, tileSize).zoomRange);
                 } else {
                     result.requiredResourceCountIsPrecise = false;
                 }
@@ -217,20 +217,33 @@ void OfflineDownload::activateDownload() {
    the first few errors is fruitless anyway.
 */
 void OfflineDownload::continueDownload() {
-    if (resourcesRemaining.empty() && status.complete()) {
+    if (resourcesRemaining.empty() && tilesRemaining.empty() && status.complete()) {
         setState(OfflineRegionDownloadState::Inactive);
         return;
     }
 
-    while (!resourcesRemaining.empty() && requests.size() < HTTPFileSource::maximumConcurrentRequests()) {
-        ensureResource(resourcesRemaining.front());
-        resourcesRemaining.pop_front();
+    while (requests.size() < HTTPFileSource::maximumConcurrentRequests()) {
+        if (!resourcesRemaining.empty()) {
+            ensureResource(resourcesRemaining.front());
+            resourcesRemaining.pop_front();
+        } else if (!tilesRemaining.empty()) {
+            TileQueue& queue = tilesRemaining.front();
+            const UnwrappedTileID tile = *queue.cover.next();
+            ensureResource(Resource::tile(queue.urlTemplate, definition.pixelRatio,
+                tile.canonical.x, tile.canonical.y, tile.canonical.z, queue.scheme));
+            if (queue.cover.done()) {
+                tilesRemaining.pop_front();
+            }
+        } else {
+            break;
+        }
     }
 }
 
 void OfflineDownload::deactivateDownload() {
     requiredSourceURLs.clear();
     resourcesRemaining.clear();
+    tilesRemaining.clear();
     requests.clear();
 }
 
@@ -239,12 +252,16 @@ void OfflineDownload::queueResource(Resource resource) {
     resourcesRemaining.push_front(std::move(resource));
 }
 
+// Tiles are only turned into resources as request slots free up, so that even regions
+// with millions of tiles take constant memory to set up.
 void OfflineDownload::queueTiles(SourceType type, uint16_t tileSize, const Tileset& tileset) {
-    for (const auto& tile : definition.tileCover(type, tileSize, tileset.zoomRange)) {
-        status.requiredResourceCount++;
-        resourcesRemaining.push_back(
-            Resource::tile(tileset.tiles[0], definition.pixelRatio, tile.x, tile.y, tile.z, tileset.scheme));
+    util::BoundsTileCover cover(definition.bounds, definition.coveringZoomRange(type, tileSize, tileset.zoomRange));
+    if (cover.done()) {
+        return;
     }
+
+    status.requiredResourceCount += definition.tileCount(type, tileSize, tileset.zoomRange);
+    tilesRemaining.push_back({ tileset.tiles[0], tileset.scheme, std::move(cover) });
 }
 
 void OfflineDownload::ensureResource(const Resource& resource,
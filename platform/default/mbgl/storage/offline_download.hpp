@@ -2,6 +2,8 @@
 
 #include <mbgl/storage/offline.hpp>
 #include <mbgl/storage/resource.hpp>
+#include <mbgl/util/tile_cover.hpp>
+#include <mbgl/util/tileset.hpp>
 
 #include <list>
 #include <unordered_set>
@@ -14,7 +16,6 @@ class OfflineDatabase;
 class FileSource;
 class AsyncRequest;
 class Response;
-class Tileset;
 
 namespace style {
 class Parser;
@@ -59,6 +60,14 @@ private:
     std::unordered_set<std::string> requiredSourceURLs;
     std::deque<Resource> resourcesRemaining;
 
+    // Tiles still to be requested, per tile source.
+    struct TileQueue {
+        std::string urlTemplate;
+        Tileset::Scheme scheme;
+        util::BoundsTileCover cover;
+    };
+    std::deque<TileQueue> tilesRemaining;
+
     void queueResource(Resource);
     void queueTiles(SourceType, uint16_t tileSize, const Tileset&);
 };
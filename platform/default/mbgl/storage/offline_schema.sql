@@ -6,7 +6,7 @@ CREATE TABLE resources (                   -- Generic table for style, source, s
   modified INTEGER,
   etag TEXT,
   data BLOB,
-  compressed INTEGER NOT NULL DEFAULT 0,
+  compressed INTEGER NOT NULL DEFAULT 0,   -- Encoding of data; see OfflineCodec in offline_codec.hpp.
   accessed INTEGER NOT NULL,
   UNIQUE (url)
 );
@@ -22,7 +22,7 @@ CREATE TABLE tiles (
   modified INTEGER,
   etag TEXT,
   data BLOB,
-  compressed INTEGER NOT NULL DEFAULT 0,
+  compressed INTEGER NOT NULL DEFAULT 0,   -- Encoding of data; see OfflineCodec in offline_codec.hpp.
   accessed INTEGER NOT NULL,
   UNIQUE (url_template, pixel_ratio, z, x, y)
 );
@@ -0,0 +1,228 @@
+#include <mbgl/storage/mbtiles_file_source.hpp>
+#include <mbgl/storage/response.hpp>
+#include <mbgl/util/compression.hpp>
+#include <mbgl/util/string.hpp>
+#include <mbgl/util/thread.hpp>
+#include <mbgl/util/url.hpp>
+
+#include "sqlite3.hpp"
+
+#include <rapidjson/document.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+#include <cstdlib>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace {
+
+const char* protocol = "mbtiles://";
+const std::size_t protocolLength = 10;
+
+// Number of threads serving requests, each with its own set of read-only connections.
+const std::size_t threadCount = 4;
+
+bool isGzipped(const std::string& data) {
+    return data.size() > 2 && uint8_t(data[0]) == 0x1F && uint8_t(data[1]) == 0x8B;
+}
+
+std::vector<double> parseNumbers(const std::string& list) {
+    std::vector<double> result;
+    const char* begin = list.c_str();
+    while (*begin) {
+        char* end = nullptr;
+        result.push_back(std::strtod(begin, &end));
+        if (end == begin) {
+            return {};
+        }
+        begin = *end == ',' ? end + 1 : end;
+    }
+    return result;
+}
+
+} // namespace
+
+namespace mbgl {
+
+class MBTilesFileSource::Impl {
+public:
+    void request(const Resource& resource, FileSource::Callback callback) {
+        const std::string fileURL = resource.url.substr(0, resource.url.find('?'));
+        const std::string path = util::percentDecode(fileURL.substr(protocolLength));
+
+        Response response;
+
+        try {
+            Connection& connection = getConnection(path);
+            if (resource.kind == Resource::Kind::Tile && resource.tileData) {
+                readTile(connection, *resource.tileData, response);
+            } else {
+                response.data = std::make_shared<std::string>(readTileJSON(connection, fileURL));
+            }
+        } catch (const mapbox::sqlite::Exception& ex) {
+            connections.erase(path);
+            response.error = std::make_unique<Response::Error>(
+                ex.code == mapbox::sqlite::Exception::Code::CANTOPEN ? Response::Error::Reason::NotFound
+                                                                     : Response::Error::Reason::Other,
+                ex.what());
+        } catch (...) {
+            response.error = std::make_unique<Response::Error>(
+                Response::Error::Reason::Other,
+                util::toString(std::current_exception()));
+        }
+
+        callback(response);
+    }
+
+private:
+    struct Connection {
+        Connection(const std::string& path)
+            : db(path, mapbox::sqlite::ReadOnly),
+              tileStatement(db.prepare(
+                  "SELECT tile_data FROM tiles "
+                  "WHERE zoom_level = ?1 AND tile_column = ?2 AND tile_row = ?3")),
+              metadataStatement(db.prepare("SELECT name, value FROM metadata")) {
+        }
+
+        mapbox::sqlite::Database db;
+        mapbox::sqlite::Statement tileStatement;
+        mapbox::sqlite::Statement metadataStatement;
+    };
+
+    Connection& getConnection(const std::string& path) {
+        auto it = connections.find(path);
+        if (it == connections.end()) {
+            it = connections.emplace(path, std::make_unique<Connection>(path)).first;
+        }
+        return *it->second;
+    }
+
+    void readTile(Connection& connection, const Resource::TileData& tile, Response& response) {
+        // Tile rows are stored in TMS order; the TileJSON we hand out declares that scheme,
+        // so tileData.y has already been flipped accordingly.
+        mapbox::sqlite::Statement& stmt = connection.tileStatement;
+        stmt.reset();
+        stmt.bind(1, tile.z);
+        stmt.bind(2, tile.x);
+        stmt.bind(3, tile.y);
+
+        if (!stmt.run()) {
+            response.noContent = true;
+            return;
+        }
+
+        std::string data = stmt.get<std::string>(0);
+        stmt.reset();
+
+        if (isGzipped(data)) {
+            data = util::decompress(data);
+        }
+
+        response.data = std::make_shared<std::string>(std::move(data));
+    }
+
+    std::string readTileJSON(Connection& connection, const std::string& fileURL) {
+        rapidjson::StringBuffer buffer;
+        rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+
+        // Every key is written once. The fields set here take precedence over metadata rows,
+        // and metadata rows over the members of the "json" row.
+        std::unordered_set<std::string> keys;
+        auto key = [&] (const std::string& name) {
+            if (!keys.insert(name).second) {
+                return false;
+            }
+            writer.Key(name.data(), name.size());
+            return true;
+        };
+
+        writer.StartObject();
+        key("tilejson");
+        writer.String("2.0.0");
+        key("scheme");
+        writer.String("tms");
+        key("tiles");
+        writer.StartArray();
+        writer.String(fileURL + "?z={z}&x={x}&y={y}");
+        writer.EndArray();
+
+        mapbox::sqlite::Statement& stmt = connection.metadataStatement;
+        stmt.reset();
+
+        std::string json;
+
+        while (stmt.run()) {
+            const std::string name = stmt.get<std::string>(0);
+            const std::string value = stmt.get<std::string>(1);
+
+            if (name == "json") {
+                // Vector tilesets keep their layer descriptions (vector_layers) in here.
+                json = value;
+            } else if (name == "minzoom" || name == "maxzoom") {
+                if (key(name)) {
+                    writer.Int(std::atoi(value.c_str()));
+                }
+            } else if (name == "bounds" || name == "center") {
+                const std::vector<double> numbers = parseNumbers(value);
+                if (numbers.size() == (name == "bounds" ? 4 : 3) && key(name)) {
+                    writer.StartArray();
+                    for (double number : numbers) {
+                        writer.Double(number);
+                    }
+                    writer.EndArray();
+                }
+            } else if (key(name)) {
+                writer.String(value);
+            }
+        }
+
+        stmt.reset();
+
+        if (!json.empty()) {
+            rapidjson::GenericDocument<rapidjson::UTF8<>, rapidjson::CrtAllocator> doc;
+            doc.Parse<0>(json.c_str());
+            if (!doc.HasParseError() && doc.IsObject()) {
+                for (auto it = doc.MemberBegin(); it != doc.MemberEnd(); ++it) {
+                    if (key({ it->name.GetString(), it->name.GetStringLength() })) {
+                        it->value.Accept(writer);
+                    }
+                }
+            }
+        }
+
+        writer.EndObject();
+
+        return { buffer.GetString(), buffer.GetSize() };
+    }
+
+    std::unordered_map<std::string, std::unique_ptr<Connection>> connections;
+};
+
+MBTilesFileSource::MBTilesFileSource() = default;
+
+MBTilesFileSource::~MBTilesFileSource() = default;
+
+util::Thread<MBTilesFileSource::Impl>& MBTilesFileSource::nextThread() {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // Threads are only spun up once the first MBTiles request comes in.
+    if (threads.empty()) {
+        for (std::size_t i = 0; i < threadCount; i++) {
+            threads.push_back(std::make_unique<util::Thread<Impl>>(
+                util::ThreadContext{"MBTilesFileSource", util::ThreadPriority::Low}));
+        }
+    }
+
+    return *threads[nextIndex++ % threads.size()];
+}
+
+std::unique_ptr<AsyncRequest> MBTilesFileSource::request(const Resource& resource, Callback callback) {
+    return nextThread().invokeWithCallback(&Impl::request, resource, callback);
+}
+
+bool MBTilesFileSource::acceptsURL(const std::string& url) {
+    return url.compare(0, protocolLength, protocol) == 0;
+}
+
+} // namespace mbgl
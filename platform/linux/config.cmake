@@ -50,11 +50,14 @@ macro(mbgl_platform_core)
         PRIVATE platform/default/asset_file_source.cpp
         PRIVATE platform/default/default_file_source.cpp
         PRIVATE platform/default/local_file_source.cpp
+        PRIVATE platform/default/mbtiles_file_source.cpp
         PRIVATE platform/default/http_file_source.cpp
         PRIVATE platform/default/online_file_source.cpp
 
         # Offline
         PRIVATE platform/default/mbgl/storage/offline.cpp
+        PRIVATE platform/default/mbgl/storage/offline_codec.cpp
+        PRIVATE platform/default/mbgl/storage/offline_codec.hpp
         PRIVATE platform/default/mbgl/storage/offline_database.cpp
         PRIVATE platform/default/mbgl/storage/offline_database.hpp
         PRIVATE platform/default/mbgl/storage/offline_download.cpp
@@ -134,6 +137,13 @@ macro(mbgl_platform_offline)
 endmacro()
 
 
+macro(mbgl_platform_style)
+    target_link_libraries(mbgl-style
+        PRIVATE mbgl-loop
+    )
+endmacro()
+
+
 macro(mbgl_platform_test)
     target_sources(mbgl-test
         PRIVATE platform/default/mbgl/test/main.cpp
@@ -15,6 +15,7 @@ macro(mbgl_platform_core)
         PRIVATE platform/default/asset_file_source.cpp
         PRIVATE platform/default/default_file_source.cpp
         PRIVATE platform/default/local_file_source.cpp
+        PRIVATE platform/default/mbtiles_file_source.cpp
         PRIVATE platform/default/online_file_source.cpp
 
         # Default styles
@@ -23,6 +24,8 @@ macro(mbgl_platform_core)
 
         # Offline
         PRIVATE platform/default/mbgl/storage/offline.cpp
+        PRIVATE platform/default/mbgl/storage/offline_codec.cpp
+        PRIVATE platform/default/mbgl/storage/offline_codec.hpp
         PRIVATE platform/default/mbgl/storage/offline_database.cpp
         PRIVATE platform/default/mbgl/storage/offline_database.hpp
         PRIVATE platform/default/mbgl/storage/offline_download.cpp
@@ -112,6 +115,19 @@ macro(mbgl_platform_offline)
 endmacro()
 
 
+macro(mbgl_platform_style)
+    target_link_libraries(mbgl-style
+        PRIVATE mbgl-loop
+        PRIVATE "-framework Foundation"
+        PRIVATE "-framework CoreGraphics"
+        PRIVATE "-framework OpenGL"
+        PRIVATE "-framework ImageIO"
+        PRIVATE "-framework CoreServices"
+        PRIVATE "-lsqlite3"
+    )
+endmacro()
+
+
 macro(mbgl_platform_test)
     target_sources(mbgl-test
         PRIVATE platform/default/mbgl/test/main.cpp
@@ -9,9 +9,13 @@
 #include <mbgl/style/layers/symbol_layer.hpp>
 #include <mbgl/style/layers/symbol_layer_impl.hpp>
 #include <mbgl/storage/file_source.hpp>
+#include <mbgl/util/constants.hpp>
+#include <mbgl/util/projection.hpp>
 
 #include <boost/function_output_iterator.hpp>
 
+#include <cmath>
+
 namespace mbgl {
 
 using namespace style;
@@ -57,7 +61,9 @@ void AnnotationManager::removeAnnotation(const AnnotationID& id) {
         symbolTree.remove(symbolAnnotations.at(id));
         symbolAnnotations.erase(id);
     } else if (shapeAnnotations.find(id) != shapeAnnotations.end()) {
-        obsoleteShapeAnnotationLayers.insert(shapeAnnotations.at(id)->layerID);
+        const ShapeAnnotationImpl& impl = *shapeAnnotations.at(id);
+        shapeTree.remove(std::make_pair(impl.bounds(), id));
+        obsoleteShapeAnnotationLayers.insert(impl.layerID);
         shapeAnnotations.erase(id);
     } else {
         assert(false); // Should never happen
@@ -71,20 +77,23 @@ void AnnotationManager::add(const AnnotationID& id, const SymbolAnnotation& anno
 }
 
 void AnnotationManager::add(const AnnotationID& id, const LineAnnotation& annotation, const uint8_t maxZoom) {
-    ShapeAnnotationImpl& impl = *shapeAnnotations.emplace(id,
-        std::make_unique<LineAnnotationImpl>(id, annotation, maxZoom)).first->second;
-    obsoleteShapeAnnotationLayers.erase(impl.layerID);
+    addShape(std::make_unique<LineAnnotationImpl>(id, annotation, maxZoom));
 }
 
 void AnnotationManager::add(const AnnotationID& id, const FillAnnotation& annotation, const uint8_t maxZoom) {
-    ShapeAnnotationImpl& impl = *shapeAnnotations.emplace(id,
-        std::make_unique<FillAnnotationImpl>(id, annotation, maxZoom)).first->second;
-    obsoleteShapeAnnotationLayers.erase(impl.layerID);
+    addShape(std::make_unique<FillAnnotationImpl>(id, annotation, maxZoom));
 }
 
 void AnnotationManager::add(const AnnotationID& id, const StyleSourcedAnnotation& annotation, const uint8_t maxZoom) {
-    ShapeAnnotationImpl& impl = *shapeAnnotations.emplace(id,
-        std::make_unique<StyleSourcedAnnotationImpl>(id, annotation, maxZoom)).first->second;
+    addShape(std::make_unique<StyleSourcedAnnotationImpl>(id, annotation, maxZoom));
+}
+
+void AnnotationManager::addShape(std::unique_ptr<ShapeAnnotationImpl> shape) {
+    auto result = shapeAnnotations.emplace(shape->id, std::move(shape));
+    ShapeAnnotationImpl& impl = *result.first->second;
+    if (result.second) {
+        shapeTree.insert(std::make_pair(impl.bounds(), impl.id));
+    }
     obsoleteShapeAnnotationLayers.erase(impl.layerID);
 }
 
@@ -166,13 +175,41 @@ std::unique_ptr<AnnotationTileData> AnnotationManager::getTileData(const Canonic
             val->updateLayer(tileID, pointLayer);
         }));
 
-    for (const auto& shape : shapeAnnotations) {
-        shape.second->updateTileData(tileID, *tileData);
+    for (const auto& id : queryShapes(tileID)) {
+        shapeAnnotations.at(id)->updateTileData(tileID, *tileData);
     }
 
     return tileData;
 }
 
+std::set<AnnotationID> AnnotationManager::queryShapes(const CanonicalTileID& tileID) const {
+    std::set<AnnotationID> result;
+    if (shapeTree.empty()) {
+        return result;
+    }
+
+    // Shape tiles are cut with a buffer, so shapes just outside the tile can still draw into it.
+    const double scale = std::pow(2.0, tileID.z);
+    const double buffer = double(ShapeAnnotationImpl::buffer) / util::EXTENT;
+    const LatLng northwest = Projection::unproject({ (tileID.x - buffer) * util::tileSize, (tileID.y - buffer) * util::tileSize }, scale);
+    const LatLng southeast = Projection::unproject({ (tileID.x + 1 + buffer) * util::tileSize, (tileID.y + 1 + buffer) * util::tileSize }, scale);
+
+    // Tiles at the antimeridian also show shapes from the other side of it, so the bounds are
+    // queried in the neighbouring world copies as well.
+    for (const double offset : { 0.0, -util::DEGREES_MAX, util::DEGREES_MAX }) {
+        const LatLngBounds bounds = LatLngBounds::hull(
+            { southeast.latitude, northwest.longitude + offset },
+            { northwest.latitude, southeast.longitude + offset });
+
+        shapeTree.query(boost::geometry::index::intersects(bounds),
+            boost::make_function_output_iterator([&](const auto& val) {
+                result.insert(val.second);
+            }));
+    }
+
+    return result;
+}
+
 void AnnotationManager::updateStyle(Style& style) {
     // Create annotation source, point layer, and point bucket
     if (!style.getSource(SourceID)) {
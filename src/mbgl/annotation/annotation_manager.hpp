@@ -6,6 +6,7 @@
 #include <mbgl/map/update.hpp>
 #include <mbgl/util/noncopyable.hpp>
 
+#include <set>
 #include <string>
 #include <vector>
 #include <unordered_set>
@@ -43,6 +44,8 @@ public:
     void addTile(AnnotationTile&);
     void removeTile(AnnotationTile&);
 
+    std::unique_ptr<AnnotationTileData> getTileData(const CanonicalTileID&);
+
     static const std::string SourceID;
     static const std::string PointLayerID;
 
@@ -59,7 +62,7 @@ private:
 
     void removeAndAdd(const AnnotationID&, const Annotation&, const uint8_t);
 
-    std::unique_ptr<AnnotationTileData> getTileData(const CanonicalTileID&);
+    std::set<AnnotationID> queryShapes(const CanonicalTileID&) const;
 
     AnnotationID nextID = 0;
 
@@ -68,9 +71,15 @@ private:
     // <https://github.com/mapbox/mapbox-gl-native/issues/5691>
     using SymbolAnnotationMap = std::map<AnnotationID, std::shared_ptr<SymbolAnnotationImpl>>;
     using ShapeAnnotationMap = std::map<AnnotationID, std::unique_ptr<ShapeAnnotationImpl>>;
+    // Shapes by their bounds, so that a tile is made from only the shapes that can reach into it
+    // rather than from every shape.
+    using ShapeAnnotationTree = boost::geometry::index::rtree<std::pair<LatLngBounds, AnnotationID>, boost::geometry::index::rstar<16, 4>>;
+
+    void addShape(std::unique_ptr<ShapeAnnotationImpl>);
 
     SymbolAnnotationTree symbolTree;
     SymbolAnnotationMap symbolAnnotations;
+    ShapeAnnotationTree shapeTree;
     ShapeAnnotationMap shapeAnnotations;
     std::unordered_set<std::string> obsoleteShapeAnnotationLayers;
     std::unordered_set<AnnotationTile*> tiles;
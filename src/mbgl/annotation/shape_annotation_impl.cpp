@@ -7,6 +7,8 @@
 #include <mbgl/util/constants.hpp>
 #include <mbgl/util/geometry.hpp>
 
+#include <mapbox/geometry/envelope.hpp>
+
 namespace mbgl {
 
 using namespace style;
@@ -18,6 +20,13 @@ ShapeAnnotationImpl::ShapeAnnotationImpl(const AnnotationID id_, const uint8_t m
       layerID("com.mapbox.annotations.shape." + util::toString(id)) {
 }
 
+LatLngBounds ShapeAnnotationImpl::bounds() const {
+    const auto box = ShapeAnnotationGeometry::visit(geometry(), [] (const auto& geom) {
+        return mapbox::geometry::envelope(geom);
+    });
+    return LatLngBounds::hull({ box.min.y, box.min.x }, { box.max.y, box.max.x });
+}
+
 void ShapeAnnotationImpl::updateTileData(const CanonicalTileID& tileID, AnnotationTileData& data) {
     static const double baseTolerance = 4;
 
@@ -28,7 +37,7 @@ void ShapeAnnotationImpl::updateTileData(const CanonicalTileID& tileID, Annotati
         }));
         mapbox::geojsonvt::Options options;
         options.maxZoom = maxZoom;
-        options.buffer = 255u;
+        options.buffer = buffer;
         options.extent = util::EXTENT;
         options.tolerance = baseTolerance;
         shapeTiler = std::make_unique<mapbox::geojsonvt::GeoJSONVT>(features, options);
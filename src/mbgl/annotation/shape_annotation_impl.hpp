@@ -3,6 +3,7 @@
 #include <mapbox/geojsonvt.hpp>
 
 #include <mbgl/annotation/annotation.hpp>
+#include <mbgl/util/geo.hpp>
 #include <mbgl/util/geometry.hpp>
 
 #include <string>
@@ -27,6 +28,12 @@ public:
 
     void updateTileData(const CanonicalTileID&, AnnotationTileData&);
 
+    // The smallest bounds that contain the geometry, by which the annotation manager indexes shapes.
+    LatLngBounds bounds() const;
+
+    // Distance beyond its edges, in tile units, to which a tile includes a shape's geometry.
+    static constexpr uint16_t buffer = 255;
+
     const AnnotationID id;
     const uint8_t maxZoom;
     const std::string layerID;
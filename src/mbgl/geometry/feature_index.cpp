@@ -1,11 +1,11 @@
 #include <mbgl/geometry/feature_index.hpp>
-#include <mbgl/style/style.hpp>
 #include <mbgl/style/layer.hpp>
 #include <mbgl/style/layer_impl.hpp>
 #include <mbgl/style/layers/symbol_layer.hpp>
 #include <mbgl/text/collision_tile.hpp>
 #include <mbgl/util/constants.hpp>
 #include <mbgl/util/math.hpp>
+#include <mbgl/util/lazy_feature_impl.hpp>
 #include <mbgl/math/minmax.hpp>
 
 #include <mapbox/geometry/envelope.hpp>
@@ -19,12 +19,25 @@ FeatureIndex::FeatureIndex()
     : grid(util::EXTENT, 16, 0) {
 }
 
+uint32_t FeatureIndex::getSourceLayerID(const std::string& sourceLayerName) {
+    auto result = sourceLayerIDs.emplace(sourceLayerName, sourceLayerNames.size());
+    if (result.second) {
+        sourceLayerNames.push_back(sourceLayerName);
+    }
+    return result.first->second;
+}
+
+uint32_t FeatureIndex::addBucket(const std::vector<std::string>& layerIDs) {
+    bucketLayerIDs.push_back(layerIDs);
+    return bucketLayerIDs.size() - 1;
+}
+
 void FeatureIndex::insert(const GeometryCollection& geometries,
                           std::size_t index,
-                          const std::string& sourceLayerName,
-                          const std::string& bucketName) {
+                          uint32_t sourceLayerID,
+                          uint32_t bucketID) {
     for (const auto& ring : geometries) {
-        grid.insert(IndexedSubfeature { index, sourceLayerName, bucketName, sortIndex++ },
+        grid.insert(IndexedSubfeature { index, sourceLayerID, bucketID, sortIndex++ },
                     mapbox::geometry::envelope(ring));
     }
 }
@@ -51,21 +64,21 @@ static bool topDownSymbols(const IndexedSubfeature& a, const IndexedSubfeature&
 }
 
 void FeatureIndex::query(
-        std::unordered_map<std::string, std::vector<Feature>>& result,
+        std::unordered_map<std::string, std::vector<LazyFeature>>& result,
         const GeometryCoordinates& queryGeometry,
         const float bearing,
         const double tileSize,
         const double scale,
         const optional<std::vector<std::string>>& filterLayerIDs,
-        const GeometryTileData& geometryTileData,
+        const std::shared_ptr<const GeometryTileData>& geometryTileData,
         const CanonicalTileID& tileID,
-        const style::Style& style,
+        const QueryLayers& queryLayers,
         const CollisionTile* collisionTile) const {
 
     mapbox::geometry::box<int16_t> box = mapbox::geometry::envelope(queryGeometry);
 
     const float pixelsToTileUnits = util::EXTENT / tileSize / scale;
-    const int16_t additionalRadius = std::min<int16_t>(util::EXTENT, std::ceil(style.getQueryRadius() * pixelsToTileUnits));
+    const int16_t additionalRadius = std::min<int16_t>(util::EXTENT, std::ceil(queryLayers.radius * pixelsToTileUnits));
     std::vector<IndexedSubfeature> features = grid.query({ box.min - additionalRadius, box.max + additionalRadius });
 
     std::sort(features.begin(), features.end(), topDown);
@@ -76,7 +89,7 @@ void FeatureIndex::query(
         if (indexedFeature.sortIndex == previousSortIndex) continue;
         previousSortIndex = indexedFeature.sortIndex;
 
-        addFeature(result, indexedFeature, queryGeometry, filterLayerIDs, geometryTileData, tileID, style, bearing, pixelsToTileUnits);
+        addFeature(result, indexedFeature, queryGeometry, filterLayerIDs, geometryTileData, tileID, queryLayers, bearing, pixelsToTileUnits);
     }
 
     // Query symbol features, if they've been placed.
@@ -87,45 +100,58 @@ void FeatureIndex::query(
     std::vector<IndexedSubfeature> symbolFeatures = collisionTile->queryRenderedSymbols(queryGeometry, scale);
     std::sort(symbolFeatures.begin(), symbolFeatures.end(), topDownSymbols);
     for (const auto& symbolFeature : symbolFeatures) {
-        addFeature(result, symbolFeature, queryGeometry, filterLayerIDs, geometryTileData, tileID, style, bearing, pixelsToTileUnits);
+        addFeature(result, symbolFeature, queryGeometry, filterLayerIDs, geometryTileData, tileID, queryLayers, bearing, pixelsToTileUnits);
     }
 }
 
 void FeatureIndex::addFeature(
-    std::unordered_map<std::string, std::vector<Feature>>& result,
+    std::unordered_map<std::string, std::vector<LazyFeature>>& result,
     const IndexedSubfeature& indexedFeature,
     const GeometryCoordinates& queryGeometry,
     const optional<std::vector<std::string>>& filterLayerIDs,
-    const GeometryTileData& geometryTileData,
+    const std::shared_ptr<const GeometryTileData>& geometryTileData,
     const CanonicalTileID& tileID,
-    const style::Style& style,
+    const QueryLayers& queryLayers,
     const float bearing,
     const float pixelsToTileUnits) const {
 
-    auto& layerIDs = bucketLayerIDs.at(indexedFeature.bucketName);
+    auto& layerIDs = bucketLayerIDs.at(indexedFeature.bucketID);
     if (filterLayerIDs && !vectorsIntersect(layerIDs, *filterLayerIDs)) {
         return;
     }
 
-    auto sourceLayer = geometryTileData.getLayer(indexedFeature.sourceLayerName);
+    auto sourceLayer = geometryTileData->getLayer(sourceLayerNames.at(indexedFeature.sourceLayerID));
     assert(sourceLayer);
 
-    auto geometryTileFeature = sourceLayer->getFeature(indexedFeature.index);
+    std::unique_ptr<const GeometryTileFeature> geometryTileFeature = sourceLayer->getFeature(indexedFeature.index);
     assert(geometryTileFeature);
 
+    // Features matched by several layers share the same tile feature, which is handed over to
+    // the result once the first layer matches.
+    const GeometryTileFeature& tileFeature = *geometryTileFeature;
+    std::shared_ptr<const LazyFeature::Impl> feature;
+
     for (const auto& layerID : layerIDs) {
         if (filterLayerIDs && !vectorContains(*filterLayerIDs, layerID)) {
             continue;
         }
 
-        auto styleLayer = style.getLayer(layerID);
-        if (!styleLayer ||
-            (!styleLayer->is<style::SymbolLayer>() &&
-             !styleLayer->baseImpl->queryIntersectsGeometry(queryGeometry, geometryTileFeature->getGeometries(), bearing, pixelsToTileUnits))) {
+        auto it = queryLayers.layers.find(layerID);
+        if (it == queryLayers.layers.end()) {
             continue;
         }
 
-        result[layerID].push_back(convertFeature(*geometryTileFeature, tileID));
+        const style::Layer* styleLayer = it->second;
+        if (!styleLayer->is<style::SymbolLayer>() &&
+            !styleLayer->baseImpl->queryIntersectsGeometry(queryGeometry, tileFeature.getGeometries(), bearing, pixelsToTileUnits)) {
+            continue;
+        }
+
+        if (!feature) {
+            feature = std::make_shared<const LazyFeature::Impl>(geometryTileData, std::move(geometryTileFeature), tileID);
+        }
+
+        result[layerID].emplace_back(feature);
     }
 }
 
@@ -151,8 +177,4 @@ optional<GeometryCoordinates> FeatureIndex::translateQueryGeometry(
     return translated;
 }
 
-void FeatureIndex::setBucketLayerIDs(const std::string& bucketName, const std::vector<std::string>& layerIDs) {
-    bucketLayerIDs[bucketName] = layerIDs;
-}
-
 } // namespace mbgl
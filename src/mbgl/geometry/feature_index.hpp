@@ -4,7 +4,10 @@
 #include <mbgl/tile/geometry_tile_data.hpp>
 #include <mbgl/util/grid_index.hpp>
 #include <mbgl/util/feature.hpp>
+#include <mbgl/util/lazy_feature.hpp>
 
+#include <cstdint>
+#include <memory>
 #include <vector>
 #include <string>
 #include <unordered_map>
@@ -12,7 +15,7 @@
 namespace mbgl {
 
 namespace style {
-class Style;
+class Layer;
 } // namespace style
 
 class CollisionTile;
@@ -22,27 +25,41 @@ class IndexedSubfeature {
 public:
     IndexedSubfeature() = delete;
     std::size_t index;
-    std::string sourceLayerName;
-    std::string bucketName;
+    // IDs of the source layer name and bucket, as interned by the tile's FeatureIndex.
+    uint32_t sourceLayerID;
+    uint32_t bucketID;
     size_t sortIndex;
 };
 
+// The style layers that a query matches features against, by ID, and the distance by which
+// the widest of them extends features beyond their geometry.
+class QueryLayers {
+public:
+    std::unordered_map<std::string, const style::Layer*> layers;
+    float radius = 0;
+};
+
 class FeatureIndex {
 public:
     FeatureIndex();
 
-    void insert(const GeometryCollection&, std::size_t index, const std::string& sourceLayerName, const std::string& bucketName);
+    // Indexed features refer to source layers and buckets by these IDs, and are resolved to
+    // names only when query results are built.
+    uint32_t getSourceLayerID(const std::string& sourceLayerName);
+    uint32_t addBucket(const std::vector<std::string>& layerIDs);
+
+    void insert(const GeometryCollection&, std::size_t index, uint32_t sourceLayerID, uint32_t bucketID);
 
     void query(
-            std::unordered_map<std::string, std::vector<Feature>>& result,
+            std::unordered_map<std::string, std::vector<LazyFeature>>& result,
             const GeometryCoordinates& queryGeometry,
             const float bearing,
             const double tileSize,
             const double scale,
             const optional<std::vector<std::string>>& layerIDs,
-            const GeometryTileData&,
+            const std::shared_ptr<const GeometryTileData>&,
             const CanonicalTileID&,
-            const style::Style&,
+            const QueryLayers&,
             const CollisionTile*) const;
 
     static optional<GeometryCoordinates> translateQueryGeometry(
@@ -52,23 +69,25 @@ public:
             const float bearing,
             const float pixelsToTileUnits);
 
-    void setBucketLayerIDs(const std::string& bucketName, const std::vector<std::string>& layerIDs);
-
 private:
     void addFeature(
-            std::unordered_map<std::string, std::vector<Feature>>& result,
+            std::unordered_map<std::string, std::vector<LazyFeature>>& result,
             const IndexedSubfeature&,
             const GeometryCoordinates& queryGeometry,
             const optional<std::vector<std::string>>& filterLayerIDs,
-            const GeometryTileData&,
+            const std::shared_ptr<const GeometryTileData>&,
             const CanonicalTileID&,
-            const style::Style&,
+            const QueryLayers&,
             const float bearing,
             const float pixelsToTileUnits) const;
 
     GridIndex<IndexedSubfeature> grid;
     unsigned int sortIndex = 0;
 
-    std::unordered_map<std::string, std::vector<std::string>> bucketLayerIDs;
+    std::vector<std::string> sourceLayerNames;
+    std::unordered_map<std::string, uint32_t> sourceLayerIDs;
+
+    // The style layers that share each bucket, indexed by bucket ID.
+    std::vector<std::vector<std::string>> bucketLayerIDs;
 };
 } // namespace mbgl
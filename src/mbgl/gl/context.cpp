@@ -302,6 +302,18 @@ void Context::updateTexture(
                                   data));
 }
 
+void Context::updateTextureRows(TextureID id,
+                                const uint32_t width,
+                                const Range<uint32_t> rows,
+                                const void* data,
+                                TextureFormat format,
+                                TextureUnit unit) {
+    activeTexture = unit;
+    texture[unit] = id;
+    MBGL_CHECK_ERROR(glTexSubImage2D(GL_TEXTURE_2D, 0, 0, rows.min, width, rows.max - rows.min,
+                                     static_cast<GLenum>(format), GL_UNSIGNED_BYTE, data));
+}
+
 void Context::bindTexture(Texture& obj,
                           TextureUnit unit,
                           TextureFilter filter,
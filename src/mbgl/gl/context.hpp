@@ -14,8 +14,10 @@
 #include <mbgl/gl/stencil_mode.hpp>
 #include <mbgl/gl/color_mode.hpp>
 #include <mbgl/util/noncopyable.hpp>
+#include <mbgl/util/range.hpp>
 
 
+#include <cassert>
 #include <functional>
 #include <memory>
 #include <vector>
@@ -42,7 +44,7 @@ public:
     UniqueVertexArray createVertexArray();
 
     template <class Vertex, class DrawMode>
-    VertexBuffer<Vertex, DrawMode> createVertexBuffer(VertexVector<Vertex, DrawMode>&& v) {
+    VertexBuffer<Vertex, DrawMode> createVertexBuffer(const VertexVector<Vertex, DrawMode>& v) {
         return VertexBuffer<Vertex, DrawMode> {
             v.vertexSize(),
             createVertexBuffer(v.data(), v.byteSize())
@@ -101,6 +103,17 @@ public:
         obj.size = image.size;
     }
 
+    // Uploads only the rows [rows.min, rows.max) of an image to a texture that was created
+    // from an image of the same size.
+    template <typename Image>
+    void updateTextureRows(Texture& obj, const Image& image, Range<uint32_t> rows, TextureUnit unit = 0) {
+        assert(obj.size == image.size);
+        assert(rows.min < rows.max && rows.max <= image.size.height);
+        auto format = image.channels == 4 ? TextureFormat::RGBA : TextureFormat::Alpha;
+        updateTextureRows(obj.texture.get(), image.size.width, rows,
+                          image.data.get() + image.size.width * image.channels * rows.min, format, unit);
+    }
+
     // Creates an empty texture with the specified dimensions.
     Texture createTexture(const Size size,
                           TextureFormat format = TextureFormat::RGBA,
@@ -198,6 +211,7 @@ private:
     UniqueBuffer createIndexBuffer(const void* data, std::size_t size);
     UniqueTexture createTexture(Size size, const void* data, TextureFormat, TextureUnit);
     void updateTexture(TextureID, Size size, const void* data, TextureFormat, TextureUnit);
+    void updateTextureRows(TextureID, uint32_t width, Range<uint32_t> rows, const void* data, TextureFormat, TextureUnit);
     UniqueFramebuffer createFramebuffer();
     UniqueRenderbuffer createRenderbuffer(RenderbufferType, Size size);
     std::unique_ptr<uint8_t[]> readFramebuffer(Size, TextureFormat, bool flip);
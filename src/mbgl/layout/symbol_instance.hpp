@@ -26,6 +26,10 @@ public:
     SymbolQuads iconQuads;
     CollisionFeature textCollisionFeature;
     CollisionFeature iconCollisionFeature;
+
+    // Where the glyph and icon quads start in the quad vertices of the layout.
+    std::size_t textVertexOffset = 0;
+    std::size_t iconVertexOffset = 0;
 };
 
 } // namespace mbgl
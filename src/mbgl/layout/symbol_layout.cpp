@@ -25,6 +25,8 @@
 
 #include <mapbox/polylabel.hpp>
 
+#include <numeric>
+
 namespace mbgl {
 
 using namespace style;
@@ -32,9 +34,11 @@ using namespace style;
 SymbolLayout::SymbolLayout(const BucketParameters& parameters,
                            const std::vector<const Layer*>& layers,
                            const GeometryTileLayer& sourceLayer,
+                           uint32_t sourceLayerID_,
+                           uint32_t bucketID_,
                            SpriteAtlas& spriteAtlas_)
-    : sourceLayerName(sourceLayer.getName()),
-      bucketName(layers.at(0)->getID()),
+    : sourceLayerID(sourceLayerID_),
+      bucketID(bucketID_),
       overscaling(parameters.tileID.overscaleFactor()),
       zoom(parameters.tileID.overscaledZ),
       mode(parameters.mode),
@@ -204,7 +208,9 @@ void SymbolLayout::prepare(uintptr_t tileUID,
         layout.get<TextJustify>() == TextJustifyType::Left ? 0 :
         0.5;
 
-    auto glyphSet = glyphAtlas.getGlyphSet(layout.get<TextFont>());
+    const FontStack& fontStack = layout.get<TextFont>();
+    auto glyphSet = glyphAtlas.getGlyphSet(fontStack);
+    ShapingCache& shapingCache = glyphAtlas.getShapingCache();
 
     for (const auto& feature : features) {
         if (feature.geometry.empty()) continue;
@@ -215,8 +221,9 @@ void SymbolLayout::prepare(uintptr_t tileUID,
 
         // if feature has text, shape the text
         if (feature.text) {
-            shapedText = glyphSet->getShaping(
-                /* string */ *feature.text,
+            ShapingKey key {
+                /* text */ *feature.text,
+                /* fontStack */ fontStack,
                 /* maxWidth: ems */ layout.get<SymbolPlacement>() != SymbolPlacementType::Line ?
                     layout.get<TextMaxWidth>() * 24 : 0,
                 /* lineHeight: ems */ layout.get<TextLineHeight>() * 24,
@@ -224,12 +231,22 @@ void SymbolLayout::prepare(uintptr_t tileUID,
                 /* verticalAlign */ verticalAlign,
                 /* justify */ justify,
                 /* spacing: ems */ layout.get<TextLetterSpacing>() * 24,
-                /* translate */ Point<float>(layout.get<TextOffset>()[0], layout.get<TextOffset>()[1]),
-                /* bidirectional algorithm object */ bidi);
+                /* translate */ Point<float>(layout.get<TextOffset>()[0], layout.get<TextOffset>()[1])
+            };
+
+            if (optional<Shaping> cached = shapingCache.get(key)) {
+                shapedText = std::move(*cached);
+            } else {
+                shapedText = glyphSet->getShaping(key.text, key.maxWidth, key.lineHeight,
+                                                  key.horizontalAlign, key.verticalAlign,
+                                                  key.justify, key.spacing, key.translate,
+                                                  /* bidirectional algorithm object */ bidi);
+                shapingCache.add(std::move(key), shapedText);
+            }
 
             // Add the glyphs we need for this label to the glyph atlas.
             if (shapedText) {
-                glyphAtlas.addGlyphs(tileUID, *feature.text, layout.get<TextFont>(), **glyphSet, face);
+                glyphAtlas.addGlyphs(tileUID, *feature.text, fontStack, **glyphSet, face);
             }
         }
 
@@ -282,7 +299,7 @@ void SymbolLayout::addFeature(const SymbolFeature& feature,
                                                   ? SymbolPlacementType::Point
                                                   : layout.get<SymbolPlacement>();
     const float textRepeatDistance = symbolSpacing / 2;
-    IndexedSubfeature indexedFeature = {feature.index, sourceLayerName, bucketName, symbolInstances.size()};
+    IndexedSubfeature indexedFeature = {feature.index, sourceLayerID, bucketID, symbolInstances.size()};
 
     auto addSymbolInstance = [&] (const GeometryCoordinates& line, Anchor& anchor) {
         // https://github.com/mapbox/vector-tile-spec/tree/master/2.1#41-layers
@@ -380,6 +397,24 @@ bool SymbolLayout::anchorIsTooClose(const std::u16string& text, const float repe
 std::unique_ptr<SymbolBucket> SymbolLayout::place(CollisionTile& collisionTile) {
     auto bucket = std::make_unique<SymbolBucket>(layout, layerPaintProperties, zoom, sdfIcons, iconsNeedLinear);
 
+    // The quads themselves don't depend on placement, so their vertices are generated once and
+    // shared by every bucket placed from this layout.
+    if (!textQuadVertices) {
+        auto textVertices = std::make_shared<SymbolQuadVertices>();
+        auto iconVertices = std::make_shared<SymbolQuadVertices>();
+        for (SymbolInstance &symbolInstance : symbolInstances) {
+            symbolInstance.textVertexOffset = textVertices->vertices.vertexSize();
+            addQuadVertices(*textVertices, symbolInstance.glyphQuads);
+            symbolInstance.iconVertexOffset = iconVertices->vertices.vertexSize();
+            addQuadVertices(*iconVertices, symbolInstance.iconQuads);
+        }
+        textQuadVertices = std::move(textVertices);
+        iconQuadVertices = std::move(iconVertices);
+    }
+
+    bucket->text.quadVertices = textQuadVertices;
+    bucket->icon.quadVertices = iconQuadVertices;
+
     // Calculate which labels can be shown and when they can be shown and
     // create the bufers used for rendering.
 
@@ -397,11 +432,18 @@ std::unique_ptr<SymbolBucket> SymbolLayout::place(CollisionTile& collisionTile)
     // are drawn on top of higher symbols.
     // Don't sort symbols that won't overlap because it isn't necessary and
     // because it causes more labels to pop in and out when rotating.
+    // Instances keep their order, which is that of their quad vertices; only the order in which
+    // they are placed and drawn changes.
+    std::vector<std::size_t> order(symbolInstances.size());
+    std::iota(order.begin(), order.end(), 0);
+
     if (mayOverlap) {
         const float sin = std::sin(collisionTile.config.angle);
         const float cos = std::cos(collisionTile.config.angle);
 
-        std::sort(symbolInstances.begin(), symbolInstances.end(), [sin, cos](SymbolInstance &a, SymbolInstance &b) {
+        std::sort(order.begin(), order.end(), [&](std::size_t i, std::size_t j) {
+            const SymbolInstance& a = symbolInstances[i];
+            const SymbolInstance& b = symbolInstances[j];
             const int32_t aRotated = sin * a.point.x + cos * a.point.y;
             const int32_t bRotated = sin * b.point.x + cos * b.point.y;
             return aRotated != bRotated ?
@@ -410,7 +452,12 @@ std::unique_ptr<SymbolBucket> SymbolLayout::place(CollisionTile& collisionTile)
         });
     }
 
-    for (SymbolInstance &symbolInstance : symbolInstances) {
+    // The scales at which each instance's text and icon can be shown.
+    std::vector<float> glyphScales(symbolInstances.size());
+    std::vector<float> iconScales(symbolInstances.size());
+
+    for (std::size_t i : order) {
+        SymbolInstance &symbolInstance = symbolInstances[i];
 
         const bool hasText = symbolInstance.hasText;
         const bool hasIcon = symbolInstance.hasIcon;
@@ -441,25 +488,44 @@ std::unique_ptr<SymbolBucket> SymbolLayout::place(CollisionTile& collisionTile)
         }
 
 
-        // Insert final placement into collision tree and add glyphs/icons to buffers
+        // Insert final placement into collision tree
 
         if (hasText) {
             collisionTile.insertFeature(symbolInstance.textCollisionFeature, glyphScale, layout.get<TextIgnorePlacement>());
-            if (glyphScale < collisionTile.maxScale) {
-                addSymbols(
-                    bucket->text, symbolInstance.glyphQuads, glyphScale,
-                    layout.get<TextKeepUpright>(), textPlacement, collisionTile.config.angle);
-            }
         }
 
         if (hasIcon) {
             collisionTile.insertFeature(symbolInstance.iconCollisionFeature, iconScale, layout.get<IconIgnorePlacement>());
-            if (iconScale < collisionTile.maxScale) {
-                addSymbols(
-                    bucket->icon, symbolInstance.iconQuads, iconScale,
-                    layout.get<IconKeepUpright>(), iconPlacement, collisionTile.config.angle);
-            }
         }
+
+        glyphScales[i] = glyphScale;
+        iconScales[i] = iconScale;
+    }
+
+    // Add the placement of every quad, in the order of the quad vertices, and then the triangles of
+    // the quads that are shown, in drawing order.
+
+    std::vector<bool> placedGlyphs;
+    std::vector<bool> placedIcons;
+
+    for (std::size_t i = 0; i < symbolInstances.size(); i++) {
+        const SymbolInstance &symbolInstance = symbolInstances[i];
+
+        addPlacementVertices(
+            bucket->text, placedGlyphs, symbolInstance.glyphQuads,
+            symbolInstance.hasText && glyphScales[i] < collisionTile.maxScale, glyphScales[i],
+            layout.get<TextKeepUpright>(), textPlacement, collisionTile.config.angle);
+
+        addPlacementVertices(
+            bucket->icon, placedIcons, symbolInstance.iconQuads,
+            symbolInstance.hasIcon && iconScales[i] < collisionTile.maxScale, iconScales[i],
+            layout.get<IconKeepUpright>(), iconPlacement, collisionTile.config.angle);
+    }
+
+    for (std::size_t i : order) {
+        const SymbolInstance &symbolInstance = symbolInstances[i];
+        addTriangles(bucket->text, placedGlyphs, symbolInstance.textVertexOffset, symbolInstance.glyphQuads.size());
+        addTriangles(bucket->icon, placedIcons, symbolInstance.iconVertexOffset, symbolInstance.iconQuads.size());
     }
 
     if (collisionTile.config.debug) {
@@ -469,31 +535,45 @@ std::unique_ptr<SymbolBucket> SymbolLayout::place(CollisionTile& collisionTile)
     return bucket;
 }
 
-template <typename Buffer>
-void SymbolLayout::addSymbols(Buffer &buffer, const SymbolQuads &symbols, float scale, const bool keepUpright, const style::SymbolPlacementType placement, const float placementAngle) {
-    constexpr const uint16_t vertexLength = 4;
-    const float placementZoom = util::max(util::log2(scale) + zoom, 0.0f);
-
+void SymbolLayout::addQuadVertices(SymbolQuadVertices& quadVertices, const SymbolQuads& symbols) {
     for (const auto& symbol : symbols) {
         const auto &tl = symbol.tl;
         const auto &tr = symbol.tr;
         const auto &bl = symbol.bl;
         const auto &br = symbol.br;
         const auto &tex = symbol.tex;
+        const auto &anchorPoint = symbol.anchorPoint;
+
+        quadVertices.vertices.emplace_back(SymbolQuadAttributes::vertex(anchorPoint, tl, tex.x, tex.y));
+        quadVertices.vertices.emplace_back(SymbolQuadAttributes::vertex(anchorPoint, tr, tex.x + tex.w, tex.y));
+        quadVertices.vertices.emplace_back(SymbolQuadAttributes::vertex(anchorPoint, bl, tex.x, tex.y + tex.h));
+        quadVertices.vertices.emplace_back(SymbolQuadAttributes::vertex(anchorPoint, br, tex.x + tex.w, tex.y + tex.h));
+    }
+}
+
+template <typename Buffer>
+void SymbolLayout::addPlacementVertices(Buffer &buffer, std::vector<bool>& placedQuads, const SymbolQuads &symbols,
+                                        const bool placed, float scale, const bool keepUpright,
+                                        const style::SymbolPlacementType placement, const float placementAngle) {
+    const float placementZoom = util::max(util::log2(scale) + zoom, 0.0f);
 
+    for (const auto& symbol : symbols) {
         float minZoom = util::max(zoom + util::log2(symbol.minScale), placementZoom);
         float maxZoom = util::min(zoom + util::log2(symbol.maxScale), util::MAX_ZOOM_F);
-        const auto &anchorPoint = symbol.anchorPoint;
 
         // drop upside down versions of glyphs
         const float a = std::fmod(symbol.anchorAngle + placementAngle + M_PI, M_PI * 2);
-        if (keepUpright && placement == style::SymbolPlacementType::Line &&
-            (a <= M_PI / 2 || a > M_PI * 3 / 2)) {
-            continue;
-        }
+        const bool upsideDown = keepUpright && placement == style::SymbolPlacementType::Line &&
+            (a <= M_PI / 2 || a > M_PI * 3 / 2);
 
-        if (maxZoom <= minZoom)
+        if (!placed || upsideDown || maxZoom <= minZoom) {
+            const auto hidden = SymbolPlacementAttributes::vertex(0, 0, 0, 0);
+            for (std::size_t i = 0; i < 4; i++) {
+                buffer.placementVertices.emplace_back(hidden);
+            }
+            placedQuads.push_back(false);
             continue;
+        }
 
         // Lower min zoom so that while fading out the label
         // it can be shown outside of collision-free zoom levels
@@ -501,34 +581,40 @@ void SymbolLayout::addSymbols(Buffer &buffer, const SymbolQuads &symbols, float
             minZoom = 0;
         }
 
-        if (buffer.segments.empty() || buffer.segments.back().vertexLength + vertexLength > std::numeric_limits<uint16_t>::max()) {
-            buffer.segments.emplace_back(buffer.vertices.vertexSize(), buffer.triangles.indexSize());
+        // Encode angle of glyph
+        uint8_t glyphAngle = std::round((symbol.glyphAngle / (M_PI * 2)) * 256);
+
+        const auto vertex = SymbolPlacementAttributes::vertex(minZoom, maxZoom, placementZoom, glyphAngle);
+        for (std::size_t i = 0; i < 4; i++) {
+            buffer.placementVertices.emplace_back(vertex);
         }
+        placedQuads.push_back(true);
+    }
+}
 
-        // We're generating triangle fans, so we always start with the first
-        // coordinate in this polygon.
-        auto& segment = buffer.segments.back();
-        assert(segment.vertexLength <= std::numeric_limits<uint16_t>::max());
-        uint16_t index = segment.vertexLength;
+template <typename Buffer>
+void SymbolLayout::addTriangles(Buffer &buffer, const std::vector<bool>& placedQuads,
+                                std::size_t vertexOffset, std::size_t quadCount) {
+    const std::size_t vertexCount = buffer.quadVertices->vertices.vertexSize();
 
-        // Encode angle of glyph
-        uint8_t glyphAngle = std::round((symbol.glyphAngle / (M_PI * 2)) * 256);
+    for (std::size_t vertex = vertexOffset; vertex < vertexOffset + quadCount * 4; vertex += 4) {
+        if (!placedQuads[vertex / 4]) {
+            continue;
+        }
+
+        const std::size_t segmentOffset = vertex - vertex % SymbolQuadVertices::segmentSize;
+        if (buffer.segments.empty() || buffer.segments.back().vertexOffset != segmentOffset) {
+            buffer.segments.emplace_back(segmentOffset, buffer.triangles.indexSize(),
+                std::min(vertexCount - segmentOffset, SymbolQuadVertices::segmentSize));
+        }
+
+        auto& segment = buffer.segments.back();
+        const uint16_t index = vertex - segmentOffset;
 
-        // coordinates (2 triangles)
-        buffer.vertices.emplace_back(SymbolLayoutAttributes::vertex(anchorPoint, tl, tex.x, tex.y,
-                            minZoom, maxZoom, placementZoom, glyphAngle));
-        buffer.vertices.emplace_back(SymbolLayoutAttributes::vertex(anchorPoint, tr, tex.x + tex.w, tex.y,
-                            minZoom, maxZoom, placementZoom, glyphAngle));
-        buffer.vertices.emplace_back(SymbolLayoutAttributes::vertex(anchorPoint, bl, tex.x, tex.y + tex.h,
-                            minZoom, maxZoom, placementZoom, glyphAngle));
-        buffer.vertices.emplace_back(SymbolLayoutAttributes::vertex(anchorPoint, br, tex.x + tex.w, tex.y + tex.h,
-                            minZoom, maxZoom, placementZoom, glyphAngle));
-
-        // add the two triangles, referencing the four coordinates we just inserted.
+        // add the two triangles, referencing the four coordinates of the quad.
         buffer.triangles.emplace_back(index + 0, index + 1, index + 2);
         buffer.triangles.emplace_back(index + 1, index + 2, index + 3);
 
-        segment.vertexLength += vertexLength;
         segment.indexLength += 6;
     }
 }
@@ -18,6 +18,7 @@ class CollisionTile;
 class SpriteAtlas;
 class GlyphAtlas;
 class SymbolBucket;
+class SymbolQuadVertices;
 
 namespace style {
 class BucketParameters;
@@ -32,6 +33,8 @@ public:
     SymbolLayout(const style::BucketParameters&,
                  const std::vector<const style::Layer*>&,
                  const GeometryTileLayer&,
+                 uint32_t sourceLayerID,
+                 uint32_t bucketID,
                  SpriteAtlas&);
 
     bool canPrepare(GlyphAtlas&);
@@ -64,13 +67,21 @@ private:
 
     void addToDebugBuffers(CollisionTile&, SymbolBucket&);
 
-    // Adds placed items to the buffer.
+    void addQuadVertices(SymbolQuadVertices&, const SymbolQuads&);
+
+    // Adds the placement of each quad to the buffer, and whether it is shown to placedQuads.
+    template <typename Buffer>
+    void addPlacementVertices(Buffer&, std::vector<bool>& placedQuads, const SymbolQuads&,
+                              const bool placed, float scale, const bool keepUpright,
+                              const style::SymbolPlacementType, const float placementAngle);
+
+    // Adds the triangles of the shown quads among those starting at vertexOffset.
     template <typename Buffer>
-    void addSymbols(Buffer&, const SymbolQuads&, float scale,
-                    const bool keepUpright, const style::SymbolPlacementType, const float placementAngle);
+    void addTriangles(Buffer&, const std::vector<bool>& placedQuads,
+                      std::size_t vertexOffset, std::size_t quadCount);
 
-    const std::string sourceLayerName;
-    const std::string bucketName;
+    const uint32_t sourceLayerID;
+    const uint32_t bucketID;
     const float overscaling;
     const float zoom;
     const MapMode mode;
@@ -90,6 +101,9 @@ private:
     std::vector<SymbolInstance> symbolInstances;
     std::vector<SymbolFeature> features;
 
+    std::shared_ptr<const SymbolQuadVertices> textQuadVertices;
+    std::shared_ptr<const SymbolQuadVertices> iconQuadVertices;
+
     BiDi bidi; // Consider moving this up to geometry tile worker to reduce reinstantiation costs; use of BiDi/ubiditransform object must be constrained to one thread
 };
 
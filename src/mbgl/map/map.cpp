@@ -6,12 +6,15 @@
 #include <mbgl/map/transform_state.hpp>
 #include <mbgl/annotation/annotation_manager.hpp>
 #include <mbgl/style/style.hpp>
+#include <mbgl/style/binary_style.hpp>
 #include <mbgl/style/source.hpp>
 #include <mbgl/style/layer.hpp>
 #include <mbgl/style/observer.hpp>
 #include <mbgl/style/transition_options.hpp>
 #include <mbgl/style/update_parameters.hpp>
 #include <mbgl/style/query_parameters.hpp>
+#include <mbgl/style/rendered_query.hpp>
+#include <mbgl/style/source_query.hpp>
 #include <mbgl/renderer/painter.hpp>
 #include <mbgl/storage/file_source.hpp>
 #include <mbgl/storage/resource.hpp>
@@ -91,6 +94,7 @@ public:
 
     std::string styleURL;
     std::string styleJSON;
+    std::string styleBinary;
     bool styleMutated = false;
     bool cameraMutated = false;
 
@@ -346,9 +350,10 @@ void Map::setStyleURL(const std::string& url) {
     impl->styleRequest = nullptr;
     impl->styleURL = url;
     impl->styleJSON.clear();
+    impl->styleBinary.clear();
     impl->styleMutated = false;
 
-    impl->style = std::make_unique<Style>(impl->fileSource, impl->pixelRatio);
+    impl->style = std::make_unique<Style>(impl->scheduler, impl->fileSource, impl->pixelRatio);
 
     impl->styleRequest = impl->fileSource.request(Resource::style(impl->styleURL), [this](Response res) {
         // Once we get a fresh style, or the style is mutated, stop revalidating.
@@ -373,7 +378,10 @@ void Map::setStyleURL(const std::string& url) {
         } else if (res.notModified || res.noContent) {
             return;
         } else {
-            impl->loadStyleJSON(*res.data);
+            // Build the style on the worker; it's applied once parsing completes.
+            impl->style->setObserver(impl.get());
+            impl->styleJSON = *res.data;
+            impl->style->setJSONAsync(*res.data);
         }
     });
 }
@@ -389,30 +397,47 @@ void Map::setStyleJSON(const std::string& json) {
 
     impl->styleURL.clear();
     impl->styleJSON.clear();
+    impl->styleBinary.clear();
     impl->styleMutated = false;
 
-    impl->style = std::make_unique<Style>(impl->fileSource, impl->pixelRatio);
+    // Replacing a loaded style keeps whatever sources and layers the new one leaves unchanged.
+    if (!impl->style || !impl->style->loaded) {
+        impl->style = std::make_unique<Style>(impl->scheduler, impl->fileSource, impl->pixelRatio);
+    }
 
+    impl->styleRequest = nullptr;
     impl->loadStyleJSON(json);
 }
 
-void Map::Impl::loadStyleJSON(const std::string& json) {
-    style->setObserver(this);
-    style->setJSON(json);
-    styleJSON = json;
+void Map::setStyleBinary(const std::string& binary) {
+    if (impl->styleBinary == binary) {
+        return;
+    }
 
-    // force style cascade, causing all pending transitions to complete.
-    style->cascade(Clock::now(), mode);
+    impl->loading = true;
 
-    if (!cameraMutated) {
-        // Zoom first because it may constrain subsequent operations.
-        map.setZoom(map.getDefaultZoom());
-        map.setLatLng(map.getDefaultLatLng());
-        map.setBearing(map.getDefaultBearing());
-        map.setPitch(map.getDefaultPitch());
+    impl->backend.notifyMapChange(MapChangeWillStartLoadingMap);
+
+    impl->styleURL.clear();
+    impl->styleJSON.clear();
+    impl->styleBinary.clear();
+    impl->styleMutated = false;
+
+    // Replacing a loaded style keeps whatever sources and layers the new one leaves unchanged.
+    if (!impl->style || !impl->style->loaded) {
+        impl->style = std::make_unique<Style>(impl->scheduler, impl->fileSource, impl->pixelRatio);
     }
 
-    onUpdate(Update::Classes | Update::RecalculateStyle | Update::AnnotationStyle);
+    impl->styleRequest = nullptr;
+    impl->style->setObserver(impl.get());
+    impl->style->setBinary(binary);
+    impl->styleBinary = binary;
+}
+
+void Map::Impl::loadStyleJSON(const std::string& json) {
+    style->setObserver(this);
+    style->setJSON(json);
+    styleJSON = json;
 }
 
 std::string Map::getStyleURL() const {
@@ -420,6 +445,14 @@ std::string Map::getStyleURL() const {
 }
 
 std::string Map::getStyleJSON() const {
+    // Binary styles are only converted back to JSON when asked for.
+    if (impl->styleJSON.empty() && !impl->styleBinary.empty()) {
+        try {
+            return style::decodeBinaryStyle(impl->styleBinary);
+        } catch (...) {
+            return {};
+        }
+    }
     return impl->styleJSON;
 }
 
@@ -829,14 +862,77 @@ std::vector<Feature> Map::queryRenderedFeatures(const ScreenBox& box, const opti
     });
 }
 
+std::vector<LazyFeature> Map::queryRenderedFeaturesLazy(const ScreenCoordinate& point, const optional<std::vector<std::string>>& layerIDs) {
+    if (!impl->style) return {};
+
+    return impl->style->queryRenderedFeaturesLazy({
+        { point },
+        impl->transform.getState(),
+        layerIDs
+    });
+}
+
+std::vector<LazyFeature> Map::queryRenderedFeaturesLazy(const ScreenBox& box, const optional<std::vector<std::string>>& layerIDs) {
+    if (!impl->style) return {};
+
+    return impl->style->queryRenderedFeaturesLazy({
+        {
+            box.min,
+            { box.max.x, box.min.y },
+            box.max,
+            { box.min.x, box.max.y },
+            box.min
+        },
+        impl->transform.getState(),
+        layerIDs
+    });
+}
+
+std::unique_ptr<AsyncRequest> Map::queryRenderedFeatures(const ScreenCoordinate& point, const optional<std::vector<std::string>>& layerIDs, RenderedFeaturesCallback callback) {
+    const ScreenLineString geometry { point };
+    const QueryParameters parameters { geometry, impl->transform.getState(), layerIDs };
+
+    if (!impl->style) {
+        return std::make_unique<RenderedQuery>(impl->scheduler, parameters, std::vector<std::unique_ptr<Layer>>(), std::vector<TileQuery>(), std::move(callback));
+    }
+
+    return impl->style->queryRenderedFeatures(parameters, std::move(callback));
+}
+
+std::unique_ptr<AsyncRequest> Map::queryRenderedFeatures(const ScreenBox& box, const optional<std::vector<std::string>>& layerIDs, RenderedFeaturesCallback callback) {
+    const ScreenLineString geometry {
+        box.min,
+        { box.max.x, box.min.y },
+        box.max,
+        { box.min.x, box.max.y },
+        box.min
+    };
+    const QueryParameters parameters { geometry, impl->transform.getState(), layerIDs };
+
+    if (!impl->style) {
+        return std::make_unique<RenderedQuery>(impl->scheduler, parameters, std::vector<std::unique_ptr<Layer>>(), std::vector<TileQuery>(), std::move(callback));
+    }
+
+    return impl->style->queryRenderedFeatures(parameters, std::move(callback));
+}
+
+std::unique_ptr<AsyncRequest> Map::querySourceFeatures(const std::string& sourceID, const SourceQueryOptions& options, SourceFeaturesCallback callback) {
+    if (!impl->style) {
+        return std::make_unique<SourceQuery>(impl->scheduler, options, std::vector<SourceTileQuery>(), std::move(callback));
+    }
+
+    return impl->style->querySourceFeatures(sourceID, options, std::move(callback));
+}
+
 AnnotationIDs Map::queryPointAnnotations(const ScreenBox& box) {
-    auto features = queryRenderedFeatures(box, {{ AnnotationManager::PointLayerID }});
+    auto features = queryRenderedFeaturesLazy(box, {{ AnnotationManager::PointLayerID }});
     std::set<AnnotationID> set;
     for (auto &feature : features) {
-        assert(feature.id);
-        assert(feature.id->is<uint64_t>());
-        assert(feature.id->get<uint64_t>() <= std::numeric_limits<AnnotationID>::max());
-        set.insert(static_cast<AnnotationID>(feature.id->get<uint64_t>()));
+        auto id = feature.getID();
+        assert(id);
+        assert(id->is<uint64_t>());
+        assert(id->get<uint64_t>() <= std::numeric_limits<AnnotationID>::max());
+        set.insert(static_cast<AnnotationID>(id->get<uint64_t>()));
     }
     AnnotationIDs ids;
     ids.reserve(set.size());
@@ -1092,6 +1188,19 @@ void Map::Impl::onUpdate(Update flags) {
 
 void Map::Impl::onStyleLoaded() {
     backend.notifyMapChange(MapChangeDidFinishLoadingStyle);
+
+    // force style cascade, causing all pending transitions to complete.
+    style->cascade(Clock::now(), mode);
+
+    if (!cameraMutated) {
+        // Zoom first because it may constrain subsequent operations.
+        map.setZoom(map.getDefaultZoom());
+        map.setLatLng(map.getDefaultLatLng());
+        map.setBearing(map.getDefaultBearing());
+        map.setPitch(map.getDefaultPitch());
+    }
+
+    onUpdate(Update::Classes | Update::RecalculateStyle | Update::Layout | Update::AnnotationStyle);
 }
 
 void Map::Impl::onStyleError() {
@@ -70,6 +70,34 @@ public:
               const PaintPropertyBinders& paintPropertyBinders,
               const typename PaintProperties::Evaluated& currentProperties,
               float currentZoom) {
+        draw(context,
+             std::move(drawMode),
+             std::move(depthMode),
+             std::move(stencilMode),
+             std::move(colorMode),
+             std::move(uniformValues),
+             LayoutAttributes::allVariableBindings(layoutVertexBuffer),
+             indexBuffer,
+             segments,
+             paintPropertyBinders,
+             currentProperties,
+             currentZoom);
+    }
+
+    // For layout attributes that are spread over more than one vertex buffer.
+    template <class DrawMode>
+    void draw(gl::Context& context,
+              DrawMode drawMode,
+              gl::DepthMode depthMode,
+              gl::StencilMode stencilMode,
+              gl::ColorMode colorMode,
+              UniformValues&& uniformValues,
+              const typename LayoutAttributes::Bindings& layoutBindings,
+              const gl::IndexBuffer<DrawMode>& indexBuffer,
+              const gl::SegmentVector<Attributes>& segments,
+              const PaintPropertyBinders& paintPropertyBinders,
+              const typename PaintProperties::Evaluated& currentProperties,
+              float currentZoom) {
         program.draw(
             context,
             std::move(drawMode),
@@ -78,7 +106,7 @@ public:
             std::move(colorMode),
             uniformValues
                 .concat(paintPropertyBinders.uniformValues(currentZoom)),
-            LayoutAttributes::allVariableBindings(layoutVertexBuffer)
+            layoutBindings
                 .concat(paintPropertyBinders.attributeBindings(currentProperties)),
             indexBuffer,
             segments
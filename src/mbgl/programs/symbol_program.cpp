@@ -7,7 +7,8 @@ namespace mbgl {
 
 using namespace style;
 
-static_assert(sizeof(SymbolLayoutVertex) == 16, "expected SymbolLayoutVertex size");
+static_assert(sizeof(SymbolQuadVertex) == 12, "expected SymbolQuadVertex size");
+static_assert(sizeof(SymbolPlacementVertex) == 4, "expected SymbolPlacementVertex size");
 
 template <class Values, class...Args>
 Values makeValues(const style::SymbolPropertyValues& values,
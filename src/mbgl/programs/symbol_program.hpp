@@ -32,20 +32,16 @@ MBGL_DEFINE_UNIFORM_SCALAR(float, u_gamma);
 MBGL_DEFINE_UNIFORM_SCALAR(float, u_aspect_ratio);
 } // namespace uniforms
 
-struct SymbolLayoutAttributes : gl::Attributes<
+// The corners of glyph and icon quads, which don't change when symbols are re-placed.
+struct SymbolQuadAttributes : gl::Attributes<
     attributes::a_pos,
     attributes::a_offset<2>,
-    attributes::a_texture_pos,
-    attributes::a_data<4>>
+    attributes::a_texture_pos>
 {
     static Vertex vertex(Point<float> a,
                          Point<float> o,
                          uint16_t tx,
-                         uint16_t ty,
-                         float minzoom,
-                         float maxzoom,
-                         float labelminzoom,
-                         uint8_t labelangle) {
+                         uint16_t ty) {
         return Vertex {
             {{
                 static_cast<int16_t>(a.x),
@@ -58,7 +54,21 @@ struct SymbolLayoutAttributes : gl::Attributes<
             {{
                 static_cast<uint16_t>(tx / 4),
                 static_cast<uint16_t>(ty / 4)
-            }},
+            }}
+        };
+    }
+};
+
+// The zoom range in which each quad is shown, which placement determines. These are kept in a
+// buffer of their own, parallel to the quad vertices, so that re-placing symbols only rewrites it.
+struct SymbolPlacementAttributes : gl::Attributes<
+    attributes::a_data<4>>
+{
+    static Vertex vertex(float minzoom,
+                         float maxzoom,
+                         float labelminzoom,
+                         uint8_t labelangle) {
+        return Vertex {
             {{
                 static_cast<uint8_t>(labelminzoom * 10), // 1/10 zoom levels: z16 == 160
                 static_cast<uint8_t>(labelangle),
@@ -69,6 +79,8 @@ struct SymbolLayoutAttributes : gl::Attributes<
     }
 };
 
+using SymbolLayoutAttributes = gl::ConcatenateAttributes<SymbolQuadAttributes, SymbolPlacementAttributes>;
+
 class SymbolIconProgram : public Program<
     shaders::symbol_icon,
     gl::Triangle,
@@ -134,7 +146,8 @@ public:
                                                  float pixelRatio);
 };
 
-using SymbolLayoutVertex = SymbolLayoutAttributes::Vertex;
+using SymbolQuadVertex = SymbolQuadAttributes::Vertex;
+using SymbolPlacementVertex = SymbolPlacementAttributes::Vertex;
 using SymbolAttributes = SymbolIconProgram::Attributes;
 
 } // namespace mbgl
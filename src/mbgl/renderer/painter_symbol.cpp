@@ -49,7 +49,8 @@ void Painter::renderSymbol(PaintParameters& parameters,
                 : gl::StencilMode::disabled(),
             colorModeForRenderPass(),
             std::move(uniformValues),
-            *buffers.vertexBuffer,
+            SymbolQuadAttributes::allVariableBindings(*buffers.vertexBuffer)
+                .concat(SymbolPlacementAttributes::allVariableBindings(*buffers.placementVertexBuffer)),
             *buffers.indexBuffer,
             buffers.segments,
             bucket.paintPropertyBinders.at(layer.getID()),
@@ -8,6 +8,20 @@ namespace mbgl {
 
 using namespace style;
 
+constexpr std::size_t SymbolQuadVertices::segmentSize;
+
+static void uploadSymbolBuffer(gl::Context& context, SymbolBucket::SymbolBuffer& buffer) {
+    buffer.vertexBuffer = buffer.quadVertices->vertexBuffer.lock();
+    if (!buffer.vertexBuffer) {
+        buffer.vertexBuffer = std::make_shared<gl::VertexBuffer<SymbolQuadVertex>>(
+            context.createVertexBuffer(buffer.quadVertices->vertices));
+        buffer.quadVertices->vertexBuffer = buffer.vertexBuffer;
+    }
+
+    buffer.placementVertexBuffer = context.createVertexBuffer(std::move(buffer.placementVertices));
+    buffer.indexBuffer = context.createIndexBuffer(std::move(buffer.triangles));
+}
+
 SymbolBucket::SymbolBucket(style::SymbolLayoutProperties::Evaluated layout_,
                            const std::unordered_map<std::string, style::SymbolPaintProperties::Evaluated>& layerPaintProperties,
                            float zoom,
@@ -24,13 +38,11 @@ SymbolBucket::SymbolBucket(style::SymbolLayoutProperties::Evaluated layout_,
 
 void SymbolBucket::upload(gl::Context& context) {
     if (hasTextData()) {
-        text.vertexBuffer = context.createVertexBuffer(std::move(text.vertices));
-        text.indexBuffer = context.createIndexBuffer(std::move(text.triangles));
+        uploadSymbolBuffer(context, text);
     }
 
     if (hasIconData()) {
-        icon.vertexBuffer = context.createVertexBuffer(std::move(icon.vertices));
-        icon.indexBuffer = context.createIndexBuffer(std::move(icon.triangles));
+        uploadSymbolBuffer(context, icon);
     }
 
     if (!collisionBox.vertices.empty()) {
@@ -10,10 +10,26 @@
 #include <mbgl/text/glyph_range.hpp>
 #include <mbgl/style/layers/symbol_layer_properties.hpp>
 
+#include <memory>
 #include <vector>
 
 namespace mbgl {
 
+// The vertices of a SymbolLayout's glyph or icon quads, which don't depend on placement. The
+// layout generates them once and shares them with every bucket it places. The first of those
+// buckets to be uploaded creates their vertex buffer, and later ones reuse it while it's alive.
+class SymbolQuadVertices {
+public:
+    // Segments of this many vertices are addressed with 16-bit indices. Quads never straddle two
+    // segments, since each one is a multiple of four vertices long.
+    static constexpr std::size_t segmentSize = 65532;
+
+    gl::VertexVector<SymbolQuadVertex> vertices;
+
+    // Only accessed on the render thread.
+    mutable std::weak_ptr<gl::VertexBuffer<SymbolQuadVertex>> vertexBuffer;
+};
+
 class SymbolBucket : public Bucket {
 public:
     SymbolBucket(style::SymbolLayoutProperties::Evaluated,
@@ -35,23 +51,21 @@ public:
 
     std::unordered_map<std::string, SymbolIconProgram::PaintPropertyBinders> paintPropertyBinders;
 
-    struct TextBuffer {
-        gl::VertexVector<SymbolLayoutVertex> vertices;
-        gl::IndexVector<gl::Triangles> triangles;
-        gl::SegmentVector<SymbolAttributes> segments;
+    struct SymbolBuffer {
+        std::shared_ptr<const SymbolQuadVertices> quadVertices;
 
-        optional<gl::VertexBuffer<SymbolLayoutVertex>> vertexBuffer;
-        optional<gl::IndexBuffer<gl::Triangles>> indexBuffer;
-    } text;
-
-    struct IconBuffer {
-        gl::VertexVector<SymbolLayoutVertex> vertices;
+        // One per quad vertex, including those of quads that aren't placed.
+        gl::VertexVector<SymbolPlacementVertex> placementVertices;
         gl::IndexVector<gl::Triangles> triangles;
         gl::SegmentVector<SymbolAttributes> segments;
 
-        optional<gl::VertexBuffer<SymbolLayoutVertex>> vertexBuffer;
+        std::shared_ptr<gl::VertexBuffer<SymbolQuadVertex>> vertexBuffer;
+        optional<gl::VertexBuffer<SymbolPlacementVertex>> placementVertexBuffer;
         optional<gl::IndexBuffer<gl::Triangles>> indexBuffer;
-    } icon;
+    };
+
+    SymbolBuffer text;
+    SymbolBuffer icon;
 
     struct CollisionBoxBuffer {
         gl::VertexVector<CollisionBoxVertex> vertices;
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <mbgl/storage/file_source.hpp>
+
+#include <mutex>
+#include <vector>
+
+namespace mbgl {
+
+namespace util {
+template <typename T> class Thread;
+} // namespace util
+
+/*
+ * Serves resources straight out of MBTiles files, addressed as mbtiles:///path/to/file.mbtiles.
+ *
+ * Requesting the file URL itself yields a TileJSON document built from the file's metadata
+ * table; it advertises tile URLs that are answered from the tiles table. Gzipped tiles are
+ * decompressed before they are handed back. Requests are spread over a small pool of
+ * threads, each holding its own read-only connection to every file it has served.
+ */
+class MBTilesFileSource : public FileSource {
+public:
+    MBTilesFileSource();
+    ~MBTilesFileSource() override;
+
+    std::unique_ptr<AsyncRequest> request(const Resource&, Callback) override;
+
+    static bool acceptsURL(const std::string& url);
+
+private:
+    class Impl;
+
+    util::Thread<Impl>& nextThread();
+
+    std::mutex mutex;
+    std::vector<std::unique_ptr<util::Thread<Impl>>> threads;
+    std::size_t nextIndex = 0;
+};
+
+} // namespace mbgl
@@ -0,0 +1,316 @@
+#include <mbgl/style/binary_style.hpp>
+#include <mbgl/style/binary_style_reader.hpp>
+
+#include <rapidjson/reader.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace mbgl {
+namespace style {
+
+// The encoding is a header, a string table, and a tree of tagged values:
+//
+//   header:   "MBSB" version
+//   strings:  count, then (length, bytes) for each distinct string or object key
+//   value:    Null | False | True
+//           | Uint n | NegativeInt n (encodes -n - 1) | Double (8 bytes, little-endian)
+//           | String index
+//           | Array value* End
+//           | Object (index + 1, value)* 0
+//
+// Counts, lengths, indices and integers are unsigned LEB128 varints.
+
+namespace {
+
+const char magic[] = { 'M', 'B', 'S', 'B' };
+const uint8_t version = 1;
+
+enum Tag : uint8_t {
+    Null,
+    False,
+    True,
+    Uint,
+    NegativeInt,
+    Double,
+    String,
+    Array,
+    Object,
+    End,
+};
+
+void writeVarint(std::string& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(char((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(char(value));
+}
+
+class Encoder : public rapidjson::BaseReaderHandler<rapidjson::UTF8<>, Encoder> {
+public:
+    bool Null() { return tag(Tag::Null); }
+    bool Bool(bool value) { return tag(value ? Tag::True : Tag::False); }
+    bool Int(int value) { return Int64(value); }
+    bool Uint(unsigned value) { return Uint64(value); }
+
+    bool Int64(int64_t value) {
+        if (value >= 0) {
+            return Uint64(uint64_t(value));
+        }
+        tag(Tag::NegativeInt);
+        writeVarint(tree, uint64_t(-(value + 1)));
+        return true;
+    }
+
+    bool Uint64(uint64_t value) {
+        tag(Tag::Uint);
+        writeVarint(tree, value);
+        return true;
+    }
+
+    bool Double(double value) {
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        tag(Tag::Double);
+        for (int i = 0; i < 8; i++) {
+            tree.push_back(char(bits >> (i * 8)));
+        }
+        return true;
+    }
+
+    bool String(const char* str, rapidjson::SizeType length, bool) {
+        tag(Tag::String);
+        writeVarint(tree, intern(str, length));
+        return true;
+    }
+
+    bool Key(const char* str, rapidjson::SizeType length, bool) {
+        writeVarint(tree, intern(str, length) + 1);
+        return true;
+    }
+
+    bool StartObject() { return tag(Tag::Object); }
+    bool EndObject(rapidjson::SizeType) { writeVarint(tree, 0); return true; }
+    bool StartArray() { return tag(Tag::Array); }
+    bool EndArray(rapidjson::SizeType) { return tag(Tag::End); }
+
+    std::string finish() const {
+        std::string result(magic, sizeof(magic));
+        result.push_back(char(version));
+        writeVarint(result, strings.size());
+        for (const auto& string : strings) {
+            writeVarint(result, string.size());
+            result.append(string);
+        }
+        return result + tree;
+    }
+
+private:
+    bool tag(uint8_t value) {
+        tree.push_back(char(value));
+        return true;
+    }
+
+    uint64_t intern(const char* str, rapidjson::SizeType length) {
+        auto result = indices.emplace(std::string(str, length), strings.size());
+        if (result.second) {
+            strings.push_back(result.first->first);
+        }
+        return result.first->second;
+    }
+
+    std::unordered_map<std::string, uint64_t> indices;
+    std::vector<std::string> strings;
+    std::string tree;
+};
+
+// Replays an encoded style as SAX events, so that it can populate a rapidjson document
+// or drive a writer.
+class Decoder {
+public:
+    Decoder(const std::string& data_)
+        : data(reinterpret_cast<const uint8_t*>(data_.data())),
+          end(data + data_.size()) {
+        if (data_.size() < sizeof(magic) + 1 || std::memcmp(data, magic, sizeof(magic)) != 0) {
+            fail("not a binary style");
+        }
+        data += sizeof(magic);
+
+        if (*data++ != version) {
+            fail("unsupported binary style version");
+        }
+
+        const uint64_t count = readVarint();
+        if (count > uint64_t(end - data)) {
+            fail("string table is truncated");
+        }
+        strings.reserve(count);
+        for (uint64_t i = 0; i < count; i++) {
+            const uint64_t length = readVarint();
+            if (length > uint64_t(end - data)) {
+                fail("string is truncated");
+            }
+            strings.emplace_back(reinterpret_cast<const char*>(data), rapidjson::SizeType(length));
+            data += length;
+        }
+    }
+
+    template <class Handler>
+    bool operator()(Handler& handler) {
+        // Element counts of the arrays and objects currently open, and whether each is an object.
+        std::vector<std::pair<rapidjson::SizeType, bool>> stack;
+
+        do {
+            if (!stack.empty() && stack.back().second) {
+                const uint64_t key = readVarint();
+                if (key == 0) {
+                    handler.EndObject(stack.back().first);
+                    stack.pop_back();
+                    continue;
+                }
+                const auto& string = lookup(key - 1);
+                handler.Key(string.first, string.second, true);
+            }
+
+            const uint8_t tag = readByte();
+            if (!stack.empty() && !stack.back().second && tag == Tag::End) {
+                handler.EndArray(stack.back().first);
+                stack.pop_back();
+                continue;
+            }
+
+            if (!stack.empty()) {
+                stack.back().first++;
+            }
+
+            switch (tag) {
+            case Tag::Null:
+                handler.Null();
+                break;
+            case Tag::False:
+                handler.Bool(false);
+                break;
+            case Tag::True:
+                handler.Bool(true);
+                break;
+            case Tag::Uint:
+                handler.Uint64(readVarint());
+                break;
+            case Tag::NegativeInt:
+                handler.Int64(-int64_t(readVarint()) - 1);
+                break;
+            case Tag::Double:
+                handler.Double(readDouble());
+                break;
+            case Tag::String: {
+                const auto& string = lookup(readVarint());
+                handler.String(string.first, string.second, true);
+                break;
+            }
+            case Tag::Array:
+                handler.StartArray();
+                stack.emplace_back(0, false);
+                break;
+            case Tag::Object:
+                handler.StartObject();
+                stack.emplace_back(0, true);
+                break;
+            default:
+                fail("unexpected tag");
+            }
+        } while (!stack.empty());
+
+        if (data != end) {
+            fail("unexpected data after the style");
+        }
+
+        return true;
+    }
+
+private:
+    [[noreturn]] void fail(const char* message) const {
+        throw std::runtime_error(std::string("Malformed binary style: ") + message);
+    }
+
+    uint8_t readByte() {
+        if (data == end) {
+            fail("unexpected end of data");
+        }
+        return *data++;
+    }
+
+    uint64_t readVarint() {
+        uint64_t result = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            const uint8_t byte = readByte();
+            result |= uint64_t(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) {
+                return result;
+            }
+        }
+        fail("varint is too long");
+    }
+
+    double readDouble() {
+        uint64_t bits = 0;
+        for (int i = 0; i < 8; i++) {
+            bits |= uint64_t(readByte()) << (i * 8);
+        }
+        double result;
+        std::memcpy(&result, &bits, sizeof(result));
+        return result;
+    }
+
+    const std::pair<const char*, rapidjson::SizeType>& lookup(uint64_t index) const {
+        if (index >= strings.size()) {
+            fail("string index is out of range");
+        }
+        return strings[index];
+    }
+
+    const uint8_t* data;
+    const uint8_t* const end;
+    std::vector<std::pair<const char*, rapidjson::SizeType>> strings;
+};
+
+} // namespace
+
+std::string encodeBinaryStyle(const std::string& json) {
+    Encoder encoder;
+    rapidjson::Reader reader;
+    rapidjson::StringStream stream(json.c_str());
+
+    rapidjson::ParseResult result = reader.Parse(stream, encoder);
+    if (result.IsError()) {
+        std::stringstream message;
+        message << result.Offset() << " - " << rapidjson::GetParseError_En(result.Code());
+        throw std::runtime_error(message.str());
+    }
+
+    return encoder.finish();
+}
+
+std::string decodeBinaryStyle(const std::string& binary) {
+    rapidjson::StringBuffer buffer;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+
+    Decoder decoder(binary);
+    decoder(writer);
+
+    return { buffer.GetString(), buffer.GetSize() };
+}
+
+void readBinaryStyle(const std::string& binary, JSDocument& document) {
+    Decoder decoder(binary);
+    document.Populate(decoder);
+}
+
+} // namespace style
+} // namespace mbgl
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <mbgl/util/rapidjson.hpp>
+
+#include <string>
+
+namespace mbgl {
+namespace style {
+
+// Builds the document encoded by encodeBinaryStyle() directly, without going through JSON text.
+// Throws std::runtime_error if the data is not a valid binary style.
+void readBinaryStyle(const std::string& binary, JSDocument&);
+
+} // namespace style
+} // namespace mbgl
@@ -320,7 +320,7 @@ private:
 template <class Writer, class T>
 void stringify(Writer& writer, const CameraFunction<T>& f) {
     writer.StartObject();
-    CameraFunction<T>::Stops::visit(f.stops, StringifyStops<Writer> { writer });
+    CameraFunction<T>::Stops::visit(f.getStops(), StringifyStops<Writer> { writer });
     writer.EndObject();
 }
 
@@ -2,12 +2,17 @@
 
 #include <vector>
 #include <memory>
+#include <string>
 
 namespace mbgl {
 namespace style {
 
 class Layer;
 
+// A key that is equal for two layers exactly when they produce identical buckets, apart
+// from data-driven paint properties.
+std::string layoutKey(const Layer&);
+
 std::vector<std::vector<const Layer*>> groupByLayout(const std::vector<std::unique_ptr<Layer>>&);
 
 } // namespace style
@@ -11,6 +11,14 @@ std::unique_ptr<Layer> Layer::Impl::copy(const std::string& id_,
     return result;
 }
 
+bool Layer::Impl::evaluateIfNeeded(const PropertyEvaluationParameters& parameters, bool zoomChanged) {
+    if (cascaded || transitioning || timeDependent || (zoomDependent && zoomChanged)) {
+        transitioning = evaluate(parameters);
+        cascaded = false;
+    }
+    return transitioning;
+}
+
 bool Layer::Impl::hasRenderPass(RenderPass pass) const {
     return bool(passes & pass);
 }
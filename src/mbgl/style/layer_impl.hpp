@@ -61,6 +61,11 @@ public:
     // Returns true if any paint properties have active transitions.
     virtual bool evaluate(const PropertyEvaluationParameters&) = 0;
 
+    // Like evaluate(), but skipped when the results of the previous evaluation are known to be
+    // current: the layer hasn't been cascaded since, has no transitions or cross-fades in progress,
+    // and either the zoom level is unchanged or no property depends on it.
+    bool evaluateIfNeeded(const PropertyEvaluationParameters&, bool zoomChanged);
+
     virtual std::unique_ptr<Bucket> createBucket(const BucketParameters&, const std::vector<const Layer*>&) const = 0;
 
     // Checks whether this layer needs to be rendered in the given render pass.
@@ -87,6 +92,11 @@ public:
     float maxZoom = std::numeric_limits<float>::infinity();
     VisibilityType visibility = VisibilityType::Visible;
 
+    // What the evaluated properties depend on, as of the last cascade. Maintained by Style.
+    bool cascaded = true;
+    bool zoomDependent = false;
+    bool timeDependent = false;
+
     LayerObserver nullObserver;
     LayerObserver* observer = &nullObserver;
 
@@ -98,6 +108,9 @@ protected:
     // Stores what render passes this layer is currently enabled for. This depends on the
     // evaluated StyleProperties object and is updated accordingly.
     RenderPass passes = RenderPass::None;
+
+    // Whether the last evaluation found transitions in progress.
+    bool transitioning = false;
 };
 
 } // namespace style
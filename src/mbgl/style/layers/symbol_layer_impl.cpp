@@ -31,10 +31,14 @@ std::unique_ptr<Bucket> SymbolLayer::Impl::createBucket(const BucketParameters&,
 
 std::unique_ptr<SymbolLayout> SymbolLayer::Impl::createLayout(const BucketParameters& parameters,
                                                               const std::vector<const Layer*>& group,
-                                                              const GeometryTileLayer& layer) const {
+                                                              const GeometryTileLayer& layer,
+                                                              uint32_t sourceLayerID,
+                                                              uint32_t bucketID) const {
     return std::make_unique<SymbolLayout>(parameters,
                                           group,
                                           layer,
+                                          sourceLayerID,
+                                          bucketID,
                                           *spriteAtlas);
 }
 
@@ -69,6 +69,10 @@ public:
         return value.isUndefined();
     }
 
+    bool isZoomDependent() const {
+        return value.evaluate(ZoomDependenceVisitor());
+    }
+
     const Value& getValue() const {
         return value;
     }
@@ -101,6 +105,10 @@ public:
         transitions[klass ? ClassDictionary::Get().lookup(*klass) : ClassID::Default] = transition;
     }
 
+    bool hasSameValues(const CascadingPaintProperty& other) const {
+        return values == other.values;
+    }
+
     template <class UnevaluatedPaintProperty>
     UnevaluatedPaintProperty cascade(const CascadeParameters& params, UnevaluatedPaintProperty prior) const {
         TransitionOptions transition;
@@ -170,6 +178,12 @@ public:
 template <class P>
 struct IsDataDriven : std::integral_constant<bool, P::IsDataDriven> {};
 
+template <class T>
+struct IsFaded : std::false_type {};
+
+template <class T>
+struct IsFaded<Faded<T>> : std::true_type {};
+
 template <class... Ps>
 class PaintProperties {
 public:
@@ -235,6 +249,32 @@ public:
         return result;
     }
 
+    // Whether re-evaluating the cascaded properties can give a different result at another zoom
+    // level.
+    bool isZoomDependent() const {
+        bool result = false;
+        util::ignore({ result |= unevaluated.template get<Ps>().isZoomDependent()... });
+        return result;
+    }
+
+    // Whether re-evaluating the cascaded properties can give a different result at a later time,
+    // as set cross-faded properties do while fading between zoom levels.
+    bool isTimeDependent() const {
+        bool result = false;
+        util::ignore({ result |= (IsFaded<typename Ps::EvaluatedType>::value &&
+            !unevaluated.template get<Ps>().isUndefined())... });
+        return result;
+    }
+
+    // Whether any data-driven property is set differently in `other`. Data-driven values are
+    // baked into buckets, so changing one requires the layer to be laid out again.
+    bool dataDrivenPropertiesDiffer(const PaintProperties& other) const {
+        bool result = false;
+        util::ignore({ result |= (Ps::IsDataDriven &&
+            !cascading.template get<Ps>().hasSameValues(other.cascading.template get<Ps>()))... });
+        return result;
+    }
+
     Cascading cascading;
     Unevaluated unevaluated;
     Evaluated evaluated;
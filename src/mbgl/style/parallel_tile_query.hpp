@@ -0,0 +1,120 @@
+#pragma once
+
+#include <mbgl/actor/actor.hpp>
+#include <mbgl/actor/actor_ref.hpp>
+#include <mbgl/actor/mailbox.hpp>
+#include <mbgl/util/run_loop.hpp>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace mbgl {
+
+class Scheduler;
+
+namespace style {
+
+// Runs a query over a set of tiles in parallel on a scheduler and collects the results on the
+// current thread. Each tile is handed to `queryTile` on a worker; once every tile is done,
+// `finish` is called with their results in the order that the tiles were given. `finish` is
+// called asynchronously even when there are no tiles.
+//
+// `queryTile` runs concurrently with itself and may only read state that outlives this object.
+// It is passed a flag that is set once this object is being destroyed, after which its result
+// is discarded, so that long-running queries can stop early. Destroying this object waits for
+// running queries to return and skips the tiles that haven't been queried yet; `finish` is then
+// not called.
+template <class TileQuery, class TileResult>
+class ParallelTileQuery {
+public:
+    using QueryTile = std::function<TileResult (TileQuery, const std::atomic<bool>& cancelled)>;
+    using Finish = std::function<void (std::vector<TileResult>)>;
+
+    ParallelTileQuery(Scheduler& scheduler,
+                      std::vector<TileQuery> tileQueries,
+                      QueryTile queryTile_,
+                      Finish finish_)
+        : queryTile(std::move(queryTile_)),
+          finish(std::move(finish_)),
+          results(tileQueries.size()),
+          pending(tileQueries.size()),
+          mailbox(std::make_shared<Mailbox>(*util::RunLoop::Get())) {
+        ActorRef<ParallelTileQuery> self(*this, mailbox);
+
+        if (tileQueries.empty()) {
+            self.invoke(&ParallelTileQuery::done);
+            return;
+        }
+
+        workers.reserve(tileQueries.size());
+        for (std::size_t i = 0; i < tileQueries.size(); ++i) {
+            workers.push_back(std::make_unique<Actor<Worker>>(scheduler, self, queryTile, cancelled));
+            workers.back()->invoke(&Worker::query, i, std::move(tileQueries[i]));
+        }
+    }
+
+    ~ParallelTileQuery() {
+        cancelled = true;
+    }
+
+private:
+    class Worker {
+    public:
+        Worker(ActorRef<Worker>,
+               ActorRef<ParallelTileQuery> parent_,
+               const QueryTile& queryTile_,
+               const std::atomic<bool>& cancelled_)
+            : parent(std::move(parent_)),
+              queryTile(queryTile_),
+              cancelled(cancelled_) {
+        }
+
+        void query(std::size_t index, TileQuery tileQuery) {
+            if (cancelled) {
+                return;
+            }
+
+            TileResult result = queryTile(std::move(tileQuery), cancelled);
+            if (!cancelled) {
+                parent.invoke(&ParallelTileQuery::onTileQueried, index, std::move(result));
+            }
+        }
+
+    private:
+        ActorRef<ParallelTileQuery> parent;
+        const QueryTile& queryTile;
+        const std::atomic<bool>& cancelled;
+    };
+
+    void onTileQueried(std::size_t index, TileResult result) {
+        results[index] = std::move(result);
+
+        if (--pending == 0) {
+            done();
+        }
+    }
+
+    void done() {
+        // `finish` may destroy this object, so nothing may be touched after it returns.
+        Finish fn = std::move(finish);
+        fn(std::move(results));
+    }
+
+    const QueryTile queryTile;
+    Finish finish;
+
+    std::vector<TileResult> results;
+    std::size_t pending;
+
+    // Used to signal the workers that they should skip tiles they haven't queried yet.
+    std::atomic<bool> cancelled { false };
+
+    // Declared last, so that the workers are destroyed, and stop, before anything they use.
+    std::shared_ptr<Mailbox> mailbox;
+    std::vector<std::unique_ptr<Actor<Worker>>> workers;
+};
+
+} // namespace style
+} // namespace mbgl
@@ -1,4 +1,5 @@
 #include <mbgl/style/parser.hpp>
+#include <mbgl/style/binary_style_reader.hpp>
 #include <mbgl/style/layer_impl.hpp>
 #include <mbgl/style/rapidjson_conversion.hpp>
 #include <mbgl/style/conversion.hpp>
@@ -11,6 +12,8 @@
 
 #include <rapidjson/document.h>
 #include <rapidjson/error/en.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
 
 #include <algorithm>
 #include <set>
@@ -33,6 +36,22 @@ StyleParseResult Parser::parse(const std::string& json) {
         return std::make_exception_ptr(std::runtime_error(message.str()));
     }
 
+    return parseDocument(document);
+}
+
+StyleParseResult Parser::parseBinary(const std::string& binary) {
+    rapidjson::GenericDocument<rapidjson::UTF8<>, rapidjson::CrtAllocator> document;
+
+    try {
+        readBinaryStyle(binary, document);
+    } catch (...) {
+        return std::current_exception();
+    }
+
+    return parseDocument(document);
+}
+
+StyleParseResult Parser::parseDocument(const JSValue& document) {
     if (!document.IsObject()) {
         return std::make_exception_ptr(std::runtime_error("style must be an object"));
     }
@@ -123,6 +142,11 @@ void Parser::parseSources(const JSValue& value) {
             continue;
         }
 
+        rapidjson::StringBuffer buffer;
+        rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+        property.value.Accept(writer);
+        sourceDefinitions.emplace(id, std::string(buffer.GetString(), buffer.GetSize()));
+
         sourcesMap.emplace(id, (*source).get());
         sources.emplace_back(std::move(*source));
     }
@@ -242,7 +266,7 @@ std::vector<FontStack> Parser::fontStacks() const {
             } else if (textFont.isConstant()) {
                 result.insert(textFont.asConstant());
             } else if (textFont.isCameraFunction()) {
-                textFont.asCameraFunction().stops.match(
+                textFont.asCameraFunction().getStops().match(
                     [&] (const auto& stops) {
                         for (const auto& stop : stops.stops) {
                             result.insert(stop.second);
@@ -25,10 +25,17 @@ public:
 
     StyleParseResult parse(const std::string&);
 
+    // Parses a style encoded by encodeBinaryStyle(), which skips tokenizing JSON text.
+    StyleParseResult parseBinary(const std::string&);
+
     std::string spriteURL;
     std::string glyphURL;
 
     std::vector<std::unique_ptr<Source>> sources;
+
+    // The serialized definition of each source, used to recognize unchanged sources when
+    // one style replaces another.
+    std::unordered_map<std::string, std::string> sourceDefinitions;
     std::vector<std::unique_ptr<Layer>> layers;
 
     std::string name;
@@ -41,6 +48,7 @@ public:
     std::vector<FontStack> fontStacks() const;
 
 private:
+    StyleParseResult parseDocument(const JSValue&);
     void parseSources(const JSValue&);
     void parseLayers(const JSValue&);
     void parseLayer(const std::string& id, const JSValue&, std::unique_ptr<Layer>&);
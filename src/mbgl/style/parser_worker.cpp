@@ -0,0 +1,26 @@
+#include <mbgl/style/parser_worker.hpp>
+#include <mbgl/style/style.hpp>
+#include <mbgl/actor/actor.hpp>
+
+namespace mbgl {
+namespace style {
+
+ParserWorker::ParserWorker(ActorRef<ParserWorker>, ActorRef<Style> parent_)
+    : parent(std::move(parent_)) {
+}
+
+void ParserWorker::parse(std::string json, uint64_t correlationID) {
+    auto parser = std::make_unique<Parser>();
+    StyleParseResult error;
+
+    try {
+        error = parser->parse(json);
+    } catch (...) {
+        error = std::current_exception();
+    }
+
+    parent.invoke(&Style::onParsed, std::move(parser), error, correlationID);
+}
+
+} // namespace style
+} // namespace mbgl
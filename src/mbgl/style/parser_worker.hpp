@@ -0,0 +1,27 @@
+#pragma once
+
+#include <mbgl/style/parser.hpp>
+#include <mbgl/actor/actor_ref.hpp>
+
+#include <memory>
+#include <string>
+
+namespace mbgl {
+namespace style {
+
+class Style;
+
+// Parses style JSON and builds its sources and layers on a background scheduler. The
+// result is handed back to the style as a whole.
+class ParserWorker {
+public:
+    ParserWorker(ActorRef<ParserWorker>, ActorRef<Style>);
+
+    void parse(std::string json, uint64_t correlationID);
+
+private:
+    ActorRef<Style> parent;
+};
+
+} // namespace style
+} // namespace mbgl
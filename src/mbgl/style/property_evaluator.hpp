@@ -24,5 +24,16 @@ private:
     T defaultValue;
 };
 
+// Determines whether a property value evaluates differently at different zoom levels. Source and
+// composite functions are evaluated per feature at render time, so they don't count.
+class ZoomDependenceVisitor {
+public:
+    template <typename T>
+    bool operator()(const T&) const { return false; }
+
+    template <typename T>
+    bool operator()(const CameraFunction<T>&) const { return true; }
+};
+
 } // namespace style
 } // namespace mbgl
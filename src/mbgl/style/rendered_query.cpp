@@ -0,0 +1,83 @@
+#include <mbgl/style/rendered_query.hpp>
+#include <mbgl/style/query_parameters.hpp>
+#include <mbgl/style/layer.hpp>
+#include <mbgl/style/layer_impl.hpp>
+#include <mbgl/text/collision_tile.hpp>
+#include <mbgl/map/transform_state.hpp>
+#include <mbgl/util/constants.hpp>
+#include <mbgl/math/minmax.hpp>
+
+#include <cmath>
+
+namespace mbgl {
+namespace style {
+
+RenderedQuery::RenderedQuery(Scheduler& scheduler,
+                             const QueryParameters& parameters,
+                             std::vector<std::unique_ptr<Layer>> layers_,
+                             std::vector<TileQuery> tileQueries,
+                             Callback callback_)
+    : layers(std::move(layers_)),
+      bearing(parameters.transformState.getAngle()),
+      zoom(parameters.transformState.getZoom()),
+      layerIDs(parameters.layerIDs),
+      callback(std::move(callback_)) {
+    for (const auto& layer : layers) {
+        queryLayers.layers.emplace(layer->baseImpl->id, layer.get());
+        queryLayers.radius = util::max(queryLayers.radius, layer->baseImpl->getQueryRadius());
+    }
+
+    query = std::make_unique<ParallelTileQuery<TileQuery, TileResult>>(
+        scheduler, std::move(tileQueries),
+        [this] (TileQuery tileQuery, const std::atomic<bool>&) { return queryTile(std::move(tileQuery)); },
+        [this] (std::vector<TileResult> results) { finish(std::move(results)); });
+}
+
+RenderedQuery::TileResult RenderedQuery::queryTile(TileQuery tileQuery) const {
+    const TileFeatureIndex& tile = tileQuery.tile;
+    std::unordered_map<std::string, std::vector<LazyFeature>> features;
+
+    tile.featureIndex->query(features,
+                             tileQuery.geometry,
+                             bearing,
+                             util::tileSize * tile.id.overscaleFactor(),
+                             std::pow(2, zoom - tile.id.overscaledZ),
+                             layerIDs,
+                             tile.data,
+                             tile.id.canonical,
+                             queryLayers,
+                             tile.collisionTile.get());
+
+    // Features refer into the tile's copy of its data, so they're converted here.
+    TileResult result;
+    for (const auto& layer : features) {
+        auto& converted = result[layer.first];
+        converted.reserve(layer.second.size());
+        for (const auto& feature : layer.second) {
+            converted.push_back(feature.toFeature());
+        }
+    }
+
+    return result;
+}
+
+void RenderedQuery::finish(std::vector<TileResult> results) {
+    std::vector<Feature> result;
+
+    // Combine all results based on the style layer order, and within each layer, in tile order.
+    for (const auto& layer : layers) {
+        for (auto& tileResult : results) {
+            auto it = tileResult.find(layer->baseImpl->id);
+            if (it != tileResult.end()) {
+                std::move(it->second.begin(), it->second.end(), std::back_inserter(result));
+            }
+        }
+    }
+
+    // The callback may destroy this request, so nothing may be touched after it returns.
+    Callback done = std::move(callback);
+    done(std::move(result));
+}
+
+} // namespace style
+} // namespace mbgl
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <mbgl/geometry/feature_index.hpp>
+#include <mbgl/style/parallel_tile_query.hpp>
+#include <mbgl/tile/tile.hpp>
+#include <mbgl/util/async_request.hpp>
+#include <mbgl/util/feature.hpp>
+#include <mbgl/util/optional.hpp>
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace mbgl {
+
+class Scheduler;
+
+namespace style {
+
+class Layer;
+class QueryParameters;
+
+// One tile's share of an asynchronous query: a snapshot of the tile's features, and the query
+// geometry in the tile's coordinates.
+class TileQuery {
+public:
+    TileFeatureIndex tile;
+    GeometryCoordinates geometry;
+};
+
+// An asynchronous queryRenderedFeatures(). Copies of the rendered layers and snapshots of the
+// tiles that the geometry touches are taken when the query is made. The tiles are then queried
+// in parallel on the scheduler, and the callback is called on the main thread with features in
+// the same order as the synchronous query returns them.
+//
+// Destroying the request cancels the query: tiles that haven't been queried yet are skipped,
+// and the callback is not called.
+class RenderedQuery : public AsyncRequest {
+public:
+    using Callback = std::function<void (std::vector<Feature>)>;
+
+    // `layers` are the layers to return features for, in style order.
+    RenderedQuery(Scheduler&,
+                  const QueryParameters&,
+                  std::vector<std::unique_ptr<Layer>> layers,
+                  std::vector<TileQuery>,
+                  Callback);
+
+private:
+    using TileResult = std::unordered_map<std::string, std::vector<Feature>>;
+
+    TileResult queryTile(TileQuery) const;
+    void finish(std::vector<TileResult>);
+
+    const std::vector<std::unique_ptr<Layer>> layers;
+    QueryLayers queryLayers;
+    const float bearing;
+    const double zoom;
+    const optional<std::vector<std::string>> layerIDs;
+    Callback callback;
+
+    // Declared last, so that its workers stop before the state they read is destroyed.
+    std::unique_ptr<ParallelTileQuery<TileQuery, TileResult>> query;
+};
+
+} // namespace style
+} // namespace mbgl
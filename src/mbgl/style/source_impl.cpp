@@ -5,8 +5,11 @@
 #include <mbgl/renderer/painter.hpp>
 #include <mbgl/style/update_parameters.hpp>
 #include <mbgl/style/query_parameters.hpp>
+#include <mbgl/style/rendered_query.hpp>
+#include <mbgl/style/source_query.hpp>
 #include <mbgl/text/placement_config.hpp>
 #include <mbgl/util/logging.hpp>
+#include <mbgl/util/constants.hpp>
 #include <mbgl/math/clamp.hpp>
 #include <mbgl/util/tile_cover.hpp>
 #include <mbgl/util/enum.hpp>
@@ -18,12 +21,23 @@
 #include <mapbox/geometry/envelope.hpp>
 
 #include <algorithm>
+#include <cmath>
 
 namespace mbgl {
 namespace style {
 
 static SourceObserver nullObserver;
 
+// While the camera moves continuously, symbols are placed for the nearest of these steps rather
+// than for the exact angle and pitch, so that tiles are re-placed only when the camera crosses
+// into another step, and can show placements they made for a step before.
+static const double placementAngleStep = util::M2PI / 128;
+static const double placementPitchStep = M_PI / 72;
+
+static float quantize(double value, double step) {
+    return std::round(value / step) * step;
+}
+
 Source::Impl::Impl(SourceType type_, std::string id_, Source& base_)
     : type(type_),
       id(std::move(id_)),
@@ -150,15 +164,26 @@ void Source::Impl::updateTiles(const UpdateParameters& parameters) {
 
     removeStaleTiles(retain);
 
-    const PlacementConfig config { parameters.transformState.getAngle(),
-                                   parameters.transformState.getPitch(),
-                                   parameters.debugOptions & MapDebugOptions::Collision };
+    const PlacementConfig config = placementConfig(parameters.transformState, parameters.mode, parameters.debugOptions);
 
     for (auto& pair : tiles) {
         pair.second->setPlacementConfig(config);
     }
 }
 
+PlacementConfig Source::Impl::placementConfig(const TransformState& state, MapMode mode, MapDebugOptions debugOptions) {
+    PlacementConfig config { float(state.getAngle()),
+                             float(state.getPitch()),
+                             debugOptions & MapDebugOptions::Collision };
+
+    if (mode == MapMode::Continuous && state.isChanging()) {
+        config.angle = quantize(config.angle, placementAngleStep);
+        config.pitch = quantize(config.pitch, placementPitchStep);
+    }
+
+    return config;
+}
+
 // Moves all tiles to the cache except for those specified in the retain set.
 void Source::Impl::removeStaleTiles(const std::set<OverscaledTileID>& retain) {
     // Remove stale tiles. This goes through the (sorted!) tiles map and retain set in lockstep
@@ -200,10 +225,14 @@ void Source::Impl::reloadTiles() {
     }
 }
 
-std::unordered_map<std::string, std::vector<Feature>> Source::Impl::queryRenderedFeatures(const QueryParameters& parameters) const {
-    std::unordered_map<std::string, std::vector<Feature>> result;
+// Calls fn(renderTile, tileSpaceQueryGeometry) for each tile that the query geometry touches,
+// in the order in which their results are combined.
+template <class Fn>
+static void forEachQueriedTile(const std::map<UnwrappedTileID, RenderTile>& renderTiles,
+                               const QueryParameters& parameters,
+                               Fn&& fn) {
     if (renderTiles.empty() || parameters.geometry.empty()) {
-        return result;
+        return;
     }
 
     LineString<double> queryGeometry;
@@ -243,15 +272,72 @@ std::unordered_map<std::string, std::vector<Feature>> Source::Impl::queryRendere
             tileSpaceQueryGeometry.push_back(TileCoordinate::toGeometryCoordinate(renderTile.id, c));
         }
 
+        fn(renderTile, std::move(tileSpaceQueryGeometry));
+    }
+}
+
+std::unordered_map<std::string, std::vector<LazyFeature>> Source::Impl::queryRenderedFeatures(const QueryParameters& parameters,
+                                                                                          const QueryLayers& queryLayers) const {
+    std::unordered_map<std::string, std::vector<LazyFeature>> result;
+
+    forEachQueriedTile(renderTiles, parameters, [&] (const RenderTile& renderTile, GeometryCoordinates tileSpaceQueryGeometry) {
         renderTile.tile.queryRenderedFeatures(result,
                                               tileSpaceQueryGeometry,
                                               parameters.transformState,
+                                              queryLayers,
                                               parameters.layerIDs);
-    }
+    });
 
     return result;
 }
 
+void Source::Impl::snapshotQueriedTiles(const QueryParameters& parameters, std::vector<TileQuery>& tileQueries) const {
+    forEachQueriedTile(renderTiles, parameters, [&] (const RenderTile& renderTile, GeometryCoordinates tileSpaceQueryGeometry) {
+        auto featureIndex = renderTile.tile.snapshotFeatureIndex();
+        if (featureIndex) {
+            tileQueries.push_back({ std::move(*featureIndex), std::move(tileSpaceQueryGeometry) });
+        }
+    });
+}
+
+void Source::Impl::snapshotSourceTiles(const SourceQueryOptions& options, std::vector<SourceTileQuery>& tileQueries) {
+    if (!options.bounds) {
+        for (const auto& pair : tiles) {
+            auto data = pair.second->cloneData();
+            if (data) {
+                tileQueries.push_back({ pair.first.canonical, std::move(data), {} });
+            }
+        }
+        return;
+    }
+
+    // Cover the bounds the same way updateTiles() covers the viewport.
+    const Range<uint8_t> zoomRange = getZoomRange();
+    const int32_t overscaledZoom = util::coveringZoomLevel(options.zoom, type, getTileSize());
+    if (overscaledZoom < zoomRange.min) {
+        return;
+    }
+    const int32_t idealZoom = std::min<int32_t>(zoomRange.max, overscaledZoom);
+
+    const TileCoordinatePoint northwest = TileCoordinate::fromLatLng(0, options.bounds->northwest()).p;
+    const TileCoordinatePoint southeast = TileCoordinate::fromLatLng(0, options.bounds->southeast()).p;
+
+    for (const auto& tileID : util::tileCover(*options.bounds, idealZoom)) {
+        auto it = tiles.find(tileID.overscaleTo(overscaledZoom));
+        if (it == tiles.end()) {
+            continue;
+        }
+
+        auto data = it->second->cloneData();
+        if (data) {
+            tileQueries.push_back({ tileID.canonical, std::move(data), mapbox::geometry::box<int16_t> {
+                TileCoordinate::toGeometryCoordinate(tileID, northwest),
+                TileCoordinate::toGeometryCoordinate(tileID, southeast)
+            } });
+        }
+    }
+}
+
 void Source::Impl::setCacheSize(size_t size) {
     cache.setSize(size);
 }
@@ -7,6 +7,8 @@
 #include <mbgl/tile/tile.hpp>
 #include <mbgl/tile/tile_cache.hpp>
 #include <mbgl/style/types.hpp>
+#include <mbgl/text/placement_config.hpp>
+#include <mbgl/map/mode.hpp>
 
 #include <mbgl/util/noncopyable.hpp>
 #include <mbgl/util/mat4.hpp>
@@ -22,8 +24,11 @@ namespace mbgl {
 
 class Painter;
 class FileSource;
+class Scheduler;
 class TransformState;
 class RenderTile;
+class QueryLayers;
+struct SourceQueryOptions;
 
 namespace algorithm {
 class ClipIDGenerator;
@@ -34,19 +39,28 @@ namespace style {
 class UpdateParameters;
 class QueryParameters;
 class SourceObserver;
+class TileQuery;
+class SourceTileQuery;
 
 class Source::Impl : public TileObserver, private util::noncopyable {
 public:
     Impl(SourceType, std::string id, Source&);
     ~Impl() override;
 
-    virtual void loadDescription(FileSource&) = 0;
+    // Loads the source description. Sources that process their data off the main thread
+    // do so on the given scheduler.
+    virtual void loadDescription(FileSource&, Scheduler&) = 0;
     bool isLoaded() const;
 
     // Called when the camera has changed. May load new tiles, unload obsolete tiles, or
     // trigger re-placement of existing complete tiles.
     void updateTiles(const UpdateParameters&);
 
+    // The camera that tiles place their symbols for. While the camera moves continuously, the
+    // angle and pitch are rounded to steps, so that tiles re-place their symbols only when it
+    // crosses into another step. Once it's at rest, symbols are placed for the exact camera.
+    static PlacementConfig placementConfig(const TransformState&, MapMode, MapDebugOptions);
+
     // Called when icons or glyphs are loaded. Triggers further processing of tiles which
     // were waiting on such dependencies.
     void updateSymbolDependentTiles();
@@ -65,8 +79,16 @@ public:
 
     std::map<UnwrappedTileID, RenderTile>& getRenderTiles();
 
-    std::unordered_map<std::string, std::vector<Feature>>
-    queryRenderedFeatures(const QueryParameters&) const;
+    std::unordered_map<std::string, std::vector<LazyFeature>>
+    queryRenderedFeatures(const QueryParameters&, const QueryLayers&) const;
+
+    // Appends a snapshot of each tile that the query geometry touches, in the order in which
+    // queryRenderedFeatures() visits them, so that the tiles can be queried off the main thread.
+    void snapshotQueriedTiles(const QueryParameters&, std::vector<TileQuery>&) const;
+
+    // Appends a copy of the data of each loaded tile that a source query reads: all of them,
+    // or those that cover the query's bounds at its zoom level.
+    void snapshotSourceTiles(const SourceQueryOptions&, std::vector<SourceTileQuery>&);
 
     void setCacheSize(size_t);
     void onLowMemory();
@@ -23,6 +23,9 @@ public:
     // Source description needs to be reloaded
     virtual void onSourceDescriptionChanged(Source&) {}
 
+    // Source data or URL was changed at runtime, so it no longer matches its style definition
+    virtual void onSourceChanged(Source&) {}
+
     virtual void onTileChanged(Source&, const OverscaledTileID&) {}
     virtual void onTileError(Source&, const OverscaledTileID&, std::exception_ptr) {}
 };
@@ -0,0 +1,89 @@
+#include <mbgl/style/source_query.hpp>
+#include <mbgl/style/filter_evaluator.hpp>
+
+#include <mapbox/geometry/envelope.hpp>
+
+#include <set>
+
+namespace mbgl {
+namespace style {
+
+SourceQuery::SourceQuery(Scheduler& scheduler,
+                         SourceQueryOptions options_,
+                         std::vector<SourceTileQuery> tileQueries,
+                         Callback callback_)
+    : options(std::move(options_)),
+      callback(std::move(callback_)),
+      query(std::make_unique<ParallelTileQuery<SourceTileQuery, std::vector<Feature>>>(
+          scheduler, std::move(tileQueries),
+          [this] (SourceTileQuery tileQuery, const std::atomic<bool>& cancelled) {
+              return queryTile(std::move(tileQuery), cancelled);
+          },
+          [this] (std::vector<std::vector<Feature>> results) { finish(std::move(results)); })) {
+}
+
+static bool intersects(const GeometryCollection& geometries, const mapbox::geometry::box<int16_t>& bounds) {
+    for (const auto& ring : geometries) {
+        if (ring.empty()) {
+            continue;
+        }
+        const auto envelope = mapbox::geometry::envelope(ring);
+        if (envelope.min.x <= bounds.max.x && envelope.min.y <= bounds.max.y &&
+            envelope.max.x >= bounds.min.x && envelope.max.y >= bounds.min.y) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::vector<Feature> SourceQuery::queryTile(SourceTileQuery tileQuery, const std::atomic<bool>& cancelled) const {
+    std::vector<Feature> result;
+
+    const GeometryTileLayer* layer = tileQuery.data->getLayer(options.sourceLayer);
+    if (layer) {
+        const std::size_t featureCount = layer->featureCount();
+        for (std::size_t i = 0; i < featureCount; ++i) {
+            if (cancelled) {
+                return {};
+            }
+
+            // Filter before touching the geometry, so that features that don't match cost
+            // only the properties the filter reads.
+            auto feature = layer->getFeature(i);
+            if (!options.filter(feature->getType(), feature->getID(), [&] (const auto& key) { return feature->getValue(key); })) {
+                continue;
+            }
+
+            if (tileQuery.bounds && !intersects(feature->getGeometries(), *tileQuery.bounds)) {
+                continue;
+            }
+
+            result.push_back(convertFeature(*feature, tileQuery.id));
+        }
+    }
+
+    return result;
+}
+
+void SourceQuery::finish(std::vector<std::vector<Feature>> results) {
+    std::vector<Feature> result;
+
+    // Features that cross tile boundaries are found in every tile they're in, and tiles of
+    // different zoom levels can overlap, so features are de-duplicated by identifier. Features
+    // without one can't be told apart and are all kept.
+    std::set<FeatureIdentifier> seen;
+    for (auto& tileResult : results) {
+        for (auto& feature : tileResult) {
+            if (!feature.id || seen.insert(*feature.id).second) {
+                result.push_back(std::move(feature));
+            }
+        }
+    }
+
+    // The callback may destroy this request, so nothing may be touched after it returns.
+    Callback done = std::move(callback);
+    done(std::move(result));
+}
+
+} // namespace style
+} // namespace mbgl
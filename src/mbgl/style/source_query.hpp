@@ -0,0 +1,57 @@
+#pragma once
+
+#include <mbgl/map/query.hpp>
+#include <mbgl/style/parallel_tile_query.hpp>
+#include <mbgl/tile/geometry_tile_data.hpp>
+#include <mbgl/tile/tile_id.hpp>
+#include <mbgl/util/async_request.hpp>
+#include <mbgl/util/feature.hpp>
+#include <mbgl/util/optional.hpp>
+
+#include <mapbox/geometry/box.hpp>
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace mbgl {
+
+class Scheduler;
+
+namespace style {
+
+// One tile's share of a source query: a copy of the tile's data, and the query bounds in the
+// tile's coordinates, if any.
+class SourceTileQuery {
+public:
+    CanonicalTileID id;
+    std::unique_ptr<const GeometryTileData> data;
+    optional<mapbox::geometry::box<int16_t>> bounds;
+};
+
+// Map::querySourceFeatures(). Copies of the data of the source's loaded tiles are taken when the
+// query is made, and each is filtered in parallel on the scheduler. The callback is called on the
+// main thread with the matching features in tile order, keeping only the first of the features
+// that share an identifier.
+//
+// Destroying the request cancels the query: tiles that haven't been read yet are skipped, and the
+// callback is not called.
+class SourceQuery : public AsyncRequest {
+public:
+    using Callback = std::function<void (std::vector<Feature>)>;
+
+    SourceQuery(Scheduler&, SourceQueryOptions, std::vector<SourceTileQuery>, Callback);
+
+private:
+    std::vector<Feature> queryTile(SourceTileQuery, const std::atomic<bool>& cancelled) const;
+    void finish(std::vector<std::vector<Feature>>);
+
+    const SourceQueryOptions options;
+    Callback callback;
+
+    // Declared last, so that its workers stop before the state they read is destroyed.
+    std::unique_ptr<ParallelTileQuery<SourceTileQuery, std::vector<Feature>>> query;
+};
+
+} // namespace style
+} // namespace mbgl
@@ -0,0 +1,492 @@
+#include <mbgl/style/sources/geojson_reader.hpp>
+#include <mbgl/util/feature.hpp>
+
+#include <rapidjson/reader.h>
+#include <rapidjson/error/en.h>
+
+#include <array>
+#include <sstream>
+#include <stdexcept>
+
+namespace mbgl {
+namespace style {
+
+namespace {
+
+using Geometry = mapbox::geometry::geometry<double>;
+using GeometryCollection = mapbox::geometry::geometry_collection<double>;
+
+// What the JSON object or array currently being read represents.
+enum class Role : uint8_t {
+    Object,      // A GeoJSON object: a geometry, feature or feature collection.
+    Features,    // The "features" member of a feature collection.
+    Geometries,  // The "geometries" member of a geometry collection.
+    Coordinates, // The "coordinates" member of a geometry, or an array nested within it.
+    Properties,  // The "properties" member of a feature.
+    Array,       // An array within a property value.
+    Map,         // An object within a property value.
+    Skipped      // A member outside the GeoJSON model, such as "bbox" or "crs".
+};
+
+struct Frame {
+    Frame(Role role_, uint8_t level_ = 0) : role(role_), level(level_) {}
+
+    Role role;
+
+    // Nesting level of a coordinates array; the "coordinates" member itself is level 1.
+    uint8_t level;
+
+    // Whether a coordinates array holds numbers, i.e. is a position.
+    bool position = false;
+
+    // Number of elements read so far into a coordinates array.
+    std::size_t count = 0;
+
+    // The member most recently named in an object.
+    std::string key;
+};
+
+// The members of a GeoJSON object read so far. Its type is only known once the object ends,
+// since "type" may follow the other members.
+struct Object {
+    std::string type;
+
+    // The coordinates, flattened: every position in order, plus the element count of each
+    // array at every nesting level above the positions.
+    bool hasCoordinates = false;
+    uint8_t positionLevel = 0;
+    mapbox::geometry::line_string<double> points;
+    std::array<std::vector<std::size_t>, 4> sizes;
+
+    GeometryCollection geometries;
+    optional<Geometry> geometry;
+    PropertyMap properties;
+    optional<FeatureIdentifier> id;
+    FeatureCollection features;
+};
+
+optional<double> number(uint64_t value) { return double(value); }
+optional<double> number(int64_t value) { return double(value); }
+optional<double> number(double value) { return value; }
+template <class T>
+optional<double> number(const T&) { return {}; }
+
+class Handler {
+public:
+    optional<GeoJSON> result;
+    std::string error;
+
+    bool Null()                 { return scalar(mapbox::geometry::null_value); }
+    bool Bool(bool value)       { return scalar(value); }
+    bool Int(int value)         { return value < 0 ? scalar(int64_t(value)) : scalar(uint64_t(value)); }
+    bool Uint(unsigned value)   { return scalar(uint64_t(value)); }
+    bool Int64(int64_t value)   { return value < 0 ? scalar(value) : scalar(uint64_t(value)); }
+    bool Uint64(uint64_t value) { return scalar(value); }
+    bool Double(double value)   { return scalar(value); }
+
+    bool RawNumber(const char*, rapidjson::SizeType, bool) {
+        return fail("unexpected raw number");
+    }
+
+    bool String(const char* value, rapidjson::SizeType length, bool) {
+        return scalar(std::string(value, length));
+    }
+
+    bool Key(const char* value, rapidjson::SizeType length, bool) {
+        frames.back().key.assign(value, length);
+        return true;
+    }
+
+    bool StartObject() {
+        if (frames.empty()) {
+            return startObject();
+        }
+
+        Frame& top = frames.back();
+        switch (top.role) {
+        case Role::Object:
+            if (top.key == "geometry") {
+                return startObject();
+            } else if (top.key == "properties") {
+                frames.emplace_back(Role::Properties);
+                maps.emplace_back();
+                return true;
+            }
+            frames.emplace_back(Role::Skipped);
+            return true;
+        case Role::Features:
+        case Role::Geometries:
+            return startObject();
+        case Role::Properties:
+        case Role::Array:
+        case Role::Map:
+            frames.emplace_back(Role::Map);
+            maps.emplace_back();
+            return true;
+        case Role::Coordinates:
+            return fail("coordinates must be arrays of numbers");
+        case Role::Skipped:
+            frames.emplace_back(Role::Skipped);
+            return true;
+        }
+        return false;
+    }
+
+    bool EndObject(rapidjson::SizeType) {
+        const Role role = frames.back().role;
+        frames.pop_back();
+
+        switch (role) {
+        case Role::Object: {
+            Object object = std::move(objects.back());
+            objects.pop_back();
+            return endObject(std::move(object));
+        }
+        case Role::Properties:
+            objects.back().properties = std::move(maps.back());
+            maps.pop_back();
+            return true;
+        case Role::Map: {
+            Value value = std::move(maps.back());
+            maps.pop_back();
+            return addValue(std::move(value));
+        }
+        default:
+            return true;
+        }
+    }
+
+    bool StartArray() {
+        if (frames.empty()) {
+            return fail("GeoJSON must be an object");
+        }
+
+        Frame& top = frames.back();
+        switch (top.role) {
+        case Role::Object:
+            if (top.key == "coordinates") {
+                objects.back().hasCoordinates = true;
+                frames.emplace_back(Role::Coordinates, 1);
+            } else if (top.key == "features") {
+                frames.emplace_back(Role::Features);
+            } else if (top.key == "geometries") {
+                frames.emplace_back(Role::Geometries);
+            } else {
+                frames.emplace_back(Role::Skipped);
+            }
+            return true;
+        case Role::Coordinates:
+            if (top.position || top.level == 4) {
+                return fail("coordinates are nested too deeply");
+            }
+            top.count++;
+            frames.emplace_back(Role::Coordinates, top.level + 1);
+            return true;
+        case Role::Properties:
+        case Role::Array:
+        case Role::Map:
+            frames.emplace_back(Role::Array);
+            arrays.emplace_back();
+            return true;
+        case Role::Features:
+            return fail("features must be objects");
+        case Role::Geometries:
+            return fail("geometries must be objects");
+        case Role::Skipped:
+            frames.emplace_back(Role::Skipped);
+            return true;
+        }
+        return false;
+    }
+
+    bool EndArray(rapidjson::SizeType) {
+        const Frame frame = std::move(frames.back());
+        frames.pop_back();
+
+        switch (frame.role) {
+        case Role::Coordinates: {
+            Object& object = objects.back();
+            if (!frame.position) {
+                // Arrays at the deepest level can only be positions.
+                if (frame.level == object.sizes.size()) {
+                    return fail("a position must have at least two elements");
+                }
+                object.sizes[frame.level].push_back(frame.count);
+                return true;
+            }
+            if (frame.count < 2) {
+                return fail("a position must have at least two elements");
+            }
+            if (object.positionLevel && object.positionLevel != frame.level) {
+                return fail("positions must be nested consistently");
+            }
+            object.positionLevel = frame.level;
+            object.points.emplace_back(position[0], position[1]);
+            return true;
+        }
+        case Role::Array: {
+            Value value = std::move(arrays.back());
+            arrays.pop_back();
+            return addValue(std::move(value));
+        }
+        default:
+            return true;
+        }
+    }
+
+private:
+    std::vector<Frame> frames;
+    std::vector<Object> objects;
+    std::vector<std::vector<Value>> arrays;
+    std::vector<PropertyMap> maps;
+    std::array<double, 2> position;
+
+    bool fail(std::string message) {
+        error = std::move(message);
+        return false;
+    }
+
+    template <class T>
+    bool scalar(T&& value) {
+        if (frames.empty()) {
+            return fail("GeoJSON must be an object");
+        }
+
+        Frame& top = frames.back();
+        switch (top.role) {
+        case Role::Object:
+            return member(top.key, std::forward<T>(value));
+        case Role::Coordinates: {
+            optional<double> coordinate = number(value);
+            if (!coordinate || (top.count > 0 && !top.position)) {
+                return fail("coordinates must be arrays of numbers");
+            }
+            top.position = true;
+            if (top.count < 2) {
+                position[top.count] = *coordinate;
+            }
+            top.count++;
+            return true;
+        }
+        case Role::Properties:
+        case Role::Array:
+        case Role::Map:
+            return addValue(Value(std::forward<T>(value)));
+        case Role::Features:
+            return fail("features must be objects");
+        case Role::Geometries:
+            return fail("geometries must be objects");
+        case Role::Skipped:
+            return true;
+        }
+        return false;
+    }
+
+    bool member(const std::string& key, std::string&& value) {
+        if (key == "type") {
+            objects.back().type = std::move(value);
+        } else if (key == "id") {
+            objects.back().id = FeatureIdentifier(std::move(value));
+        }
+        return true;
+    }
+
+    bool member(const std::string& key, mapbox::geometry::null_value_t) {
+        // A feature with a null geometry is unlocated.
+        if (key == "geometry") {
+            objects.back().geometry = Geometry(GeometryCollection());
+        }
+        return true;
+    }
+
+    bool member(const std::string&, bool) {
+        return true;
+    }
+
+    template <class T>
+    bool member(const std::string& key, T value) {
+        if (key == "id") {
+            objects.back().id = FeatureIdentifier(value);
+        }
+        return true;
+    }
+
+    bool addValue(Value&& value) {
+        Frame& top = frames.back();
+        if (top.role == Role::Array) {
+            arrays.back().push_back(std::move(value));
+        } else {
+            maps.back()[top.key] = std::move(value);
+        }
+        return true;
+    }
+
+    bool startObject() {
+        frames.emplace_back(Role::Object);
+        objects.emplace_back();
+        return true;
+    }
+
+    bool endObject(Object&& object) {
+        optional<GeoJSON> geoJSON = build(std::move(object));
+        if (!geoJSON) {
+            return false;
+        }
+
+        if (frames.empty()) {
+            result = std::move(geoJSON);
+            return true;
+        }
+
+        switch (frames.back().role) {
+        case Role::Object:
+            if (!geoJSON->is<Geometry>()) {
+                return fail("a feature's geometry must be a geometry object");
+            }
+            objects.back().geometry = std::move(geoJSON->get<Geometry>());
+            return true;
+        case Role::Features:
+            if (!geoJSON->is<Feature>()) {
+                return fail("features must be Feature objects");
+            }
+            objects.back().features.push_back(std::move(geoJSON->get<Feature>()));
+            return true;
+        case Role::Geometries:
+            if (!geoJSON->is<Geometry>()) {
+                return fail("geometries must be geometry objects");
+            }
+            objects.back().geometries.push_back(std::move(geoJSON->get<Geometry>()));
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    optional<GeoJSON> build(Object&& object) {
+        if (object.type.empty()) {
+            fail("GeoJSON objects must have a type");
+            return {};
+        } else if (object.type == "FeatureCollection") {
+            return GeoJSON(std::move(object.features));
+        } else if (object.type == "Feature") {
+            Feature feature(object.geometry ? std::move(*object.geometry) : Geometry(GeometryCollection()));
+            feature.properties = std::move(object.properties);
+            feature.id = std::move(object.id);
+            return GeoJSON(std::move(feature));
+        } else if (object.type == "GeometryCollection") {
+            return GeoJSON(Geometry(std::move(object.geometries)));
+        }
+
+        optional<Geometry> geometry = buildGeometry(std::move(object));
+        if (!geometry) {
+            return {};
+        }
+        return GeoJSON(std::move(*geometry));
+    }
+
+    optional<Geometry> buildGeometry(Object&& object) {
+        uint8_t level;
+        if (object.type == "Point") {
+            level = 1;
+        } else if (object.type == "MultiPoint" || object.type == "LineString") {
+            level = 2;
+        } else if (object.type == "Polygon" || object.type == "MultiLineString") {
+            level = 3;
+        } else if (object.type == "MultiPolygon") {
+            level = 4;
+        } else {
+            fail("unknown GeoJSON type " + object.type);
+            return {};
+        }
+
+        if (!object.hasCoordinates) {
+            fail(object.type + " geometry must have coordinates");
+            return {};
+        }
+
+        // Every array above the positions must hold only arrays of the next level.
+        bool consistent = !object.positionLevel || object.positionLevel == level;
+        for (uint8_t l = 1; l < object.sizes.size(); l++) {
+            std::size_t elements = 0;
+            for (std::size_t size : object.sizes[l]) {
+                elements += size;
+            }
+            if (l >= level) {
+                consistent &= object.sizes[l].empty();
+            } else if (l + 1 == level) {
+                consistent &= elements == object.points.size();
+            } else {
+                consistent &= elements == object.sizes[l + 1].size();
+            }
+        }
+        if (!consistent || (level == 1 && object.points.size() != 1)) {
+            fail(object.type + " geometry has malformed coordinates");
+            return {};
+        }
+
+        auto& points = object.points;
+        std::size_t next = 0;
+        auto take = [&] (std::size_t count) {
+            next += count;
+            return std::make_pair(points.begin() + (next - count), points.begin() + next);
+        };
+
+        if (object.type == "Point") {
+            return Geometry(points.front());
+        } else if (object.type == "MultiPoint") {
+            return Geometry(mapbox::geometry::multi_point<double>(points.begin(), points.end()));
+        } else if (object.type == "LineString") {
+            return Geometry(std::move(points));
+        } else if (object.type == "Polygon") {
+            mapbox::geometry::polygon<double> polygon;
+            for (std::size_t size : object.sizes[2]) {
+                auto range = take(size);
+                polygon.emplace_back(range.first, range.second);
+            }
+            return Geometry(std::move(polygon));
+        } else if (object.type == "MultiLineString") {
+            mapbox::geometry::multi_line_string<double> lines;
+            for (std::size_t size : object.sizes[2]) {
+                auto range = take(size);
+                lines.emplace_back(range.first, range.second);
+            }
+            return Geometry(std::move(lines));
+        } else {
+            mapbox::geometry::multi_polygon<double> polygons;
+            std::size_t ring = 0;
+            for (std::size_t rings : object.sizes[2]) {
+                mapbox::geometry::polygon<double> polygon;
+                for (std::size_t i = 0; i < rings; i++) {
+                    auto range = take(object.sizes[3][ring++]);
+                    polygon.emplace_back(range.first, range.second);
+                }
+                polygons.push_back(std::move(polygon));
+            }
+            return Geometry(std::move(polygons));
+        }
+    }
+};
+
+} // namespace
+
+conversion::Result<GeoJSON> readGeoJSON(const std::string& json) {
+    Handler handler;
+    rapidjson::Reader reader;
+    rapidjson::StringStream stream(json.c_str());
+    const rapidjson::ParseResult parsed = reader.Parse(stream, handler);
+
+    if (!handler.error.empty()) {
+        return conversion::Error { handler.error };
+    }
+
+    if (parsed.IsError()) {
+        std::stringstream message;
+        message << parsed.Offset() << " - " << rapidjson::GetParseError_En(parsed.Code());
+        throw std::runtime_error(message.str());
+    }
+
+    return std::move(*handler.result);
+}
+
+} // namespace style
+} // namespace mbgl
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <mbgl/style/conversion.hpp>
+#include <mbgl/util/geojson.hpp>
+
+#include <string>
+
+namespace mbgl {
+namespace style {
+
+// Reads GeoJSON text straight into geometry with a streaming (SAX) parser, so that no JSON
+// document is built alongside the result. Throws std::runtime_error if the text is not valid
+// JSON, and returns an error if it is valid JSON but not valid GeoJSON.
+conversion::Result<GeoJSON> readGeoJSON(const std::string&);
+
+} // namespace style
+} // namespace mbgl
@@ -1,34 +1,19 @@
-#include <mbgl/util/logging.hpp>
 #include <mbgl/storage/file_source.hpp>
-#include <mbgl/style/conversion/geojson.hpp>
 #include <mbgl/style/source_observer.hpp>
 #include <mbgl/style/sources/geojson_source_impl.hpp>
 #include <mbgl/tile/geojson_tile.hpp>
-#include <mbgl/util/rapidjson.hpp>
+#include <mbgl/actor/mailbox.hpp>
+#include <mbgl/util/run_loop.hpp>
+#include <mbgl/util/projection.hpp>
+#include <mbgl/util/constants.hpp>
 
-#include <mapbox/geojson.hpp>
-#include <mapbox/geojson/rapidjson.hpp>
 #include <mapbox/geojsonvt.hpp>
-#include <mapbox/geojsonvt/convert.hpp>
 #include <supercluster.hpp>
 
-#include <rapidjson/error/en.h>
-
-#include <sstream>
+#include <cmath>
 
 namespace mbgl {
 namespace style {
-namespace conversion {
-
-template <>
-Result<GeoJSON> convertGeoJSON(const JSValue& value) {
-    try {
-        return mapbox::geojson::convert(value);
-    } catch (const std::exception& ex) {
-        return Error{ ex.what() };
-    }
-}
-} // namespace conversion
 
 GeoJSONSource::Impl::Impl(std::string id_, Source& base_, const GeoJSONOptions options_)
     : Source::Impl(SourceType::GeoJSON, std::move(id_), base_), options(options_) {
@@ -38,11 +23,20 @@ GeoJSONSource::Impl::~Impl() = default;
 
 void GeoJSONSource::Impl::setURL(std::string url_) {
     url = std::move(url_);
+    observer->onSourceChanged(base);
+
+    // Updates made so far were meant for the previous data.
+    hasData = false;
+    pendingUpdates.clear();
 
     // Signal that the source description needs a reload
-    if (loaded || req) {
+    if (loaded || req || indexing) {
         loaded = false;
         req.reset();
+        // Discard any result the worker is still producing for the previous data.
+        ++correlationID;
+        indexing = false;
+        pendingChanges = {};
         observer->onSourceDescriptionChanged(base);
     }
 }
@@ -51,49 +45,59 @@ optional<std::string> GeoJSONSource::Impl::getURL() const {
     return url;
 }
 
-
 void GeoJSONSource::Impl::setGeoJSON(const GeoJSON& geoJSON) {
     req.reset();
-    _setGeoJSON(geoJSON);
-}
+    observer->onSourceChanged(base);
 
-// Private implementation
-void GeoJSONSource::Impl::_setGeoJSON(const GeoJSON& geoJSON) {
-    double scale = util::EXTENT / util::tileSize;
+    pendingUpdates.clear();
 
-    cache.clear();
+    if (!worker) {
+        pendingGeoJSON = geoJSON;
+        return;
+    }
 
-    if (options.cluster
-        && geoJSON.is<mapbox::geometry::feature_collection<double>>()
-        && !geoJSON.get<mapbox::geometry::feature_collection<double>>().empty()) {
-        mapbox::supercluster::Options clusterOptions;
-        clusterOptions.maxZoom = options.clusterMaxZoom;
-        clusterOptions.extent = util::EXTENT;
-        clusterOptions.radius = std::round(scale * options.clusterRadius);
+    hasData = true;
+    indexing = true;
+    worker->invoke(&GeoJSONSourceWorker::setGeoJSON, geoJSON, ++correlationID);
+}
 
-        const auto& features = geoJSON.get<mapbox::geometry::feature_collection<double>>();
-        geoJSONOrSupercluster =
-            std::make_unique<mapbox::supercluster::Supercluster>(features, clusterOptions);
-    } else {
-        mapbox::geojsonvt::Options vtOptions;
-        vtOptions.maxZoom = options.maxzoom;
-        vtOptions.extent = util::EXTENT;
-        vtOptions.buffer = std::round(scale * options.buffer);
-        vtOptions.tolerance = scale * options.tolerance;
-        geoJSONOrSupercluster = std::make_unique<mapbox::geojsonvt::GeoJSONVT>(geoJSON, vtOptions);
+void GeoJSONSource::Impl::updateFeatures(const FeatureCollection& features) {
+    observer->onSourceChanged(base);
+
+    if (!hasData) {
+        pendingUpdates.push_back([this, features] {
+            worker->invoke(&GeoJSONSourceWorker::updateFeatures, features, ++correlationID);
+        });
+        return;
     }
 
-    for (auto const &item : tiles) {
-        GeoJSONTile* geoJSONTile = static_cast<GeoJSONTile*>(item.second.get());
-        setTileData(*geoJSONTile, geoJSONTile->id);
+    worker->invoke(&GeoJSONSourceWorker::updateFeatures, features, ++correlationID);
+}
+
+void GeoJSONSource::Impl::removeFeatures(const std::vector<FeatureIdentifier>& ids) {
+    observer->onSourceChanged(base);
+
+    if (!hasData) {
+        pendingUpdates.push_back([this, ids] {
+            worker->invoke(&GeoJSONSourceWorker::removeFeatures, ids, ++correlationID);
+        });
+        return;
     }
+
+    worker->invoke(&GeoJSONSourceWorker::removeFeatures, ids, ++correlationID);
 }
 
 void GeoJSONSource::Impl::setTileData(GeoJSONTile& tile, const OverscaledTileID& tileID) {
     if (geoJSONOrSupercluster.is<GeoJSONVTPointer>()) {
-        tile.updateData(geoJSONOrSupercluster.get<GeoJSONVTPointer>()->getTile(tileID.canonical.z,
-                                                                               tileID.canonical.x,
-                                                                               tileID.canonical.y).features);
+        const auto& geoJSONVT = geoJSONOrSupercluster.get<GeoJSONVTPointer>();
+        if (!geoJSONVT) {
+            // No data has been indexed yet.
+            tile.updateData({});
+            return;
+        }
+        tile.updateData(geoJSONVT->getTile(tileID.canonical.z,
+                                           tileID.canonical.x,
+                                           tileID.canonical.y).features);
     } else {
         assert(geoJSONOrSupercluster.is<SuperclusterPointer>());
         tile.updateData(geoJSONOrSupercluster.get<SuperclusterPointer>()->getTile(tileID.canonical.z,
@@ -102,8 +106,41 @@ void GeoJSONSource::Impl::setTileData(GeoJSONTile& tile, const OverscaledTileID&
     }
 }
 
-void GeoJSONSource::Impl::loadDescription(FileSource& fileSource) {
+void GeoJSONSource::Impl::startWorker(Scheduler& scheduler) {
+    mailbox = std::make_shared<Mailbox>(*util::RunLoop::Get());
+    worker = std::make_unique<Actor<GeoJSONSourceWorker>>(
+        scheduler, ActorRef<GeoJSONSource::Impl>(*this, mailbox), options);
+}
+
+void GeoJSONSource::Impl::flushPendingUpdates() {
+    for (const auto& update : pendingUpdates) {
+        update();
+    }
+    pendingUpdates.clear();
+}
+
+void GeoJSONSource::Impl::loadDescription(FileSource& fileSource, Scheduler& scheduler) {
+    if (!worker) {
+        startWorker(scheduler);
+    }
+
+    // Data is already being indexed; the source is loaded once the worker replies.
+    if (indexing) {
+        return;
+    }
+
+    if (pendingGeoJSON) {
+        indexing = true;
+        worker->invoke(&GeoJSONSourceWorker::setGeoJSON, std::move(*pendingGeoJSON), ++correlationID);
+        pendingGeoJSON = {};
+        hasData = true;
+        flushPendingUpdates();
+        return;
+    }
+
     if (!url) {
+        hasData = true;
+        flushPendingUpdates();
         loaded = true;
         return;
     }
@@ -122,35 +159,93 @@ void GeoJSONSource::Impl::loadDescription(FileSource& fileSource) {
             observer->onSourceError(
                 base, std::make_exception_ptr(std::runtime_error("unexpectedly empty GeoJSON")));
         } else {
-            rapidjson::GenericDocument<rapidjson::UTF8<>, rapidjson::CrtAllocator> d;
-            d.Parse<0>(res.data->c_str());
-
-            if (d.HasParseError()) {
-                std::stringstream message;
-                message << d.GetErrorOffset() << " - "
-                        << rapidjson::GetParseError_En(d.GetParseError());
-                observer->onSourceError(base,
-                                        std::make_exception_ptr(std::runtime_error(message.str())));
-                return;
-            }
+            indexing = true;
+            worker->invoke(&GeoJSONSourceWorker::parse, res.data, ++correlationID);
+            hasData = true;
+            flushPendingUpdates();
+        }
+    });
+}
 
-            invalidateTiles();
-
-            conversion::Result<GeoJSON> geoJSON = conversion::convertGeoJSON<JSValue>(d);
-            if (!geoJSON) {
-                Log::Error(Event::ParseStyle, "Failed to parse GeoJSON data: %s",
-                           geoJSON.error().message.c_str());
-                // Create an empty GeoJSON VT object to make sure we're not infinitely waiting for
-                // tiles to load.
-                _setGeoJSON(GeoJSON{ FeatureCollection{} });
-            } else {
-                _setGeoJSON(*geoJSON);
-            }
+bool GeoJSONSource::Impl::isAffected(const CanonicalTileID& tileID, const LatLngBounds& changedArea) const {
+    // geojson-vt includes features within a buffer around each tile.
+    const double scale = std::pow(2.0, tileID.z);
+    const double buffer = double(options.buffer) / util::tileSize;
+    const LatLng sw = Projection::unproject({ (tileID.x - buffer) * util::tileSize,
+                                              (tileID.y + 1 + buffer) * util::tileSize }, scale);
+    const LatLng ne = Projection::unproject({ (tileID.x + 1 + buffer) * util::tileSize,
+                                              (tileID.y - buffer) * util::tileSize }, scale);
+
+    if (LatLngBounds::hull(sw, ne).intersects(changedArea)) {
+        return true;
+    }
+
+    // Buffers that extend past the antimeridian contain features from the other side.
+    if (sw.longitude < -util::LONGITUDE_MAX) {
+        return LatLngBounds::hull({ sw.latitude, sw.longitude + util::DEGREES_MAX },
+                                  { ne.latitude, ne.longitude + util::DEGREES_MAX }).intersects(changedArea);
+    }
+    if (ne.longitude > util::LONGITUDE_MAX) {
+        return LatLngBounds::hull({ sw.latitude, sw.longitude - util::DEGREES_MAX },
+                                  { ne.latitude, ne.longitude - util::DEGREES_MAX }).intersects(changedArea);
+    }
+
+    return false;
+}
+
+void GeoJSONSource::Impl::onIndexed(GeoJSONIndex index,
+                                    optional<LatLngBounds> changedArea,
+                                    uint64_t resultCorrelationID) {
+    if (!changedArea) {
+        pendingChanges = {};
+    } else if (pendingChanges) {
+        pendingChanges->extend(*changedArea);
+    }
+
+    if (resultCorrelationID != correlationID) {
+        return;
+    }
+
+    indexing = false;
+    geoJSONOrSupercluster = std::move(index);
 
-            loaded = true;
-            observer->onSourceLoaded(base);
+    if (pendingChanges) {
+        // Only tiles overlapping the changed features need new data.
+        const LatLngBounds area = *pendingChanges;
+        if (!area.isEmpty()) {
+            cache.remove([&] (const OverscaledTileID& tileID) {
+                return isAffected(tileID.canonical, area);
+            });
+            for (auto const &item : tiles) {
+                GeoJSONTile* geoJSONTile = static_cast<GeoJSONTile*>(item.second.get());
+                if (isAffected(geoJSONTile->id.canonical, area)) {
+                    setTileData(*geoJSONTile, geoJSONTile->id);
+                }
+            }
         }
-    });
+    } else {
+        cache.clear();
+        for (auto const &item : tiles) {
+            GeoJSONTile* geoJSONTile = static_cast<GeoJSONTile*>(item.second.get());
+            setTileData(*geoJSONTile, geoJSONTile->id);
+        }
+    }
+
+    pendingChanges = LatLngBounds::empty();
+
+    if (!loaded) {
+        loaded = true;
+        observer->onSourceLoaded(base);
+    }
+}
+
+void GeoJSONSource::Impl::onError(std::exception_ptr error, uint64_t resultCorrelationID) {
+    if (resultCorrelationID != correlationID) {
+        return;
+    }
+
+    indexing = false;
+    observer->onSourceError(base, error);
 }
 
 Range<uint8_t> GeoJSONSource::Impl::getZoomRange() {
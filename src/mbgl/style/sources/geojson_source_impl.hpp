@@ -2,12 +2,18 @@
 
 #include <mbgl/style/source_impl.hpp>
 #include <mbgl/style/sources/geojson_source.hpp>
-#include <mbgl/util/variant.hpp>
+#include <mbgl/style/sources/geojson_source_worker.hpp>
 #include <mbgl/tile/geojson_tile.hpp>
+#include <mbgl/actor/actor.hpp>
+#include <mbgl/util/optional.hpp>
+
+#include <functional>
+#include <vector>
 
 namespace mbgl {
 
 class AsyncRequest;
+class Mailbox;
 
 namespace style {
 
@@ -20,16 +26,24 @@ public:
     optional<std::string> getURL() const;
 
     void setGeoJSON(const GeoJSON&);
+    void updateFeatures(const FeatureCollection&);
+    void removeFeatures(const std::vector<FeatureIdentifier>&);
     void setTileData(GeoJSONTile&, const OverscaledTileID& tileID);
 
-    void loadDescription(FileSource&) final;
+    void loadDescription(FileSource&, Scheduler&) final;
 
     uint16_t getTileSize() const final {
         return util::tileSize;
     }
 
+    // Replies from the worker. Results for data that has since been replaced are discarded.
+    void onIndexed(GeoJSONIndex, optional<LatLngBounds> changedArea, uint64_t correlationID);
+    void onError(std::exception_ptr, uint64_t correlationID);
+
 private:
-    void _setGeoJSON(const GeoJSON&);
+    void startWorker(Scheduler&);
+    void flushPendingUpdates();
+    bool isAffected(const CanonicalTileID&, const LatLngBounds& changedArea) const;
 
     Range<uint8_t> getZoomRange() final;
     std::unique_ptr<Tile> createTile(const OverscaledTileID&, const UpdateParameters&) final;
@@ -37,7 +51,28 @@ private:
     GeoJSONOptions options;
     optional<std::string> url;
     std::unique_ptr<AsyncRequest> req;
-    variant<GeoJSONVTPointer, SuperclusterPointer> geoJSONOrSupercluster;
+
+    // The index tiles are currently built from. It is only replaced once the worker has
+    // finished indexing new data, so tiles keep rendering the previous data until then.
+    GeoJSONIndex geoJSONOrSupercluster;
+
+    // Data set and feature updates made before the worker had the data they apply to; handed
+    // to the worker once it exists, and the updates once the data (set or fetched) follows.
+    optional<GeoJSON> pendingGeoJSON;
+    std::vector<std::function<void ()>> pendingUpdates;
+    bool hasData = false;
+
+    // The area whose tiles need new data once the latest result arrives. Unset if every tile
+    // does. Results that are superseded before they arrive still contribute to it.
+    optional<LatLngBounds> pendingChanges;
+
+    std::shared_ptr<Mailbox> mailbox;
+    std::unique_ptr<Actor<GeoJSONSourceWorker>> worker;
+    uint64_t correlationID = 0;
+
+    // Whether the worker has yet to reply to the latest data or update it was given. The
+    // source only becomes loaded once it has.
+    bool indexing = false;
 };
 
 } // namespace style
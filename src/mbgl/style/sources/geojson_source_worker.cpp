@@ -0,0 +1,175 @@
+#include <mbgl/style/sources/geojson_source_worker.hpp>
+#include <mbgl/style/sources/geojson_source_impl.hpp>
+#include <mbgl/style/sources/geojson_reader.hpp>
+#include <mbgl/style/conversion/geojson.hpp>
+#include <mbgl/util/constants.hpp>
+#include <mbgl/util/logging.hpp>
+#include <mbgl/util/rapidjson.hpp>
+
+#include <mapbox/geojson.hpp>
+#include <mapbox/geojson/rapidjson.hpp>
+#include <mapbox/geojsonvt.hpp>
+#include <mapbox/geojsonvt/convert.hpp>
+#include <mapbox/geometry/envelope.hpp>
+#include <supercluster.hpp>
+
+#include <cmath>
+
+namespace mbgl {
+namespace style {
+namespace conversion {
+
+template <>
+Result<GeoJSON> convertGeoJSON(const JSValue& value) {
+    try {
+        return mapbox::geojson::convert(value);
+    } catch (const std::exception& ex) {
+        return Error{ ex.what() };
+    }
+}
+} // namespace conversion
+
+namespace {
+
+void extend(LatLngBounds& area, const Feature& feature) {
+    const auto box = mapbox::geometry::envelope(feature.geometry);
+    if (box.min.x <= box.max.x) { // Empty geometries have an inverted envelope.
+        area.extend(LatLngBounds::hull({ box.min.y, box.min.x }, { box.max.y, box.max.x }));
+    }
+}
+
+} // namespace
+
+GeoJSONSourceWorker::GeoJSONSourceWorker(ActorRef<GeoJSONSourceWorker>,
+                                         ActorRef<GeoJSONSource::Impl> parent_,
+                                         GeoJSONOptions options_)
+    : parent(std::move(parent_)),
+      options(std::move(options_)) {
+}
+
+void GeoJSONSourceWorker::parse(std::shared_ptr<const std::string> data, uint64_t correlationID) {
+    try {
+        conversion::Result<GeoJSON> geoJSON = readGeoJSON(*data);
+
+        // The text isn't needed while indexing.
+        data.reset();
+
+        if (!geoJSON) {
+            Log::Error(Event::ParseStyle, "Failed to parse GeoJSON data: %s",
+                       geoJSON.error().message.c_str());
+            // Create an empty GeoJSON VT object to make sure we're not infinitely waiting for
+            // tiles to load.
+            setGeoJSON(GeoJSON{ FeatureCollection{} }, correlationID);
+        } else {
+            setGeoJSON(std::move(*geoJSON), correlationID);
+        }
+    } catch (...) {
+        parent.invoke(&GeoJSONSource::Impl::onError, std::current_exception(), correlationID);
+    }
+}
+
+void GeoJSONSourceWorker::setGeoJSON(GeoJSON geoJSON, uint64_t correlationID) {
+    features = geoJSON.match(
+        [&] (FeatureCollection& collection) { return std::move(collection); },
+        [&] (Feature& feature) { return FeatureCollection{ std::move(feature) }; },
+        [&] (mapbox::geometry::geometry<double>& geometry) { return FeatureCollection{ Feature{ std::move(geometry) } }; });
+
+    featureIndices.clear();
+    for (std::size_t i = 0; i < features.size(); i++) {
+        if (features[i].id) {
+            featureIndices[*features[i].id] = i;
+        }
+    }
+
+    index({}, correlationID);
+}
+
+void GeoJSONSourceWorker::updateFeatures(FeatureCollection updates, uint64_t correlationID) {
+    LatLngBounds changedArea = LatLngBounds::empty();
+
+    for (auto& feature : updates) {
+        extend(changedArea, feature);
+
+        if (feature.id) {
+            auto it = featureIndices.find(*feature.id);
+            if (it != featureIndices.end()) {
+                extend(changedArea, features[it->second]);
+                features[it->second] = std::move(feature);
+                continue;
+            }
+            featureIndices.emplace(*feature.id, features.size());
+        }
+
+        features.push_back(std::move(feature));
+    }
+
+    index(changedArea, correlationID);
+}
+
+void GeoJSONSourceWorker::removeFeatures(std::vector<FeatureIdentifier> ids, uint64_t correlationID) {
+    LatLngBounds changedArea = LatLngBounds::empty();
+    std::vector<bool> removed(features.size(), false);
+
+    for (const auto& id : ids) {
+        auto it = featureIndices.find(id);
+        if (it != featureIndices.end()) {
+            extend(changedArea, features[it->second]);
+            removed[it->second] = true;
+            featureIndices.erase(it);
+        }
+    }
+
+    // Compact the remaining features, preserving their order.
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < features.size(); i++) {
+        if (removed[i]) {
+            continue;
+        }
+        if (features[i].id) {
+            featureIndices[*features[i].id] = count;
+        }
+        if (count != i) {
+            features[count] = std::move(features[i]);
+        }
+        count++;
+    }
+    features.resize(count);
+
+    index(changedArea, correlationID);
+}
+
+void GeoJSONSourceWorker::index(optional<LatLngBounds> changedArea, uint64_t correlationID) {
+    // Clustering can move clusters anywhere, so every tile is affected.
+    if (options.cluster) {
+        changedArea = {};
+    }
+
+    try {
+        parent.invoke(&GeoJSONSource::Impl::onIndexed, createIndex(), changedArea, correlationID);
+    } catch (...) {
+        parent.invoke(&GeoJSONSource::Impl::onError, std::current_exception(), correlationID);
+    }
+}
+
+GeoJSONIndex GeoJSONSourceWorker::createIndex() const {
+    double scale = util::EXTENT / util::tileSize;
+
+    if (options.cluster && !features.empty()) {
+        mapbox::supercluster::Options clusterOptions;
+        clusterOptions.maxZoom = options.clusterMaxZoom;
+        clusterOptions.extent = util::EXTENT;
+        clusterOptions.radius = std::round(scale * options.clusterRadius);
+
+        return std::make_unique<mapbox::supercluster::Supercluster>(features, clusterOptions);
+    } else {
+        mapbox::geojsonvt::Options vtOptions;
+        vtOptions.maxZoom = options.maxzoom;
+        vtOptions.extent = util::EXTENT;
+        vtOptions.buffer = std::round(scale * options.buffer);
+        vtOptions.tolerance = scale * options.tolerance;
+        return std::make_unique<mapbox::geojsonvt::GeoJSONVT>(features, vtOptions);
+    }
+}
+
+} // namespace style
+} // namespace mbgl
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <mbgl/style/sources/geojson_source.hpp>
+#include <mbgl/actor/actor_ref.hpp>
+#include <mbgl/util/feature.hpp>
+#include <mbgl/util/geo.hpp>
+#include <mbgl/util/optional.hpp>
+#include <mbgl/util/variant.hpp>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace mbgl {
+namespace style {
+
+using GeoJSONIndex = variant<GeoJSONVTPointer, SuperclusterPointer>;
+
+// Parses GeoJSON and builds the geojson-vt or supercluster index for a GeoJSONSource on a
+// background scheduler, so that neither blocks the thread the map runs on.
+//
+// The worker retains the source's features so that individual features can be added,
+// replaced or removed by id. Each new index is reported together with the area covered by
+// the features that changed, or without one if every tile may be affected.
+class GeoJSONSourceWorker {
+public:
+    GeoJSONSourceWorker(ActorRef<GeoJSONSourceWorker>, ActorRef<GeoJSONSource::Impl>, GeoJSONOptions);
+
+    void parse(std::shared_ptr<const std::string> data, uint64_t correlationID);
+    void setGeoJSON(GeoJSON, uint64_t correlationID);
+    void updateFeatures(FeatureCollection, uint64_t correlationID);
+    void removeFeatures(std::vector<FeatureIdentifier>, uint64_t correlationID);
+
+private:
+    void index(optional<LatLngBounds> changedArea, uint64_t correlationID);
+    GeoJSONIndex createIndex() const;
+
+    ActorRef<GeoJSONSource::Impl> parent;
+    const GeoJSONOptions options;
+
+    FeatureCollection features;
+    std::map<FeatureIdentifier, std::size_t> featureIndices;
+};
+
+} // namespace style
+} // namespace mbgl
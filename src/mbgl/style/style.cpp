@@ -8,13 +8,22 @@
 #include <mbgl/style/layers/background_layer.hpp>
 #include <mbgl/style/layers/background_layer_impl.hpp>
 #include <mbgl/style/layers/fill_layer.hpp>
+#include <mbgl/style/layers/fill_layer_impl.hpp>
 #include <mbgl/style/layers/fill_extrusion_layer.hpp>
+#include <mbgl/style/layers/fill_extrusion_layer_impl.hpp>
 #include <mbgl/style/layers/line_layer.hpp>
+#include <mbgl/style/layers/line_layer_impl.hpp>
 #include <mbgl/style/layers/circle_layer.hpp>
+#include <mbgl/style/layers/circle_layer_impl.hpp>
 #include <mbgl/style/layers/raster_layer.hpp>
+#include <mbgl/style/layers/raster_layer_impl.hpp>
 #include <mbgl/style/layer_impl.hpp>
+#include <mbgl/style/group_by_layout.hpp>
 #include <mbgl/style/parser.hpp>
+#include <mbgl/style/parser_worker.hpp>
 #include <mbgl/style/query_parameters.hpp>
+#include <mbgl/style/rendered_query.hpp>
+#include <mbgl/style/source_query.hpp>
 #include <mbgl/style/transition_options.hpp>
 #include <mbgl/style/class_dictionary.hpp>
 #include <mbgl/style/update_parameters.hpp>
@@ -30,6 +39,8 @@
 #include <mbgl/util/string.hpp>
 #include <mbgl/util/logging.hpp>
 #include <mbgl/util/math.hpp>
+#include <mbgl/util/run_loop.hpp>
+#include <mbgl/actor/actor.hpp>
 #include <mbgl/math/minmax.hpp>
 
 #include <algorithm>
@@ -39,9 +50,10 @@ namespace style {
 
 static Observer nullObserver;
 
-Style::Style(FileSource& fileSource_, float pixelRatio)
-    : fileSource(fileSource_),
-      glyphAtlas(std::make_unique<GlyphAtlas>(Size{ 2048, 2048 }, fileSource)),
+Style::Style(Scheduler& scheduler_, FileSource& fileSource_, float pixelRatio)
+    : scheduler(scheduler_),
+      fileSource(fileSource_),
+      glyphAtlas(std::make_unique<GlyphAtlas>(Size{ 2048, 2048 }, fileSource, scheduler)),
       spriteAtlas(std::make_unique<SpriteAtlas>(Size{ 1024, 1024 }, pixelRatio)),
       lineAtlas(std::make_unique<LineAtlas>(Size{ 256, 512 })),
       observer(&nullObserver) {
@@ -100,15 +112,85 @@ TransitionOptions Style::getTransitionOptions() const {
 }
 
 void Style::setJSON(const std::string& json) {
+    // Supersede any pending asynchronous parse.
+    ++parseCorrelationID;
+
+    Parser parser;
+    load(parser, parser.parse(json));
+}
+
+void Style::setBinary(const std::string& binary) {
+    // Supersede any pending asynchronous parse.
+    ++parseCorrelationID;
+
+    Parser parser;
+    load(parser, parser.parseBinary(binary));
+}
+
+void Style::setJSONAsync(std::string json) {
+    if (!parserWorker) {
+        mailbox = std::make_shared<Mailbox>(*util::RunLoop::Get());
+        parserWorker = std::make_unique<Actor<ParserWorker>>(scheduler, ActorRef<Style>(*this, mailbox));
+    }
+
+    parserWorker->invoke(&ParserWorker::parse, std::move(json), ++parseCorrelationID);
+}
+
+void Style::onParsed(std::unique_ptr<Parser> parser, std::exception_ptr error, uint64_t correlationID) {
+    if (correlationID != parseCorrelationID) {
+        return;
+    }
+
+    load(*parser, error);
+}
+
+struct QueueSourceReloadVisitor {
+    UpdateBatch& updateBatch;
+
+    // No need to reload sources for these types; their visibility can change but
+    // they don't participate in layout.
+    void operator()(CustomLayer&) {}
+    void operator()(RasterLayer&) {}
+    void operator()(BackgroundLayer&) {}
+
+    template <class VectorLayer>
+    void operator()(VectorLayer& layer) {
+        updateBatch.sourceIDs.insert(layer.getSourceID());
+    }
+};
+
+// Gives a layer the paint properties of an otherwise identical layer of the same type.
+// Returns whether the change invalidates the layer's buckets.
+struct AdoptPaintPropertiesVisitor {
+    const Layer& next;
+
+    bool operator()(CustomLayer&) {
+        return false;
+    }
+
+    template <class PaintedLayer>
+    bool operator()(PaintedLayer& layer) {
+        const auto& nextPaint = next.as<PaintedLayer>()->impl->paint;
+        const bool invalidatesBuckets = layer.impl->paint.dataDrivenPropertiesDiffer(nextPaint);
+        layer.impl->paint.cascading = nextPaint.cascading;
+        return invalidatesBuckets;
+    }
+};
+
+void Style::load(Parser& parser, std::exception_ptr error) {
+    // When replacing a loaded style, sources and layers that the new style leaves unchanged
+    // are carried over along with their tiles and buckets.
+    auto previousSources = std::move(sources);
+    auto previousLayers = std::move(layers);
+    auto previousSourceDefinitions = std::move(sourceDefinitions);
+
     sources.clear();
     layers.clear();
+    sourceDefinitions.clear();
     classes.clear();
     transitionOptions = {};
     updateBatch = {};
 
-    Parser parser;
-    auto error = parser.parse(json);
-
     if (error) {
         Log::Error(Event::ParseStyle, "Failed to parse style: %s", util::toString(error).c_str());
         observer->onStyleError();
@@ -117,13 +199,54 @@ void Style::setJSON(const std::string& json) {
     }
 
     for (auto& source : parser.sources) {
-        addSource(std::move(source));
+        const std::string id = source->getID();
+        const std::string& definition = parser.sourceDefinitions[id];
+
+        auto previous = std::find_if(previousSources.begin(), previousSources.end(), [&](const auto& existing) {
+            return existing && existing->getID() == id;
+        });
+
+        if (previous != previousSources.end() && previousSourceDefinitions[id] == definition) {
+            addSource(std::move(*previous));
+        } else {
+            addSource(std::move(source));
+        }
+
+        sourceDefinitions.emplace(id, definition);
     }
 
     for (auto& layer : parser.layers) {
+        auto previous = std::find_if(previousLayers.begin(), previousLayers.end(), [&](const auto& existing) {
+            return existing && existing->getID() == layer->getID();
+        });
+
+        if (previous != previousLayers.end()) {
+            std::unique_ptr<Layer> existing = std::move(*previous);
+
+            if (layoutKey(*existing) == layoutKey(*layer)) {
+                // Only paint properties can differ. Keep the existing layer, which preserves
+                // in-progress transitions, and relayout only if its buckets are affected.
+                if (existing->accept(AdoptPaintPropertiesVisitor { *layer })) {
+                    existing->accept(QueueSourceReloadVisitor { updateBatch });
+                }
+                addLayer(std::move(existing));
+                continue;
+            }
+
+            existing->accept(QueueSourceReloadVisitor { updateBatch });
+        }
+
+        layer->accept(QueueSourceReloadVisitor { updateBatch });
         addLayer(std::move(layer));
     }
 
+    // Removed layers' symbols still take part in placement until their sources are laid out again.
+    for (auto& layer : previousLayers) {
+        if (layer) {
+            layer->accept(QueueSourceReloadVisitor { updateBatch });
+        }
+    }
+
     name = parser.name;
     defaultLatLng = parser.latLng;
     defaultZoom = parser.zoom;
@@ -131,7 +254,11 @@ void Style::setJSON(const std::string& json) {
     defaultPitch = parser.pitch;
 
     glyphAtlas->setURL(parser.glyphURL);
-    spriteAtlas->load(parser.spriteURL, fileSource);
+
+    if (!loaded || parser.spriteURL != spriteURL) {
+        spriteURL = parser.spriteURL;
+        spriteAtlas->load(spriteURL, fileSource);
+    }
 
     loaded = true;
 
@@ -164,6 +291,7 @@ std::unique_ptr<Source> Style::removeSource(const std::string& id) {
 
     auto source = std::move(*it);
     sources.erase(it);
+    sourceDefinitions.erase(id);
     updateBatch.sourceIDs.erase(id);
 
     return source;
@@ -287,6 +415,34 @@ void Style::relayout() {
     updateBatch.sourceIDs.clear();
 }
 
+// Records what a freshly cascaded layer's evaluated properties depend on.
+struct EvaluationDependencyVisitor {
+    void operator()(CustomLayer& layer) {
+        layer.impl->cascaded = true;
+    }
+
+    void operator()(SymbolLayer& layer) {
+        setDependencies(layer);
+
+        // icon-size and text-size are evaluated along with the paint properties.
+        const auto& layout = layer.impl->layout.unevaluated;
+        layer.impl->zoomDependent |= layout.get<IconSize>().evaluate(ZoomDependenceVisitor())
+                                  || layout.get<TextSize>().evaluate(ZoomDependenceVisitor());
+    }
+
+    template <class PaintedLayer>
+    void operator()(PaintedLayer& layer) {
+        setDependencies(layer);
+    }
+
+    template <class PaintedLayer>
+    void setDependencies(PaintedLayer& layer) {
+        layer.impl->cascaded = true;
+        layer.impl->zoomDependent = layer.impl->paint.isZoomDependent();
+        layer.impl->timeDependent = layer.impl->paint.isTimeDependent();
+    }
+};
+
 void Style::cascade(const TimePoint& timePoint, MapMode mode) {
     // When in continuous mode, we can either have user- or style-defined
     // transitions. Still mode is always immediate.
@@ -306,6 +462,7 @@ void Style::cascade(const TimePoint& timePoint, MapMode mode) {
 
     for (const auto& layer : layers) {
         layer->baseImpl->cascade(parameters);
+        layer->accept(EvaluationDependencyVisitor {});
     }
 }
 
@@ -316,6 +473,9 @@ void Style::recalculate(float z, const TimePoint& timePoint, MapMode mode) {
         source->baseImpl->enabled = false;
     }
 
+    const bool zoomChanged = !evaluatedZoom || *evaluatedZoom != z;
+    evaluatedZoom = z;
+
     zoomHistory.update(z, timePoint);
 
     const PropertyEvaluationParameters parameters {
@@ -327,7 +487,7 @@ void Style::recalculate(float z, const TimePoint& timePoint, MapMode mode) {
 
     hasPendingTransitions = false;
     for (const auto& layer : layers) {
-        const bool hasTransitions = layer->baseImpl->evaluate(parameters);
+        const bool hasTransitions = layer->baseImpl->evaluateIfNeeded(parameters, zoomChanged);
 
         // Disable this layer if it doesn't need to be rendered.
         const bool needsRendering = layer->baseImpl->needsRendering(zoomHistory.lastZoom);
@@ -341,7 +501,7 @@ void Style::recalculate(float z, const TimePoint& timePoint, MapMode mode) {
         if (Source* source = getSource(layer->baseImpl->source)) {
             source->baseImpl->enabled = true;
             if (!source->baseImpl->loaded) {
-                source->baseImpl->loadDescription(fileSource);
+                source->baseImpl->loadDescription(fileSource, scheduler);
             }
         }
     }
@@ -503,6 +663,17 @@ RenderData Style::getRenderData(MapDebugOptions debugOptions, float angle) const
 }
 
 std::vector<Feature> Style::queryRenderedFeatures(const QueryParameters& parameters) const {
+    std::vector<LazyFeature> features = queryRenderedFeaturesLazy(parameters);
+
+    std::vector<Feature> result;
+    result.reserve(features.size());
+    for (const auto& feature : features) {
+        result.push_back(feature.toFeature());
+    }
+    return result;
+}
+
+std::vector<LazyFeature> Style::queryRenderedFeaturesLazy(const QueryParameters& parameters) const {
     std::unordered_set<std::string> sourceFilter;
 
     if (parameters.layerIDs) {
@@ -512,15 +683,21 @@ std::vector<Feature> Style::queryRenderedFeatures(const QueryParameters& paramet
         }
     }
 
-    std::vector<Feature> result;
-    std::unordered_map<std::string, std::vector<Feature>> resultsByLayer;
+    std::vector<LazyFeature> result;
+    std::unordered_map<std::string, std::vector<LazyFeature>> resultsByLayer;
+
+    QueryLayers queryLayers;
+    queryLayers.radius = getQueryRadius();
+    for (const auto& layer : layers) {
+        queryLayers.layers.emplace(layer->baseImpl->id, layer.get());
+    }
 
     for (const auto& source : sources) {
         if (!sourceFilter.empty() && sourceFilter.find(source->getID()) == sourceFilter.end()) {
             continue;
         }
 
-        auto sourceResults = source->baseImpl->queryRenderedFeatures(parameters);
+        auto sourceResults = source->baseImpl->queryRenderedFeatures(parameters, queryLayers);
         std::move(sourceResults.begin(), sourceResults.end(), std::inserter(resultsByLayer, resultsByLayer.begin()));
     }
 
@@ -542,6 +719,51 @@ std::vector<Feature> Style::queryRenderedFeatures(const QueryParameters& paramet
     return result;
 }
 
+std::unique_ptr<AsyncRequest> Style::queryRenderedFeatures(const QueryParameters& parameters,
+                                                           std::function<void (std::vector<Feature>)> callback) const {
+    // Only layers that are rendered can contribute results, so only those are copied for the
+    // workers, and only their sources are queried.
+    std::vector<std::unique_ptr<Layer>> queriedLayers;
+    std::unordered_set<std::string> sourceFilter;
+
+    for (const auto& layer : layers) {
+        if (!layer->baseImpl->needsRendering(zoomHistory.lastZoom)) {
+            continue;
+        }
+        if (parameters.layerIDs &&
+            std::find(parameters.layerIDs->begin(), parameters.layerIDs->end(), layer->baseImpl->id) == parameters.layerIDs->end()) {
+            continue;
+        }
+        sourceFilter.emplace(layer->baseImpl->source);
+        queriedLayers.push_back(layer->baseImpl->clone());
+    }
+
+    std::vector<TileQuery> tileQueries;
+    for (const auto& source : sources) {
+        if (sourceFilter.find(source->getID()) != sourceFilter.end()) {
+            source->baseImpl->snapshotQueriedTiles(parameters, tileQueries);
+        }
+    }
+
+    return std::make_unique<RenderedQuery>(scheduler, parameters, std::move(queriedLayers),
+                                           std::move(tileQueries), std::move(callback));
+}
+
+std::unique_ptr<AsyncRequest> Style::querySourceFeatures(const std::string& sourceID,
+                                                         const SourceQueryOptions& options,
+                                                         std::function<void (std::vector<Feature>)> callback) const {
+    std::vector<SourceTileQuery> tileQueries;
+
+    auto it = std::find_if(sources.begin(), sources.end(), [&](const auto& source) {
+        return source->getID() == sourceID;
+    });
+    if (it != sources.end()) {
+        (*it)->baseImpl->snapshotSourceTiles(options, tileQueries);
+    }
+
+    return std::make_unique<SourceQuery>(scheduler, options, std::move(tileQueries), std::move(callback));
+}
+
 float Style::getQueryRadius() const {
     float additionalRadius = 0;
     for (auto& layer : layers) {
@@ -603,10 +825,16 @@ void Style::onSourceError(Source& source, std::exception_ptr error) {
 void Style::onSourceDescriptionChanged(Source& source) {
     observer->onSourceDescriptionChanged(source);
     if (!source.baseImpl->loaded) {
-        source.baseImpl->loadDescription(fileSource);
+        source.baseImpl->loadDescription(fileSource, scheduler);
     }
 }
 
+void Style::onSourceChanged(Source& source) {
+    observer->onSourceChanged(source);
+    // Replacing the style must not keep the source just because its definition is unchanged.
+    sourceDefinitions.erase(source.getID());
+}
+
 void Style::onTileChanged(Source& source, const OverscaledTileID& tileID) {
     observer->onTileChanged(source, tileID);
     observer->onUpdate(Update::Repaint);
@@ -633,21 +861,6 @@ void Style::onSpriteError(std::exception_ptr error) {
     observer->onResourceError(error);
 }
 
-struct QueueSourceReloadVisitor {
-    UpdateBatch& updateBatch;
-
-    // No need to reload sources for these types; their visibility can change but
-    // they don't participate in layout.
-    void operator()(CustomLayer&) {}
-    void operator()(RasterLayer&) {}
-    void operator()(BackgroundLayer&) {}
-
-    template <class VectorLayer>
-    void operator()(VectorLayer& layer) {
-        updateBatch.sourceIDs.insert(layer.getSourceID());
-    }
-};
-
 void Style::onLayerFilterChanged(Layer& layer) {
     layer.accept(QueueSourceReloadVisitor { updateBatch });
     observer->onUpdate(Update::Layout);
@@ -675,6 +888,7 @@ void Style::onLayerLayoutPropertyChanged(Layer& layer, const char * property) {
     // Recalculate the style for certain properties
     bool needsRecalculation = strcmp(property, "icon-size") == 0 || strcmp(property, "text-size") == 0;
     if (needsRecalculation) {
+        layer.accept(EvaluationDependencyVisitor {});
         update |= Update::RecalculateStyle;
     }
     observer->onUpdate(update);
@@ -686,6 +900,7 @@ void Style::dumpDebugLogs() const {
     }
 
     spriteAtlas->dumpDebugLogs();
+    glyphAtlas->dumpDebugLogs();
 }
 
 } // namespace style
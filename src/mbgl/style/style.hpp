@@ -14,24 +14,34 @@
 #include <mbgl/util/chrono.hpp>
 #include <mbgl/util/optional.hpp>
 #include <mbgl/util/feature.hpp>
+#include <mbgl/util/lazy_feature.hpp>
 #include <mbgl/util/geo.hpp>
 
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace mbgl {
 
 class FileSource;
+class Scheduler;
+class Mailbox;
+template <class> class Actor;
 class GlyphAtlas;
 class SpriteAtlas;
 class LineAtlas;
 class RenderData;
+class AsyncRequest;
+struct SourceQueryOptions;
 
 namespace style {
 
 class Layer;
+class Parser;
+class ParserWorker;
 class UpdateParameters;
 class QueryParameters;
 
@@ -41,11 +51,20 @@ class Style : public GlyphAtlasObserver,
               public LayerObserver,
               public util::noncopyable {
 public:
-    Style(FileSource&, float pixelRatio);
+    Style(Scheduler&, FileSource&, float pixelRatio);
     ~Style() override;
 
     void setJSON(const std::string&);
 
+    // Like setJSON(), but for a style encoded with encodeBinaryStyle().
+    void setBinary(const std::string&);
+
+    // Like setJSON(), but parses the style and builds its sources and layers on the worker
+    // scheduler. The result replaces the style's contents in one step, after which the
+    // observer is notified as with setJSON(). Only the most recent request is applied.
+    void setJSONAsync(std::string);
+    void onParsed(std::unique_ptr<Parser>, std::exception_ptr, uint64_t correlationID);
+
     void setObserver(Observer*);
 
     bool isLoaded() const;
@@ -96,6 +115,18 @@ public:
     RenderData getRenderData(MapDebugOptions, float angle) const;
 
     std::vector<Feature> queryRenderedFeatures(const QueryParameters&) const;
+    std::vector<LazyFeature> queryRenderedFeaturesLazy(const QueryParameters&) const;
+
+    // Queries the tiles on the scheduler and calls back on this thread with the same features
+    // as the synchronous query. Destroying the returned request cancels the query.
+    std::unique_ptr<AsyncRequest> queryRenderedFeatures(const QueryParameters&,
+                                                        std::function<void (std::vector<Feature>)>) const;
+
+    // Reads the features of a source's loaded tiles that match the options on the scheduler,
+    // and calls back on this thread. Destroying the returned request cancels the query.
+    std::unique_ptr<AsyncRequest> querySourceFeatures(const std::string& sourceID,
+                                                      const SourceQueryOptions&,
+                                                      std::function<void (std::vector<Feature>)>) const;
 
     float getQueryRadius() const;
 
@@ -104,6 +135,7 @@ public:
 
     void dumpDebugLogs() const;
 
+    Scheduler& scheduler;
     FileSource& fileSource;
     std::unique_ptr<GlyphAtlas> glyphAtlas;
     std::unique_ptr<SpriteAtlas> spriteAtlas;
@@ -115,6 +147,11 @@ private:
     std::vector<std::string> classes;
     TransitionOptions transitionOptions;
 
+    // The style JSON definitions of the current sources, and the current sprite URL. Used
+    // to keep unchanged resources when one style replaces another.
+    std::unordered_map<std::string, std::string> sourceDefinitions;
+    std::string spriteURL;
+
     // Defaults
     std::string name;
     LatLng defaultLatLng;
@@ -122,6 +159,13 @@ private:
     double defaultBearing = 0;
     double defaultPitch = 0;
 
+    // Pending asynchronous parses, and the ID of the most recent one.
+    std::shared_ptr<Mailbox> mailbox;
+    std::unique_ptr<Actor<ParserWorker>> parserWorker;
+    uint64_t parseCorrelationID = 0;
+
+    void load(Parser&, std::exception_ptr);
+
     std::vector<std::unique_ptr<Layer>>::const_iterator findLayer(const std::string& layerID) const;
     void reloadLayerSource(Layer&);
     void updateSymbolDependentTiles();
@@ -139,6 +183,7 @@ private:
     void onSourceAttributionChanged(Source&, const std::string&) override;
     void onSourceError(Source&, std::exception_ptr) override;
     void onSourceDescriptionChanged(Source&) override;
+    void onSourceChanged(Source&) override;
     void onTileChanged(Source&, const OverscaledTileID&) override;
     void onTileError(Source&, const OverscaledTileID&, std::exception_ptr) override;
 
@@ -156,6 +201,7 @@ private:
 
     UpdateBatch updateBatch;
     ZoomHistory zoomHistory;
+    optional<float> evaluatedZoom;
     bool hasPendingTransitions = false;
 
 public:
@@ -24,7 +24,7 @@ public:
                    uint16_t tileSize);
     ~TileSourceImpl() override;
 
-    void loadDescription(FileSource&) final;
+    void loadDescription(FileSource&, Scheduler&) final;
 
     uint16_t getTileSize() const final {
         return tileSize;
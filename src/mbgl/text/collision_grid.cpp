@@ -0,0 +1,92 @@
+#include <mbgl/text/collision_grid.hpp>
+#include <mbgl/math/minmax.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace mbgl {
+
+CollisionGrid::CollisionGrid(const Bounds& area_, float cellSize)
+    : area(area_),
+      inverseCellSize(1.0f / cellSize),
+      columns(util::max(1, int32_t(std::ceil((area.x2 - area.x1) * inverseCellSize)))),
+      rows(util::max(1, int32_t(std::ceil((area.y2 - area.y1) * inverseCellSize)))),
+      cells(columns * rows) {
+}
+
+void CollisionGrid::insert(const CollisionBox& box, const Point<float>& anchor, const Bounds& bounds, uint32_t featureID) {
+    const Bounds cover {
+        util::min(bounds.x1, anchor.x),
+        util::min(bounds.y1, anchor.y),
+        util::max(bounds.x2, anchor.x),
+        util::max(bounds.y2, anchor.y)
+    };
+
+    maxOffsetX = util::max(maxOffsetX, anchor.x - cover.x1, cover.x2 - anchor.x);
+    maxOffsetY = util::max(maxOffsetY, anchor.y - cover.y1, cover.y2 - anchor.y);
+
+    const auto index = uint32_t(entries.size());
+    entries.emplace_back(box, bounds, cover, featureID);
+    stamps.push_back(0);
+
+    const CellRange range = cellRange(cover);
+    for (int32_t y = range.y1; y <= range.y2; ++y) {
+        for (int32_t x = range.x1; x <= range.x2; ++x) {
+            cells[y * columns + x].push_back(index);
+        }
+    }
+}
+
+std::vector<const CollisionGrid::Entry*> CollisionGrid::queryAtScale(const Bounds& query, float scale) const {
+    // Below scale 1, boxes grow away from their anchor by up to their offset times (1 / scale - 1).
+    // One more unit accounts for callers rounding box edges to integers.
+    const float growth = scale < 1 ? 1 / scale - 1 : 0;
+    const Bounds expanded {
+        query.x1 - maxOffsetX * growth - 1,
+        query.y1 - maxOffsetY * growth - 1,
+        query.x2 + maxOffsetX * growth + 1,
+        query.y2 + maxOffsetY * growth + 1
+    };
+
+    std::vector<uint32_t> indices;
+    const CellRange range = cellRange(expanded);
+    for (int32_t y = range.y1; y <= range.y2; ++y) {
+        for (int32_t x = range.x1; x <= range.x2; ++x) {
+            for (uint32_t index : cells[y * columns + x]) {
+                if (intersects(entries[index].cover, expanded)) {
+                    indices.push_back(index);
+                }
+            }
+        }
+    }
+
+    std::sort(indices.begin(), indices.end());
+    indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+
+    std::vector<const Entry*> result;
+    result.reserve(indices.size());
+    for (uint32_t index : indices) {
+        result.push_back(&entries[index]);
+    }
+    return result;
+}
+
+int32_t CollisionGrid::cellCoord(float value, float origin, int32_t count) const {
+    // Compare as floats first, so that huge and infinite values don't overflow the conversion.
+    const float cell = std::floor((value - origin) * inverseCellSize);
+    if (!(cell >= 0)) {
+        return 0;
+    }
+    return cell >= count - 1 ? count - 1 : int32_t(cell);
+}
+
+CollisionGrid::CellRange CollisionGrid::cellRange(const Bounds& bounds) const {
+    return {
+        cellCoord(bounds.x1, area.x1, columns),
+        cellCoord(bounds.y1, area.y1, rows),
+        cellCoord(bounds.x2, area.x1, columns),
+        cellCoord(bounds.y2, area.y1, rows)
+    };
+}
+
+} // namespace mbgl
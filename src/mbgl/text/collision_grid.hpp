@@ -0,0 +1,115 @@
+#pragma once
+
+#include <mbgl/text/collision_feature.hpp>
+#include <mbgl/util/geometry.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace mbgl {
+
+// A uniform grid over the rotated tile space that CollisionTile places boxes in. Boxes are
+// stored by value in one flat array, cells refer to them by their position in it, and each
+// box refers to its feature by a compact integer ID instead of a copy of the feature.
+//
+// Coordinates outside the grid's area are clamped to the outermost cells, so boxes anywhere
+// are found; the area only affects how evenly boxes are spread over cells.
+class CollisionGrid {
+public:
+    // An axis-aligned box in the rotated tile space. Edges are inclusive.
+    struct Bounds {
+        float x1;
+        float y1;
+        float x2;
+        float y2;
+    };
+
+    struct Entry {
+        Entry(const CollisionBox& box_, const Bounds& bounds_, const Bounds& cover_, uint32_t featureID_)
+            : box(box_), bounds(bounds_), cover(cover_), featureID(featureID_) {}
+
+        CollisionBox box;
+
+        // The box's bounds at scale 1.
+        Bounds bounds;
+
+        // The bounds together with the box's rotated anchor. Boxes drawn at scales of 1 and
+        // above stay within this area, since they shrink towards their anchor.
+        Bounds cover;
+
+        uint32_t featureID;
+    };
+
+    CollisionGrid(const Bounds& area, float cellSize);
+
+    bool empty() const {
+        return entries.empty();
+    }
+
+    void insert(const CollisionBox&, const Point<float>& rotatedAnchor, const Bounds&, uint32_t featureID);
+
+    // Calls `fn` once for each box whose bounds at scale 1 intersect `query`. Stops early if
+    // `fn` returns false.
+    template <class Fn>
+    void query(const Bounds& query, Fn&& fn) {
+        const CellRange range = cellRange(query);
+        if (++currentStamp == 0) {
+            std::fill(stamps.begin(), stamps.end(), 0);
+            currentStamp = 1;
+        }
+
+        for (int32_t y = range.y1; y <= range.y2; ++y) {
+            for (int32_t x = range.x1; x <= range.x2; ++x) {
+                for (uint32_t index : cells[y * columns + x]) {
+                    if (stamps[index] == currentStamp) {
+                        continue;
+                    }
+                    stamps[index] = currentStamp;
+
+                    const Entry& entry = entries[index];
+                    if (intersects(entry.bounds, query) && !fn(entry)) {
+                        return;
+                    }
+                }
+            }
+        }
+    }
+
+    // Returns the boxes that may intersect `query` when drawn at `scale`, in the order they
+    // were inserted. Callers test the returned boxes exactly. Safe to call concurrently.
+    std::vector<const Entry*> queryAtScale(const Bounds& query, float scale) const;
+
+private:
+    struct CellRange {
+        int32_t x1;
+        int32_t y1;
+        int32_t x2;
+        int32_t y2;
+    };
+
+    static bool intersects(const Bounds& a, const Bounds& b) {
+        return a.x1 <= b.x2 && a.y1 <= b.y2 && a.x2 >= b.x1 && a.y2 >= b.y1;
+    }
+
+    int32_t cellCoord(float value, float origin, int32_t count) const;
+    CellRange cellRange(const Bounds&) const;
+
+    const Bounds area;
+    const float inverseCellSize;
+    const int32_t columns;
+    const int32_t rows;
+
+    std::vector<Entry> entries;
+    std::vector<std::vector<uint32_t>> cells;
+
+    // The furthest any box extends from its anchor, for finding boxes drawn below scale 1.
+    float maxOffsetX = 0;
+    float maxOffsetY = 0;
+
+    // Marks the boxes the current query has visited.
+    std::vector<uint32_t> stamps;
+    uint32_t currentStamp = 0;
+};
+
+} // namespace mbgl
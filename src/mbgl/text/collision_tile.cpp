@@ -10,10 +10,43 @@
 #include <mapbox/geometry/multi_point.hpp>
 
 #include <cmath>
+#include <limits>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace mbgl {
 
-CollisionTile::CollisionTile(PlacementConfig config_) : config(std::move(config_)) {
+namespace {
+
+// Labels are typically a few hundred tile units across, so this puts a handful in each cell
+// of a dense tile.
+const float cellSize = util::EXTENT / 32.0f;
+
+// The area of the tile once it is rotated into the space that collision boxes are placed in.
+CollisionGrid::Bounds rotatedTileArea(const float angle) {
+    const float angle_sin = std::sin(angle);
+    const float angle_cos = std::cos(angle);
+    const std::array<float, 4> matrix = { { angle_cos, -angle_sin, angle_sin, angle_cos } };
+
+    CollisionGrid::Bounds area {
+        std::numeric_limits<float>::infinity(), std::numeric_limits<float>::infinity(),
+        -std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity()
+    };
+    for (const auto& corner : { Point<float>(0, 0), Point<float>(util::EXTENT, 0),
+                                Point<float>(0, util::EXTENT), Point<float>(util::EXTENT, util::EXTENT) }) {
+        const Point<float> rotated = util::matrixMultiply(matrix, corner);
+        area = { util::min(area.x1, rotated.x), util::min(area.y1, rotated.y),
+                 util::max(area.x2, rotated.x), util::max(area.y2, rotated.y) };
+    }
+    return area;
+}
+
+} // namespace
+
+CollisionTile::CollisionTile(PlacementConfig config_)
+    : config(std::move(config_)),
+      grid(rotatedTileArea(config.angle), cellSize),
+      ignoredGrid(rotatedTileArea(config.angle), cellSize) {
     // Compute the transformation matrix.
     const float angle_sin = std::sin(config.angle);
     const float angle_cos = std::cos(config.angle);
@@ -87,13 +120,14 @@ float CollisionTile::placeFeature(const CollisionFeature& feature, bool allowOve
         const auto anchor = util::matrixMultiply(rotationMatrix, box.anchor);
 
         if (!allowOverlap) {
-            for (auto it = tree.qbegin(bgi::intersects(getTreeBox(anchor, box))); it != tree.qend(); ++it) {
-                const CollisionBox& blocking = std::get<1>(*it);
+            grid.query(getBoxBounds(anchor, box), [&] (const CollisionGrid::Entry& entry) {
+                const CollisionBox& blocking = entry.box;
                 Point<float> blockingAnchor = util::matrixMultiply(rotationMatrix, blocking.anchor);
 
                 minPlacementScale = util::max(minPlacementScale, findPlacementScale(anchor, box, blockingAnchor, blocking));
-                if (minPlacementScale >= maxScale) return minPlacementScale;
-            }
+                return minPlacementScale < maxScale;
+            });
+            if (minPlacementScale >= maxScale) return minPlacementScale;
         }
 
         if (avoidEdges) {
@@ -123,15 +157,14 @@ void CollisionTile::insertFeature(CollisionFeature& feature, float minPlacementS
         box.placementScale = minPlacementScale;
     }
 
-    if (minPlacementScale < maxScale) {
-        std::vector<CollisionTreeBox> treeBoxes;
+    if (minPlacementScale < maxScale && !feature.boxes.empty()) {
+        const auto featureID = uint32_t(features.size());
+        features.push_back(feature.indexedFeature);
+
+        CollisionGrid& target = ignorePlacement ? ignoredGrid : grid;
         for (auto& box : feature.boxes) {
-            treeBoxes.emplace_back(getTreeBox(util::matrixMultiply(rotationMatrix, box.anchor), box), box, feature.indexedFeature);
-        }
-        if (ignorePlacement) {
-            ignoredTree.insert(treeBoxes.begin(), treeBoxes.end());
-        } else {
-            tree.insert(treeBoxes.begin(), treeBoxes.end());
+            const auto anchor = util::matrixMultiply(rotationMatrix, box.anchor);
+            target.insert(box, anchor, getBoxBounds(anchor, box), featureID);
         }
     }
 
@@ -141,7 +174,7 @@ void CollisionTile::insertFeature(CollisionFeature& feature, float minPlacementS
 // |(x1,y1)      |             | relative to the tile e.g. when zooming in,
 // |             |             | the symbol gets smaller relative to the tile.
 // |  (x1',y1')  v             |
-// |     +-------+-------+     | The boxes inserted into the tree represents
+// |     +-------+-------+     | The boxes inserted into the grid represent
 // |     |       |       |     | the bounds at the integer zoom level (where
 // |     |       |       |     | the symbol is biggest relative to the tile).
 // |     |       |       |     |
@@ -154,23 +187,19 @@ void CollisionTile::insertFeature(CollisionFeature& feature, float minPlacementS
 // |             |             | calculating the bounds at current zoom level
 // |             |      (x2,y2)| we must unscale the box using its center as
 // +---------------------------+ transform origin.
-Box CollisionTile::getTreeBox(const Point<float>& anchor, const CollisionBox& box, const float scale) {
+CollisionGrid::Bounds CollisionTile::getBoxBounds(const Point<float>& anchor, const CollisionBox& box, const float scale) {
     assert(box.x1 <= box.x2 && box.y1 <= box.y2);
-    return Box{
-        CollisionPoint{
-            anchor.x + box.x1 / scale,
-            anchor.y + box.y1 / scale * yStretch
-        },
-        CollisionPoint{
-            anchor.x + box.x2 / scale,
-            anchor.y + box.y2 / scale * yStretch
-        }
+    return CollisionGrid::Bounds {
+        anchor.x + box.x1 / scale,
+        anchor.y + box.y1 / scale * yStretch,
+        anchor.x + box.x2 / scale,
+        anchor.y + box.y2 / scale * yStretch
     };
 }
 
 std::vector<IndexedSubfeature> CollisionTile::queryRenderedSymbols(const GeometryCoordinates& queryGeometry, float scale) const {
     std::vector<IndexedSubfeature> result;
-    if (queryGeometry.empty() || (tree.empty() && ignoredTree.empty())) {
+    if (queryGeometry.empty() || (grid.empty() && ignoredGrid.empty())) {
         return result;
     }
 
@@ -182,26 +211,24 @@ std::vector<IndexedSubfeature> CollisionTile::queryRenderedSymbols(const Geometr
         polygon.push_back(convertPoint<int16_t>(rotated));
     }
 
-    // Predicate for ruling out already seen features.
-    std::unordered_map<std::string, std::unordered_set<std::size_t>> sourceLayerFeatures;
-    auto seenFeature = [&] (const CollisionTreeBox& treeBox) -> bool {
-        const IndexedSubfeature& feature = std::get<2>(treeBox);
-        const auto& seenFeatures = sourceLayerFeatures[feature.sourceLayerName];
-        return seenFeatures.find(feature.index) == seenFeatures.end();
+    const auto polygonBox = mapbox::geometry::envelope(polygon);
+    const CollisionGrid::Bounds queryBounds {
+        float(polygonBox.min.x), float(polygonBox.min.y), float(polygonBox.max.x), float(polygonBox.max.y)
     };
 
+    // Features already returned, by source layer.
+    std::unordered_map<uint32_t, std::unordered_set<std::size_t>> sourceLayerFeatures;
+
     // Account for the rounding done when updating symbol shader variables.
     const float roundedScale = std::pow(2.0f, std::ceil(util::log2(scale) * 10.0f) / 10.0f);
 
     // Check if feature is rendered (collision free) at current scale.
-    auto visibleAtScale = [&] (const CollisionTreeBox& treeBox) -> bool {
-        const CollisionBox& box = std::get<1>(treeBox);
+    auto visibleAtScale = [&] (const CollisionBox& box) -> bool {
         return roundedScale >= box.placementScale && roundedScale <= box.maxScale;
     };
 
     // Check if query polygon intersects with the feature box at current scale.
-    auto intersectsAtScale = [&] (const CollisionTreeBox& treeBox) -> bool {
-        const CollisionBox& collisionBox = std::get<1>(treeBox);
+    auto intersectsAtScale = [&] (const CollisionBox& collisionBox) -> bool {
         const auto anchor = util::matrixMultiply(rotationMatrix, collisionBox.anchor);
         const int16_t x1 = anchor.x + collisionBox.x1 / scale;
         const int16_t y1 = anchor.y + collisionBox.y1 / scale * yStretch;
@@ -213,21 +240,22 @@ std::vector<IndexedSubfeature> CollisionTile::queryRenderedSymbols(const Geometr
         return util::polygonIntersectsPolygon(polygon, bbox);
     };
 
-    auto predicates = bgi::satisfies(seenFeature)
-                   && bgi::satisfies(visibleAtScale)
-                   && bgi::satisfies(intersectsAtScale);
+    auto queryGrid = [&](const CollisionGrid& grid_) {
+        for (const CollisionGrid::Entry* entry : grid_.queryAtScale(queryBounds, scale)) {
+            const IndexedSubfeature& feature = features[entry->featureID];
+            auto& seenFeatures = sourceLayerFeatures[feature.sourceLayerID];
+            if (seenFeatures.find(feature.index) != seenFeatures.end() ||
+                !visibleAtScale(entry->box) || !intersectsAtScale(entry->box)) {
+                continue;
+            }
 
-    auto queryTree = [&](const auto& tree_) {
-        for (auto it = tree_.qbegin(predicates); it != tree_.qend(); ++it) {
-            const IndexedSubfeature& feature = std::get<2>(*it);
-            auto& seenFeatures = sourceLayerFeatures[feature.sourceLayerName];
             seenFeatures.insert(feature.index);
             result.push_back(feature);
         }
     };
 
-    queryTree(tree);
-    queryTree(ignoredTree);
+    queryGrid(grid);
+    queryGrid(ignoredGrid);
 
     return result;
 }
@@ -12,12 +12,12 @@ namespace mbgl {
 
 static GlyphAtlasObserver nullObserver;
 
-GlyphAtlas::GlyphAtlas(const Size size, FileSource& fileSource_)
+GlyphAtlas::GlyphAtlas(const Size size, FileSource& fileSource_, Scheduler& scheduler_)
     : fileSource(fileSource_),
+      scheduler(scheduler_),
       observer(&nullObserver),
       bin(size.width, size.height),
-      image(size),
-      dirty(true) {
+      image(size) {
 }
 
 GlyphAtlas::~GlyphAtlas() = default;
@@ -32,7 +32,7 @@ void GlyphAtlas::requestGlyphRange(const FontStack& fontStack, const GlyphRange&
     }
 
     rangeSets.emplace(range,
-        std::make_unique<GlyphPBF>(this, fontStack, range, observer, fileSource));
+        std::make_unique<GlyphPBF>(this, fontStack, range, observer, fileSource, scheduler));
 }
 
 bool GlyphAtlas::hasGlyphRanges(const FontStack& fontStack, const GlyphRangeSet& glyphRanges) {
@@ -64,16 +64,30 @@ bool GlyphAtlas::hasGlyphRanges(const FontStack& fontStack, const GlyphRangeSet&
 }
 
 util::exclusive<GlyphSet> GlyphAtlas::getGlyphSet(const FontStack& fontStack) {
-    auto lock = std::make_unique<std::lock_guard<std::mutex>>(glyphSetsMutex);
+    LockedGlyphSet* entry;
+    {
+        // Entries are never removed, so the pointer stays valid after the map is unlocked.
+        std::lock_guard<std::mutex> lock(glyphSetsMutex);
+        auto& it = glyphSets[fontStack];
+        if (!it) {
+            it = std::make_unique<LockedGlyphSet>();
+        }
+        entry = it.get();
+    }
 
-    auto it = glyphSets.find(fontStack);
-    if (it == glyphSets.end()) {
-        it = glyphSets.emplace(fontStack, std::make_unique<GlyphSet>()).first;
+    return { &entry->glyphSet, std::make_unique<std::lock_guard<std::mutex>>(entry->mutex) };
+}
+
+void GlyphAtlas::insertGlyphs(const FontStack& fontStack, std::vector<SDFGlyph>&& glyphs) {
+    auto glyphSet = getGlyphSet(fontStack);
+    for (auto& glyph : glyphs) {
+        const uint32_t id = glyph.id;
+        glyphSet->insert(id, std::move(glyph));
     }
 
-    // FIXME: We lock all GlyphSets, but what we should
-    // really do is lock only the one we are returning.
-    return { it->second.get(), std::move(lock) };
+    // Text shaped before these glyphs arrived is missing them. This happens while the glyph
+    // set is still locked, so no layout can cache a shaping of the old glyphs afterwards.
+    shapingCache.invalidate(fontStack);
 }
 
 void GlyphAtlas::setObserver(GlyphAtlasObserver* observer_) {
@@ -113,6 +127,9 @@ Rect<uint16_t> GlyphAtlas::addGlyph(uintptr_t tileUID,
     // The glyph is already in this texture.
     if (it != face.end()) {
         GlyphValue& value = it->second;
+        if (value.ids.empty()) {
+            unused.erase(value.unusedPosition);
+        }
         value.ids.insert(tileUID);
         return value.rect;
     }
@@ -145,6 +162,10 @@ Rect<uint16_t> GlyphAtlas::addGlyph(uintptr_t tileUID,
     pack_height += (4 - pack_height % 4);
 
     Rect<uint16_t> rect = bin.allocate(pack_width, pack_height);
+    while (rect.w == 0 && evictUnusedGlyph()) {
+        rect = bin.allocate(pack_width, pack_height);
+    }
+
     if (rect.w == 0) {
         Log::Error(Event::OpenGL, "glyph bitmap overflow");
         return rect;
@@ -167,41 +188,63 @@ Rect<uint16_t> GlyphAtlas::addGlyph(uintptr_t tileUID,
         }
     }
 
-    dirty = true;
+    markDirty(rect);
 
     return rect;
 }
 
+bool GlyphAtlas::evictUnusedGlyph() {
+    if (unused.empty()) {
+        return false;
+    }
+
+    const auto& glyph = unused.front();
+    std::map<uint32_t, GlyphValue>& face = index.at(glyph.first);
+    auto it = face.find(glyph.second);
+    assert(it != face.end() && it->second.ids.empty());
+
+    clearRect(it->second.rect);
+    bin.release(it->second.rect);
+
+    face.erase(it);
+    unused.pop_front();
+
+    return true;
+}
+
+void GlyphAtlas::clearRect(const Rect<uint16_t>& rect) {
+    uint8_t *target = image.data.get();
+    for (uint32_t y = 0; y < rect.h; y++) {
+        uint32_t y1 = image.size.width * (rect.y + y) + rect.x;
+        for (uint32_t x = 0; x < rect.w; x++) {
+            target[y1 + x] = 0;
+        }
+    }
+
+    markDirty(rect);
+}
+
+void GlyphAtlas::markDirty(const Rect<uint16_t>& rect) {
+    const uint32_t top = rect.y;
+    const uint32_t bottom = rect.y + rect.h;
+    if (dirtyRows) {
+        dirtyRows = Range<uint32_t> { std::min(dirtyRows->min, top), std::max(dirtyRows->max, bottom) };
+    } else {
+        dirtyRows = Range<uint32_t> { top, bottom };
+    }
+}
+
 void GlyphAtlas::removeGlyphs(uintptr_t tileUID) {
     std::lock_guard<std::mutex> lock(mtx);
 
     for (auto& faces : index) {
-        std::map<uint32_t, GlyphValue>& face = faces.second;
-        for (auto it = face.begin(); it != face.end(); /* we advance in the body */) {
-            GlyphValue& value = it->second;
-            value.ids.erase(tileUID);
-
-            if (value.ids.empty()) {
-                const Rect<uint16_t>& rect = value.rect;
-
-                // Clear out the bitmap.
-                uint8_t *target = image.data.get();
-                for (uint32_t y = 0; y < rect.h; y++) {
-                    uint32_t y1 = image.size.width * (rect.y + y) + rect.x;
-                    for (uint32_t x = 0; x < rect.w; x++) {
-                        target[y1 + x] = 0;
-                    }
-                }
-
-                bin.release(rect);
-
-                // Make sure to post-increment the iterator: This will return the
-                // current iterator, but will go to the next position before we
-                // erase the element from the map. That way, the iterator stays
-                // valid.
-                face.erase(it++);
-            } else {
-                ++it;
+        for (auto& glyph : faces.second) {
+            GlyphValue& value = glyph.second;
+
+            // Keep the bitmap in place in case another tile needs this glyph again; it is
+            // evicted once its space is needed.
+            if (value.ids.erase(tileUID) && value.ids.empty()) {
+                value.unusedPosition = unused.emplace(unused.end(), faces.first, glyph.first);
             }
         }
     }
@@ -211,16 +254,26 @@ Size GlyphAtlas::getSize() const {
     return image.size;
 }
 
+void GlyphAtlas::dumpDebugLogs() const {
+    const ShapingCache::Stats stats = shapingCache.getStats();
+    const uint64_t lookups = stats.hits + stats.misses;
+    Log::Info(Event::General, "GlyphAtlas::shapingCache: %llu hits, %llu misses (%.1f%% hit rate)",
+              static_cast<unsigned long long>(stats.hits),
+              static_cast<unsigned long long>(stats.misses),
+              lookups ? 100.0 * stats.hits / lookups : 0.0);
+}
+
 void GlyphAtlas::upload(gl::Context& context, gl::TextureUnit unit) {
     std::lock_guard<std::mutex> lock(mtx);
 
     if (!texture) {
         texture = context.createTexture(image, unit);
-    } else if (dirty) {
-        context.updateTexture(*texture, image, unit);
+    } else if (dirtyRows) {
+        // Only upload the band of rows that glyphs were added to or removed from.
+        context.updateTextureRows(*texture, image, *dirtyRows, unit);
     }
 
-    dirty = false;
+    dirtyRows = {};
 }
 
 void GlyphAtlas::bind(gl::Context& context, gl::TextureUnit unit) {
@@ -2,6 +2,7 @@
 
 #include <mbgl/text/glyph.hpp>
 #include <mbgl/text/glyph_set.hpp>
+#include <mbgl/text/shaping_cache.hpp>
 #include <mbgl/geometry/binpack.hpp>
 #include <mbgl/util/noncopyable.hpp>
 #include <mbgl/util/optional.hpp>
@@ -9,11 +10,12 @@
 #include <mbgl/util/exclusive.hpp>
 #include <mbgl/util/work_queue.hpp>
 #include <mbgl/util/image.hpp>
+#include <mbgl/util/range.hpp>
 #include <mbgl/gl/texture.hpp>
 #include <mbgl/gl/object.hpp>
 
-#include <atomic>
 #include <string>
+#include <list>
 #include <unordered_set>
 #include <unordered_map>
 #include <mutex>
@@ -24,6 +26,7 @@ namespace mbgl {
 
 class FileSource;
 class GlyphPBF;
+class Scheduler;
 class GlyphAtlasObserver;
 
 namespace gl {
@@ -32,11 +35,21 @@ class Context;
 
 class GlyphAtlas : public util::noncopyable {
 public:
-    GlyphAtlas(Size, FileSource&);
+    GlyphAtlas(Size, FileSource&, Scheduler&);
     ~GlyphAtlas();
 
+    // Returns the glyph set for a font stack. Only that font stack's glyph set is locked
+    // while the result is held, so other font stacks can be read or loaded concurrently.
     util::exclusive<GlyphSet> getGlyphSet(const FontStack&);
 
+    // Adds parsed glyphs to a font stack's glyph set. Can be called from any thread.
+    void insertGlyphs(const FontStack&, std::vector<SDFGlyph>&&);
+
+    // Shapings of the atlas's glyph sets, shared between tiles.
+    ShapingCache& getShapingCache() {
+        return shapingCache;
+    }
+
     // Returns true if the set of GlyphRanges are available and parsed or false
     // if they are not. For the missing ranges, a request on the FileSource is
     // made and when the glyph if finally parsed, it gets added to the respective
@@ -70,6 +83,8 @@ public:
 
     Size getSize() const;
 
+    void dumpDebugLogs() const;
+
 private:
     void requestGlyphRange(const FontStack&, const GlyphRange&);
 
@@ -77,32 +92,59 @@ private:
                             const FontStack&,
                             const SDFGlyph&);
 
+    // Frees the rect of the glyph that has gone unused the longest. Returns false if every
+    // glyph in the atlas is still used by a tile.
+    bool evictUnusedGlyph();
+
+    void clearRect(const Rect<uint16_t>&);
+    void markDirty(const Rect<uint16_t>&);
+
 
     FileSource& fileSource;
+    Scheduler& scheduler;
     std::string glyphURL;
 
-    std::unordered_map<FontStack, std::map<GlyphRange, std::unique_ptr<GlyphPBF>>, FontStackHash> ranges;
-    std::mutex rangesMutex;
+    struct LockedGlyphSet {
+        std::mutex mutex;
+        GlyphSet glyphSet;
+    };
 
-    std::unordered_map<FontStack, std::unique_ptr<GlyphSet>, FontStackHash> glyphSets;
+    // Declared before `ranges` so that glyph sets outlive the workers that fill them.
+    std::unordered_map<FontStack, std::unique_ptr<LockedGlyphSet>, FontStackHash> glyphSets;
     std::mutex glyphSetsMutex;
 
+    ShapingCache shapingCache;
+
+    std::unordered_map<FontStack, std::map<GlyphRange, std::unique_ptr<GlyphPBF>>, FontStackHash> ranges;
+    std::mutex rangesMutex;
+
     util::WorkQueue workQueue;
 
     GlyphAtlasObserver* observer = nullptr;
 
+    // Glyphs that no tile uses any more, identified by font stack and glyph ID, in the order
+    // they became unused. Their bitmaps stay in the atlas so that tiles that need them again
+    // can reuse them, until the space is needed for other glyphs.
+    using UnusedGlyphs = std::list<std::pair<FontStack, uint32_t>>;
+
     struct GlyphValue {
         GlyphValue(Rect<uint16_t> rect_, uintptr_t id)
             : rect(std::move(rect_)), ids({ id }) {}
         Rect<uint16_t> rect;
         std::unordered_set<uintptr_t> ids;
+
+        // Position in `unused` while `ids` is empty.
+        UnusedGlyphs::iterator unusedPosition;
     };
 
     std::mutex mtx;
     BinPack<uint16_t> bin;
     std::unordered_map<FontStack, std::map<uint32_t, GlyphValue>, FontStackHash> index;
+    UnusedGlyphs unused;
     const AlphaImage image;
-    std::atomic<bool> dirty;
+
+    // Rows of the image that changed since the last upload.
+    optional<Range<uint32_t>> dirtyRows;
     mbgl::optional<gl::Texture> texture;
 };
 
@@ -1,11 +1,13 @@
 #pragma once
 
 #include <mbgl/text/glyph.hpp>
+#include <mbgl/text/glyph_pbf_worker.hpp>
+#include <mbgl/actor/actor.hpp>
 #include <mbgl/util/font_stack.hpp>
 #include <mbgl/util/noncopyable.hpp>
 
 #include <atomic>
-#include <functional>
+#include <exception>
 #include <string>
 #include <memory>
 
@@ -15,6 +17,7 @@ class GlyphAtlas;
 class GlyphAtlasObserver;
 class AsyncRequest;
 class FileSource;
+class Scheduler;
 
 class GlyphPBF : private util::noncopyable {
 public:
@@ -22,17 +25,28 @@ public:
              const FontStack&,
              const GlyphRange&,
              GlyphAtlasObserver*,
-             FileSource&);
+             FileSource&,
+             Scheduler&);
     ~GlyphPBF();
 
     bool isParsed() const {
         return parsed;
     }
 
+    // Messages from the worker.
+    void onParsed();
+    void onError(std::exception_ptr);
+
 private:
     std::atomic<bool> parsed;
-    std::unique_ptr<AsyncRequest> req;
+    const FontStack fontStack;
+    const GlyphRange glyphRange;
     GlyphAtlasObserver* observer = nullptr;
+
+    std::shared_ptr<Mailbox> mailbox;
+    Actor<GlyphPBFWorker> worker;
+
+    std::unique_ptr<AsyncRequest> req;
 };
 
 } // namespace mbgl
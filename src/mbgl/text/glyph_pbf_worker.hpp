@@ -0,0 +1,36 @@
+#pragma once
+
+#include <mbgl/text/glyph.hpp>
+#include <mbgl/util/font_stack.hpp>
+#include <mbgl/actor/actor_ref.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace mbgl {
+
+class GlyphAtlas;
+class GlyphPBF;
+
+// Decodes a glyph range PBF into SDF glyphs. Glyphs that are malformed or outside the
+// range are dropped. Throws if the PBF can't be decoded.
+std::vector<SDFGlyph> parseGlyphPBF(const GlyphRange&, const std::string& data);
+
+// Parses one glyph range on a background scheduler and adds the result to the atlas's
+// glyph set for its font stack. Ranges are parsed concurrently, and only the glyph set
+// being updated is locked while its glyphs are inserted.
+class GlyphPBFWorker {
+public:
+    GlyphPBFWorker(ActorRef<GlyphPBFWorker>, ActorRef<GlyphPBF>, GlyphAtlas&, FontStack, GlyphRange);
+
+    void parse(std::shared_ptr<const std::string> data);
+
+private:
+    ActorRef<GlyphPBF> parent;
+    GlyphAtlas& atlas;
+    const FontStack fontStack;
+    const GlyphRange glyphRange;
+};
+
+} // namespace mbgl
@@ -7,6 +7,8 @@
 
 #include <algorithm>
 #include <cassert>
+#include <limits>
+#include <vector>
 
 namespace mbgl {
 
@@ -151,46 +153,95 @@ float calculatePenalty(char16_t codePoint, char16_t nextCodePoint) {
 }
 
 struct PotentialBreak {
-    PotentialBreak(const std::size_t p_index, const float p_x, const PotentialBreak* p_priorBreak, const float p_badness)
-        : index(p_index), x(p_x), priorBreak(p_priorBreak), badness(p_badness)
-    {}
-
-    const std::size_t index;
-    const float x;
-    const PotentialBreak* priorBreak;
-    const float badness;
+    // Position in the text that the line breaks before.
+    std::size_t index;
+    float x;
+    float badness;
+    // Position of the best preceding break in the list of potential breaks.
+    std::size_t priorBreak;
 };
 
+// Potential breaks that are further back than the look-back distance are only summarized,
+// by their lowest badness and their furthest x. As long as that summary shows none of them
+// can beat the breaks inside the window, they aren't visited again.
+struct BreakWindow {
+    std::size_t start = 0;
+    float minBadness = std::numeric_limits<float>::infinity();
+    float maxX = -std::numeric_limits<float>::infinity();
+};
+
+// Finds the last break in [begin, end) that ends the line before `breakX` with the least total
+// badness, the same way a sequential scan with `<=` would.
+std::pair<float, std::size_t> bestPriorBreak(const std::vector<PotentialBreak>& potentialBreaks,
+                                             const std::size_t begin,
+                                             const std::size_t end,
+                                             const float breakX,
+                                             const float targetWidth,
+                                             const float penalty,
+                                             const bool isLastBreak) {
+    std::pair<float, std::size_t> best { std::numeric_limits<float>::infinity(), end };
+    for (std::size_t i = begin; i < end; i++) {
+        const float lineWidth = breakX - potentialBreaks[i].x;
+        const float breakBadness =
+            calculateBadness(lineWidth, targetWidth, penalty, isLastBreak) + potentialBreaks[i].badness;
+        if (breakBadness <= best.first) {
+            best = { breakBadness, i };
+        }
+    }
+    return best;
+}
 
-PotentialBreak evaluateBreak(const std::size_t breakIndex, const float breakX, const float targetWidth, const std::list<PotentialBreak>& potentialBreaks, const float penalty, const bool isLastBreak) {
+PotentialBreak evaluateBreak(const std::size_t breakIndex,
+                             const float breakX,
+                             const float targetWidth,
+                             const std::vector<PotentialBreak>& potentialBreaks,
+                             BreakWindow& window,
+                             const float penalty,
+                             const bool isLastBreak) {
     // We could skip evaluating breaks where the line length (breakX - priorBreak.x) > maxWidth
     //  ...but in fact we allow lines longer than maxWidth (if there's no break points)
     //  ...and when targetWidth and maxWidth are close, strictly enforcing maxWidth can give
     //     more lopsided results.
+    const float lookBack = 2 * targetWidth;
+    while (window.start < potentialBreaks.size() && breakX - potentialBreaks[window.start].x > lookBack) {
+        window.minBadness = util::min(window.minBadness, potentialBreaks[window.start].badness);
+        window.maxX = util::max(window.maxX, potentialBreaks[window.start].x);
+        window.start++;
+    }
 
-    const PotentialBreak* bestPriorBreak = nullptr;
-    float bestBreakBadness = calculateBadness(breakX, targetWidth, penalty, isLastBreak);
-    for (const auto& potentialBreak : potentialBreaks) {
-        const float lineWidth = breakX - potentialBreak.x;
-        float breakBadness =
-            calculateBadness(lineWidth, targetWidth, penalty, isLastBreak) + potentialBreak.badness;
-        if (breakBadness <= bestBreakBadness) {
-            bestPriorBreak = &potentialBreak;
-            bestBreakBadness = breakBadness;
+    auto best = bestPriorBreak(potentialBreaks, window.start, potentialBreaks.size(),
+                               breakX, targetWidth, penalty, isLastBreak);
+
+    if (window.start > 0) {
+        // Lines from breaks behind the window are at least `shortestLine` long. Once a line is
+        // longer than the target width, its badness only grows with its length, which bounds
+        // how good any of those breaks can be. Otherwise, fall back to checking all of them.
+        const float shortestLine = breakX - window.maxX;
+        const bool windowWins = shortestLine >= targetWidth &&
+            best.first <= calculateBadness(shortestLine, targetWidth, penalty, isLastBreak) + window.minBadness;
+
+        if (!windowWins) {
+            const auto earlier = bestPriorBreak(potentialBreaks, 0, window.start,
+                                                breakX, targetWidth, penalty, isLastBreak);
+            // On a tie, the later break wins.
+            if (earlier.first < best.first) {
+                best = earlier;
+            }
         }
     }
 
-    return PotentialBreak(breakIndex, breakX, bestPriorBreak, bestBreakBadness);
+    return { breakIndex, breakX, best.first, best.second };
 }
 
-std::set<std::size_t> leastBadBreaks(const PotentialBreak& lastLineBreak) {
-    std::set<std::size_t> leastBadBreaks = { lastLineBreak.index };
-    const PotentialBreak* priorBreak = lastLineBreak.priorBreak;
-    while (priorBreak) {
-        leastBadBreaks.insert(priorBreak->index);
-        priorBreak = priorBreak->priorBreak;
+std::set<std::size_t> leastBadBreaks(const std::vector<PotentialBreak>& potentialBreaks,
+                                     const PotentialBreak& lastLineBreak) {
+    std::vector<std::size_t> breaks = { lastLineBreak.index };
+    // The first potential break is the start of the text, which isn't a line break.
+    for (std::size_t i = lastLineBreak.priorBreak; i != 0; i = potentialBreaks[i].priorBreak) {
+        breaks.push_back(potentialBreaks[i].index);
     }
-    return leastBadBreaks;
+    // Breaks were collected back to front; inserting them in order makes building the set linear.
+    return { breaks.rbegin(), breaks.rend() };
 }
 
 
@@ -209,7 +260,11 @@ std::set<std::size_t> GlyphSet::determineLineBreaks(const std::u16string& logica
 
     const float targetWidth = determineAverageLineWidth(logicalInput, spacing, maxWidth);
 
-    std::list<PotentialBreak> potentialBreaks;
+    std::vector<PotentialBreak> potentialBreaks;
+    potentialBreaks.reserve(logicalInput.size() + 1);
+    potentialBreaks.push_back({ 0, 0, 0, 0 });
+
+    BreakWindow window;
     float currentX = 0;
 
     for (std::size_t i = 0; i < logicalInput.size(); i++) {
@@ -223,13 +278,14 @@ std::set<std::size_t> GlyphSet::determineLineBreaks(const std::u16string& logica
         // surrounding spaces.
         if ((i < logicalInput.size() - 1) &&
             (util::i18n::allowsWordBreaking(codePoint) || util::i18n::allowsIdeographicBreaking(codePoint))) {
-            potentialBreaks.push_back(evaluateBreak(i+1, currentX, targetWidth, potentialBreaks,
-                                                     calculatePenalty(codePoint, logicalInput[i+1]),
-                                                     false));
+            potentialBreaks.push_back(evaluateBreak(i+1, currentX, targetWidth, potentialBreaks, window,
+                                                    calculatePenalty(codePoint, logicalInput[i+1]),
+                                                    false));
         }
     }
 
-    return leastBadBreaks(evaluateBreak(logicalInput.size(), currentX, targetWidth, potentialBreaks, 0, true));
+    return leastBadBreaks(potentialBreaks,
+                          evaluateBreak(logicalInput.size(), currentX, targetWidth, potentialBreaks, window, 0, true));
 }
 
 void GlyphSet::shapeLines(Shaping& shaping,
@@ -0,0 +1,89 @@
+#include <mbgl/text/shaping_cache.hpp>
+
+#include <boost/functional/hash.hpp>
+
+namespace mbgl {
+
+bool operator==(const ShapingKey& a, const ShapingKey& b) {
+    return a.text == b.text &&
+           a.fontStack == b.fontStack &&
+           a.maxWidth == b.maxWidth &&
+           a.lineHeight == b.lineHeight &&
+           a.horizontalAlign == b.horizontalAlign &&
+           a.verticalAlign == b.verticalAlign &&
+           a.justify == b.justify &&
+           a.spacing == b.spacing &&
+           a.translate == b.translate;
+}
+
+std::size_t ShapingKeyHash::operator()(const ShapingKey& key) const {
+    std::size_t seed = std::hash<std::u16string>()(key.text);
+    boost::hash_combine(seed, FontStackHash()(key.fontStack));
+    boost::hash_combine(seed, key.maxWidth);
+    boost::hash_combine(seed, key.lineHeight);
+    boost::hash_combine(seed, key.horizontalAlign);
+    boost::hash_combine(seed, key.verticalAlign);
+    boost::hash_combine(seed, key.justify);
+    boost::hash_combine(seed, key.spacing);
+    boost::hash_combine(seed, key.translate.x);
+    boost::hash_combine(seed, key.translate.y);
+    return seed;
+}
+
+ShapingCache::ShapingCache(std::size_t capacity_)
+    : capacity(capacity_) {
+}
+
+optional<Shaping> ShapingCache::get(const ShapingKey& key) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto it = index.find(key);
+    if (it == index.end()) {
+        stats.misses++;
+        return {};
+    }
+
+    stats.hits++;
+    entries.splice(entries.begin(), entries, it->second);
+    return it->second->second;
+}
+
+void ShapingCache::add(ShapingKey key, Shaping shaping) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto it = index.find(key);
+    if (it != index.end()) {
+        // Another thread shaped the same text in the meantime.
+        it->second->second = std::move(shaping);
+        entries.splice(entries.begin(), entries, it->second);
+        return;
+    }
+
+    entries.emplace_front(key, std::move(shaping));
+    index.emplace(std::move(key), entries.begin());
+
+    if (entries.size() > capacity) {
+        index.erase(entries.back().first);
+        entries.pop_back();
+    }
+}
+
+void ShapingCache::invalidate(const FontStack& fontStack) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    for (auto it = entries.begin(); it != entries.end();) {
+        if (it->first.fontStack == fontStack) {
+            index.erase(it->first);
+            it = entries.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+ShapingCache::Stats ShapingCache::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return stats;
+}
+
+} // namespace mbgl
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <mbgl/text/glyph.hpp>
+#include <mbgl/util/font_stack.hpp>
+#include <mbgl/util/geometry.hpp>
+#include <mbgl/util/noncopyable.hpp>
+#include <mbgl/util/optional.hpp>
+
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace mbgl {
+
+// Everything that determines the result of GlyphSet::getShaping(), apart from the glyphs.
+class ShapingKey {
+public:
+    std::u16string text;
+    FontStack fontStack;
+    float maxWidth;
+    float lineHeight;
+    float horizontalAlign;
+    float verticalAlign;
+    float justify;
+    float spacing;
+    Point<float> translate;
+};
+
+bool operator==(const ShapingKey&, const ShapingKey&);
+
+struct ShapingKeyHash {
+    std::size_t operator()(const ShapingKey&) const;
+};
+
+// A bounded, least-recently-used cache of shaped text, shared by the symbol layouts of all
+// tiles. The same street names and POI labels appear in neighbouring tiles and at several
+// zoom levels, and shaping them runs bidi, line breaking and glyph positioning each time.
+// Safe to use from any thread.
+class ShapingCache : private util::noncopyable {
+public:
+    struct Stats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+    };
+
+    explicit ShapingCache(std::size_t capacity = 4096);
+
+    optional<Shaping> get(const ShapingKey&);
+    void add(ShapingKey, Shaping);
+
+    // Drops the shapings of a font stack. Must be called whenever its glyph set changes, since
+    // missing glyphs are left out of a shaping.
+    void invalidate(const FontStack&);
+
+    Stats getStats() const;
+
+private:
+    using Entries = std::list<std::pair<ShapingKey, Shaping>>;
+
+    const std::size_t capacity;
+
+    mutable std::mutex mutex;
+    Entries entries; // Most recently used first.
+    std::unordered_map<ShapingKey, Entries::iterator, ShapingKeyHash> index;
+    Stats stats;
+};
+
+} // namespace mbgl
@@ -14,6 +14,8 @@
 #include <mbgl/map/transform_state.hpp>
 #include <mbgl/util/run_loop.hpp>
 
+#include <algorithm>
+
 namespace mbgl {
 
 using namespace style;
@@ -62,14 +64,30 @@ void GeometryTile::setPlacementConfig(const PlacementConfig& desiredConfig) {
         return;
     }
 
+    ++correlationID;
+    requestedConfig = desiredConfig;
+
+    // Placements are cached only once they are complete for the current layout.
+    if (availableData == DataAvailability::All) {
+        auto it = std::find_if(placements.begin(), placements.end(), [&] (const Placement& placement) {
+            return placement.collisionTile->config == desiredConfig;
+        });
+        if (it != placements.end()) {
+            placements.splice(placements.begin(), placements, it);
+            symbolBuckets = it->symbolBuckets;
+            collisionTile = it->collisionTile;
+            worker.invoke(&GeometryTileWorker::setPlacedConfig, desiredConfig, correlationID);
+            observer->onTileChanged(*this);
+            return;
+        }
+    }
+
     // Mark the tile as pending again if it was complete before to prevent signaling a complete
     // state despite pending parse operations.
     if (availableData == DataAvailability::All) {
         availableData = DataAvailability::Some;
     }
 
-    ++correlationID;
-    requestedConfig = desiredConfig;
     worker.invoke(&GeometryTileWorker::setPlacementConfig, desiredConfig, correlationID);
 }
 
@@ -109,6 +127,11 @@ void GeometryTile::onLayout(LayoutResult result) {
     nonSymbolBuckets = std::move(result.nonSymbolBuckets);
     featureIndex = std::move(result.featureIndex);
     data = std::move(result.tileData);
+    placements.clear();
+
+    // The symbols of the previous placement refer to the previous feature index, and stay out of
+    // query results until this layout is placed.
+    collisionTile.reset();
     observer->onTileChanged(*this);
 }
 
@@ -116,8 +139,25 @@ void GeometryTile::onPlacement(PlacementResult result) {
     if (result.correlationID == correlationID) {
         availableData = DataAvailability::All;
     }
-    symbolBuckets = std::move(result.symbolBuckets);
-    collisionTile = std::move(result.collisionTile);
+
+    Placement placement { std::move(result.symbolBuckets), std::move(result.collisionTile) };
+
+    // A placement for an earlier config may arrive after a cached placement for the requested
+    // config was shown; keep showing the latter.
+    const bool current = collisionTile && requestedConfig && collisionTile->config == *requestedConfig;
+    if (!current || placement.collisionTile->config == collisionTile->config) {
+        symbolBuckets = placement.symbolBuckets;
+        collisionTile = placement.collisionTile;
+    }
+
+    placements.remove_if([&] (const Placement& cached) {
+        return cached.collisionTile->config == placement.collisionTile->config;
+    });
+    placements.push_front(std::move(placement));
+    if (placements.size() > maxPlacements) {
+        placements.pop_back();
+    }
+
     observer->onTileChanged(*this);
 }
 
@@ -138,9 +178,10 @@ Bucket* GeometryTile::getBucket(const Layer& layer) {
 }
 
 void GeometryTile::queryRenderedFeatures(
-    std::unordered_map<std::string, std::vector<Feature>>& result,
+    std::unordered_map<std::string, std::vector<LazyFeature>>& result,
     const GeometryCoordinates& queryGeometry,
     const TransformState& transformState,
+    const QueryLayers& queryLayers,
     const optional<std::vector<std::string>>& layerIDs) {
 
     if (!featureIndex || !data) return;
@@ -151,10 +192,20 @@ void GeometryTile::queryRenderedFeatures(
                         util::tileSize * id.overscaleFactor(),
                         std::pow(2, transformState.getZoom() - id.overscaledZ),
                         layerIDs,
-                        *data,
+                        data,
                         id.canonical,
-                        style,
+                        queryLayers,
                         collisionTile.get());
 }
 
+optional<TileFeatureIndex> GeometryTile::snapshotFeatureIndex() const {
+    if (!featureIndex || !data) return {};
+
+    return TileFeatureIndex { id, featureIndex, cloneData(), collisionTile };
+}
+
+std::unique_ptr<GeometryTileData> GeometryTile::cloneData() const {
+    return data ? data->clone() : nullptr;
+}
+
 } // namespace mbgl
@@ -7,6 +7,7 @@
 #include <mbgl/actor/actor.hpp>
 
 #include <atomic>
+#include <list>
 #include <memory>
 #include <unordered_map>
 #include <vector>
@@ -41,11 +42,15 @@ public:
     Bucket* getBucket(const style::Layer&) override;
 
     void queryRenderedFeatures(
-            std::unordered_map<std::string, std::vector<Feature>>& result,
+            std::unordered_map<std::string, std::vector<LazyFeature>>& result,
             const GeometryCoordinates& queryGeometry,
             const TransformState&,
+            const QueryLayers&,
             const optional<std::vector<std::string>>& layerIDs) override;
 
+    optional<TileFeatureIndex> snapshotFeatureIndex() const override;
+    std::unique_ptr<GeometryTileData> cloneData() const override;
+
     void cancel() override;
 
     class LayoutResult {
@@ -81,11 +86,21 @@ private:
     optional<PlacementConfig> requestedConfig;
 
     std::unordered_map<std::string, std::shared_ptr<Bucket>> nonSymbolBuckets;
-    std::unique_ptr<FeatureIndex> featureIndex;
-    std::unique_ptr<const GeometryTileData> data;
+    std::shared_ptr<const FeatureIndex> featureIndex;
+    std::shared_ptr<const GeometryTileData> data;
 
     std::unordered_map<std::string, std::shared_ptr<Bucket>> symbolBuckets;
-    std::unique_ptr<CollisionTile> collisionTile;
+    std::shared_ptr<CollisionTile> collisionTile;
+
+    // Placements made for the current layout, most recently used first, keyed by the config
+    // of their collision tiles. Returning to a config that was placed before shows its placement
+    // again without waiting for the worker.
+    struct Placement {
+        std::unordered_map<std::string, std::shared_ptr<Bucket>> symbolBuckets;
+        std::shared_ptr<CollisionTile> collisionTile;
+    };
+    std::list<Placement> placements;
+    static const std::size_t maxPlacements = 8;
 };
 
 } // namespace mbgl
@@ -63,6 +63,7 @@ void limitHoles(GeometryCollection&, uint32_t maxHoles);
 
 // convert from GeometryTileFeature to Feature (eventually we should eliminate GeometryTileFeature)
 Feature convertFeature(const GeometryTileFeature&, const CanonicalTileID&);
+Feature::geometry_type convertGeometry(const GeometryTileFeature&, const CanonicalTileID&);
 
 // Fix up possibly-non-V2-compliant polygon geometry using angus clipper.
 // The result is guaranteed to have correctly wound, strictly simple rings.
@@ -71,6 +71,8 @@ GeometryTileWorker::~GeometryTileWorker() {
    read all the queued messages until we get to "coalesced", and then redo either
    layout or placement if there were one or more "set"s (with layout taking priority,
    since it will trigger placement when complete), or return to the [idle] state if not.
+
+   "setPlacedConfig" only records the config for later placements and never changes the state.
 */
 
 void GeometryTileWorker::setData(std::unique_ptr<const GeometryTileData> data_, uint64_t correlationID_) {
@@ -143,6 +145,13 @@ void GeometryTileWorker::setPlacementConfig(PlacementConfig placementConfig_, ui
     }
 }
 
+// The parent already has a placement for this config, made for the current layout. Use the
+// config for placements after later layouts, but don't place now.
+void GeometryTileWorker::setPlacedConfig(PlacementConfig placementConfig_, uint64_t correlationID_) {
+    placementConfig = std::move(placementConfig_);
+    correlationID = correlationID_;
+}
+
 void GeometryTileWorker::symbolDependenciesChanged() {
     try {
         switch (state) {
@@ -238,14 +247,14 @@ void GeometryTileWorker::redoLayout() {
             layerIDs.push_back(layer->getID());
         }
 
-        featureIndex->setBucketLayerIDs(leader.getID(), layerIDs);
+        const uint32_t sourceLayerID = featureIndex->getSourceLayerID(leader.baseImpl->sourceLayer);
+        const uint32_t bucketID = featureIndex->addBucket(layerIDs);
 
         if (leader.is<SymbolLayer>()) {
             symbolLayoutMap.emplace(leader.getID(),
-                leader.as<SymbolLayer>()->impl->createLayout(parameters, group, *geometryLayer));
+                leader.as<SymbolLayer>()->impl->createLayout(parameters, group, *geometryLayer, sourceLayerID, bucketID));
         } else {
             const Filter& filter = leader.baseImpl->filter;
-            const std::string& sourceLayerID = leader.baseImpl->sourceLayer;
             std::shared_ptr<Bucket> bucket = leader.baseImpl->createBucket(parameters, group);
 
             for (std::size_t i = 0; !obsolete && i < geometryLayer->featureCount(); i++) {
@@ -256,7 +265,7 @@ void GeometryTileWorker::redoLayout() {
 
                 GeometryCollection geometries = feature->getGeometries();
                 bucket->addFeature(*feature, geometries);
-                featureIndex->insert(geometries, i, sourceLayerID, leader.getID());
+                featureIndex->insert(geometries, i, sourceLayerID, bucketID);
             }
 
             if (!bucket->hasData()) {
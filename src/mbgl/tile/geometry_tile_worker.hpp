@@ -34,6 +34,7 @@ public:
     void setLayers(std::vector<std::unique_ptr<style::Layer>>, uint64_t correlationID);
     void setData(std::unique_ptr<const GeometryTileData>, uint64_t correlationID);
     void setPlacementConfig(PlacementConfig, uint64_t correlationID);
+    void setPlacedConfig(PlacementConfig, uint64_t correlationID);
     void symbolDependenciesChanged();
 
 private:
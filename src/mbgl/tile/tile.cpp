@@ -29,9 +29,18 @@ void Tile::dumpDebugLogs() const {
 }
 
 void Tile::queryRenderedFeatures(
-        std::unordered_map<std::string, std::vector<Feature>>&,
+        std::unordered_map<std::string, std::vector<LazyFeature>>&,
         const GeometryCoordinates&,
         const TransformState&,
+        const QueryLayers&,
         const optional<std::vector<std::string>>&) {}
 
+optional<TileFeatureIndex> Tile::snapshotFeatureIndex() const {
+    return {};
+}
+
+std::unique_ptr<GeometryTileData> Tile::cloneData() const {
+    return nullptr;
+}
+
 } // namespace mbgl
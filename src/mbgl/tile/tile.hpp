@@ -4,6 +4,7 @@
 #include <mbgl/util/chrono.hpp>
 #include <mbgl/util/optional.hpp>
 #include <mbgl/util/feature.hpp>
+#include <mbgl/util/lazy_feature.hpp>
 #include <mbgl/util/tile_coordinate.hpp>
 #include <mbgl/tile/tile_id.hpp>
 #include <mbgl/renderer/bucket.hpp>
@@ -21,11 +22,24 @@ class DebugBucket;
 class TransformState;
 class TileObserver;
 class PlacementConfig;
+class FeatureIndex;
+class CollisionTile;
+class QueryLayers;
 
 namespace style {
 class Layer;
 } // namespace style
 
+// A tile's feature index along with the tile data and symbol placement that it refers to. None
+// of these change once captured, so the snapshot can be queried on another thread.
+class TileFeatureIndex {
+public:
+    OverscaledTileID id;
+    std::shared_ptr<const FeatureIndex> featureIndex;
+    std::shared_ptr<const GeometryTileData> data;
+    std::shared_ptr<const CollisionTile> collisionTile;
+};
+
 class Tile : private util::noncopyable {
 public:
     Tile(OverscaledTileID);
@@ -52,11 +66,20 @@ public:
     virtual void redoLayout() {}
 
     virtual void queryRenderedFeatures(
-            std::unordered_map<std::string, std::vector<Feature>>& result,
+            std::unordered_map<std::string, std::vector<LazyFeature>>& result,
             const GeometryCoordinates& queryGeometry,
             const TransformState&,
+            const QueryLayers&,
             const optional<std::vector<std::string>>& layerIDs);
 
+    // Captures what queryRenderedFeatures() reads, so that the query can run off the main
+    // thread. Returns nothing if the tile has no features to query.
+    virtual optional<TileFeatureIndex> snapshotFeatureIndex() const;
+
+    // Returns a copy of the tile's data that can be read on another thread, or nullptr if the
+    // tile has no data loaded.
+    virtual std::unique_ptr<GeometryTileData> cloneData() const;
+
     void setTriedOptional();
 
     // Returns true when the tile source has received a first response, regardless of whether a load
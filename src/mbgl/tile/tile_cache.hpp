@@ -2,6 +2,7 @@
 
 #include <mbgl/tile/tile_id.hpp>
 
+#include <functional>
 #include <list>
 #include <memory>
 #include <map>
@@ -21,6 +22,9 @@ public:
     bool has(const OverscaledTileID& key);
     void clear();
 
+    // Removes the tiles whose keys match the predicate.
+    void remove(const std::function<bool (const OverscaledTileID&)>&);
+
 private:
     std::map<OverscaledTileID, std::unique_ptr<Tile>> tiles;
     std::list<OverscaledTileID> orderedKeys;
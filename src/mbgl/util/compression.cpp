@@ -2,6 +2,7 @@
 
 #include <zlib.h>
 
+#include <algorithm>
 #include <cstdio>
 #include <cstring>
 #include <stdexcept>
@@ -22,7 +23,9 @@ const static bool zlibVersionCheck __attribute__((unused)) = []() {
 namespace mbgl {
 namespace util {
 
-std::string compress(const std::string &raw) {
+namespace {
+
+std::string compress(const std::string &raw, const std::string *dictionary) {
     z_stream deflate_stream;
     memset(&deflate_stream, 0, sizeof(deflate_stream));
 
@@ -31,6 +34,13 @@ std::string compress(const std::string &raw) {
         throw std::runtime_error("failed to initialize deflate");
     }
 
+    if (dictionary &&
+        deflateSetDictionary(&deflate_stream, reinterpret_cast<const Bytef *>(dictionary->data()),
+                             uInt(dictionary->size())) != Z_OK) {
+        deflateEnd(&deflate_stream);
+        throw std::runtime_error("failed to set deflate dictionary");
+    }
+
     deflate_stream.next_in = (Bytef *)raw.data();
     deflate_stream.avail_in = uInt(raw.size());
 
@@ -57,29 +67,35 @@ std::string compress(const std::string &raw) {
     return result;
 }
 
-std::string decompress(const std::string &raw) {
+std::string decompress(const std::string &raw, const std::string *dictionary) {
     z_stream inflate_stream;
     memset(&inflate_stream, 0, sizeof(inflate_stream));
 
     // TODO: reuse z_streams
-    if (inflateInit(&inflate_stream) != Z_OK) {
+    // Adding 32 to the window bits makes zlib detect and accept both zlib and gzip headers.
+    if (inflateInit2(&inflate_stream, MAX_WBITS + 32) != Z_OK) {
         throw std::runtime_error("failed to initialize inflate");
     }
 
     inflate_stream.next_in = (Bytef *)raw.data();
     inflate_stream.avail_in = uInt(raw.size());
 
-    std::string result;
-    char out[15384];
+    // Inflate straight into the result, growing it geometrically, instead of copying
+    // every block out of an intermediate buffer. Compressed tiles typically expand by
+    // a factor of three or so.
+    std::string result(std::max<std::size_t>(raw.size() * 4, 1024), '\0');
 
     int code;
     do {
-        inflate_stream.next_out = reinterpret_cast<Bytef *>(out);
-        inflate_stream.avail_out = sizeof(out);
-        code = inflate(&inflate_stream, 0);
-        // result.append(out, sizeof(out) - inflate_stream.avail_out);
-        if (result.size() < inflate_stream.total_out) {
-            result.append(out, inflate_stream.total_out - result.size());
+        if (inflate_stream.total_out == result.size()) {
+            result.resize(result.size() * 2);
+        }
+        inflate_stream.next_out = reinterpret_cast<Bytef *>(&result[inflate_stream.total_out]);
+        inflate_stream.avail_out = uInt(result.size() - inflate_stream.total_out);
+        code = inflate(&inflate_stream, Z_NO_FLUSH);
+        if (code == Z_NEED_DICT && dictionary) {
+            code = inflateSetDictionary(&inflate_stream, reinterpret_cast<const Bytef *>(dictionary->data()),
+                                        uInt(dictionary->size()));
         }
     } while (code == Z_OK);
 
@@ -89,7 +105,27 @@ std::string decompress(const std::string &raw) {
         throw std::runtime_error(inflate_stream.msg ? inflate_stream.msg : "decompression error");
     }
 
+    result.resize(inflate_stream.total_out);
     return result;
 }
+
+} // namespace
+
+std::string compress(const std::string &raw) {
+    return compress(raw, nullptr);
+}
+
+std::string decompress(const std::string &raw) {
+    return decompress(raw, nullptr);
+}
+
+std::string compress(const std::string &raw, const std::string &dictionary) {
+    return compress(raw, &dictionary);
+}
+
+std::string decompress(const std::string &raw, const std::string &dictionary) {
+    return decompress(raw, &dictionary);
+}
+
 } // namespace util
 } // namespace mbgl
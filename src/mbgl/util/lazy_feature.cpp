@@ -0,0 +1,51 @@
+#include <mbgl/util/lazy_feature.hpp>
+#include <mbgl/util/lazy_feature_impl.hpp>
+
+#include <cassert>
+
+namespace mbgl {
+
+LazyFeature::LazyFeature(std::shared_ptr<const Impl> impl_)
+    : impl(std::move(impl_)) {
+    assert(impl);
+}
+
+optional<FeatureIdentifier> LazyFeature::getID() const {
+    return impl->feature->getID();
+}
+
+optional<Value> LazyFeature::getProperty(const std::string& key) const {
+    return impl->feature->getValue(key);
+}
+
+PropertyMap LazyFeature::getProperties() const {
+    return impl->feature->getProperties();
+}
+
+PropertyMap LazyFeature::getProperties(const std::vector<std::string>& keys) const {
+    PropertyMap properties;
+    for (const auto& key : keys) {
+        auto value = impl->feature->getValue(key);
+        if (value) {
+            properties.emplace(key, std::move(*value));
+        }
+    }
+    return properties;
+}
+
+Feature::geometry_type LazyFeature::getGeometry() const {
+    return convertGeometry(*impl->feature, impl->tileID);
+}
+
+Feature LazyFeature::toFeature() const {
+    return convertFeature(*impl->feature, impl->tileID);
+}
+
+Feature LazyFeature::toFeature(const std::vector<std::string>& keys) const {
+    Feature feature { getGeometry() };
+    feature.properties = getProperties(keys);
+    feature.id = getID();
+    return feature;
+}
+
+} // namespace mbgl
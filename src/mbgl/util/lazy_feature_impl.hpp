@@ -0,0 +1,27 @@
+#pragma once
+
+#include <mbgl/util/lazy_feature.hpp>
+#include <mbgl/tile/geometry_tile_data.hpp>
+#include <mbgl/tile/tile_id.hpp>
+
+#include <memory>
+
+namespace mbgl {
+
+class LazyFeature::Impl {
+public:
+    Impl(std::shared_ptr<const GeometryTileData> data_,
+         std::unique_ptr<const GeometryTileFeature> feature_,
+         const CanonicalTileID& tileID_)
+        : data(std::move(data_)),
+          feature(std::move(feature_)),
+          tileID(tileID_) {
+    }
+
+    // Declared before the feature, which may refer into it, so that it's destroyed after.
+    const std::shared_ptr<const GeometryTileData> data;
+    const std::unique_ptr<const GeometryTileFeature> feature;
+    const CanonicalTileID tileID;
+};
+
+} // namespace mbgl
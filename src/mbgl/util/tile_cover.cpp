@@ -155,6 +155,85 @@ std::vector<UnwrappedTileID> tileCover(const LatLngBounds& bounds_, int32_t z) {
         z);
 }
 
+uint64_t tileCount(const LatLngBounds& bounds, int32_t z) {
+    auto range = BoundsTileCover::tileRange(bounds, z);
+    return range ? uint64_t(range->maxX - range->minX) * uint64_t(range->maxY - range->minY) : 0;
+}
+
+BoundsTileCover::BoundsTileCover(const LatLngBounds& bounds_, const Range<uint8_t>& zoomRange)
+    : bounds(bounds_),
+      z(zoomRange.min),
+      maxZ(zoomRange.max) {
+    if (!done()) {
+        range = tileRange(bounds, z).value_or(TileRange { 0, 0, 0, 0 });
+        x = range.minX;
+        y = range.minY;
+        seek();
+    }
+}
+
+optional<UnwrappedTileID> BoundsTileCover::next() {
+    if (done()) {
+        return {};
+    }
+
+    UnwrappedTileID result { uint8_t(z), x, y };
+
+    if (++y == range.maxY) {
+        y = range.minY;
+        x++;
+    }
+    seek();
+
+    return result;
+}
+
+// Moves on to the first tile of the next non-empty zoom level once the current one is exhausted.
+void BoundsTileCover::seek() {
+    while (x >= range.maxX || range.minY == range.maxY) {
+        if (++z > maxZ) {
+            return;
+        }
+        range = tileRange(bounds, z).value_or(TileRange { 0, 0, 0, 0 });
+        x = range.minX;
+        y = range.minY;
+    }
+}
+
+// The bounds are a rectangle in tile space, so the tiles tileCover() finds by scanning it are
+// exactly the columns and rows it touches, clipped vertically to the world. Rectangles
+// without height don't cover any tiles.
+optional<BoundsTileCover::TileRange> BoundsTileCover::tileRange(const LatLngBounds& bounds_, int32_t z) {
+    if (bounds_.isEmpty() ||
+        bounds_.south() >  util::LATITUDE_MAX ||
+        bounds_.north() < -util::LATITUDE_MAX) {
+        return {};
+    }
+
+    LatLngBounds bounds = LatLngBounds::hull(
+        { std::max(bounds_.south(), -util::LATITUDE_MAX), bounds_.west() },
+        { std::min(bounds_.north(),  util::LATITUDE_MAX), bounds_.east() });
+
+    const Point<double> nw = TileCoordinate::fromLatLng(z, bounds.northwest()).p;
+    const Point<double> se = TileCoordinate::fromLatLng(z, bounds.southeast()).p;
+
+    if (nw.y == se.y) {
+        return {};
+    }
+
+    const int64_t tiles = int64_t(1) << z;
+    TileRange range {
+        int64_t(std::floor(nw.x)), int64_t(std::ceil(se.x)),
+        std::max<int64_t>(std::floor(nw.y), 0), std::min<int64_t>(std::ceil(se.y), tiles)
+    };
+
+    if (range.minX >= range.maxX || range.minY >= range.maxY) {
+        return {};
+    }
+
+    return range;
+}
+
 std::vector<UnwrappedTileID> tileCover(const TransformState& state, int32_t z) {
     const double w = state.getSize().width;
     const double h = state.getSize().height;
@@ -3,13 +3,15 @@
 #include <mbgl/tile/tile_id.hpp>
 #include <mbgl/style/types.hpp>
 #include <mbgl/util/tile_coordinate.hpp>
+#include <mbgl/util/geo.hpp>
+#include <mbgl/util/optional.hpp>
+#include <mbgl/util/range.hpp>
 
 #include <vector>
 
 namespace mbgl {
 
 class TransformState;
-class LatLngBounds;
 
 namespace util {
 
@@ -18,5 +20,38 @@ int32_t coveringZoomLevel(double z, SourceType type, uint16_t tileSize);
 std::vector<UnwrappedTileID> tileCover(const TransformState&, int32_t z);
 std::vector<UnwrappedTileID> tileCover(const LatLngBounds&, int32_t z);
 
+// Number of tiles tileCover() returns for the bounds at the given zoom level, computed
+// arithmetically instead of by enumerating them.
+uint64_t tileCount(const LatLngBounds&, int32_t z);
+
+// Produces the tiles covering a bounding box over a range of zoom levels one at a time, so
+// that even very large covers never need to be held in memory. The tiles are the same as
+// those tileCover() returns for each zoom level, ordered by zoom level, x and y.
+class BoundsTileCover {
+public:
+    BoundsTileCover(const LatLngBounds&, const Range<uint8_t>& zoomRange);
+
+    bool done() const { return z > maxZ; }
+    optional<UnwrappedTileID> next();
+
+private:
+    struct TileRange {
+        int64_t minX, maxX; // exclusive
+        int64_t minY, maxY; // exclusive
+    };
+
+    static optional<TileRange> tileRange(const LatLngBounds&, int32_t z);
+    void seek();
+
+    LatLngBounds bounds;
+    int32_t z;
+    int32_t maxZ;
+    TileRange range { 0, 0, 0, 0 };
+    int64_t x = 0;
+    int64_t y = 0;
+
+    friend uint64_t tileCount(const LatLngBounds&, int32_t z);
+};
+
 } // namespace util
 } // namespace mbgl
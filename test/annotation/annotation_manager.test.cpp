@@ -0,0 +1,68 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/annotation/annotation_manager.hpp>
+#include <mbgl/annotation/annotation_tile.hpp>
+#include <mbgl/tile/tile_id.hpp>
+#include <mbgl/util/run_loop.hpp>
+#include <mbgl/util/string.hpp>
+
+using namespace mbgl;
+
+namespace {
+
+std::string shapeLayerID(AnnotationID id) {
+    return "com.mapbox.annotations.shape." + util::toString(id);
+}
+
+// Whether the shape with the given ID has geometry in the given tile.
+bool hasShape(AnnotationManager& manager, const CanonicalTileID& tileID, AnnotationID id) {
+    auto data = manager.getTileData(tileID);
+    return data && data->getLayer(shapeLayerID(id));
+}
+
+} // namespace
+
+TEST(AnnotationManager, ShapeInTileBuffer) {
+    util::RunLoop loop;
+    AnnotationManager manager { 1.0 };
+
+    // Tile 2/1/1 spans longitudes -90 to 0, and its buffer extends about 5.6 degrees past them.
+    const AnnotationID inBuffer = manager.addAnnotation(
+        LineAnnotation { LineString<double> {{ { 3, 20 }, { 3, 40 } }} }, 16);
+    const AnnotationID outsideBuffer = manager.addAnnotation(
+        LineAnnotation { LineString<double> {{ { 10, 20 }, { 10, 40 } }} }, 16);
+
+    EXPECT_TRUE(hasShape(manager, { 2, 1, 1 }, inBuffer));
+    EXPECT_FALSE(hasShape(manager, { 2, 1, 1 }, outsideBuffer));
+
+    EXPECT_TRUE(hasShape(manager, { 2, 2, 1 }, inBuffer));
+    EXPECT_TRUE(hasShape(manager, { 2, 2, 1 }, outsideBuffer));
+}
+
+TEST(AnnotationManager, ShapeAcrossAntimeridian) {
+    util::RunLoop loop;
+    AnnotationManager manager { 1.0 };
+
+    const AnnotationID line = manager.addAnnotation(
+        LineAnnotation { LineString<double> {{ { 179, 20 }, { 181, 20 } }} }, 16);
+
+    // The part east of the antimeridian wraps around into the westernmost tiles.
+    EXPECT_TRUE(hasShape(manager, { 2, 3, 1 }, line));
+    EXPECT_TRUE(hasShape(manager, { 2, 0, 1 }, line));
+    EXPECT_FALSE(hasShape(manager, { 2, 1, 1 }, line));
+}
+
+TEST(AnnotationManager, UpdatedShapeLeavesOldTiles) {
+    util::RunLoop loop;
+    AnnotationManager manager { 1.0 };
+
+    LineAnnotation annotation { LineString<double> {{ { -45, 20 }, { -40, 40 } }} };
+    const AnnotationID line = manager.addAnnotation(annotation, 16);
+    EXPECT_TRUE(hasShape(manager, { 2, 1, 1 }, line));
+    EXPECT_FALSE(hasShape(manager, { 2, 3, 2 }, line));
+
+    annotation.geometry = LineString<double> {{ { 100, -20 }, { 110, -30 } }};
+    manager.updateAnnotation(line, annotation, 16);
+    EXPECT_FALSE(hasShape(manager, { 2, 1, 1 }, line));
+    EXPECT_TRUE(hasShape(manager, { 2, 3, 2 }, line));
+}
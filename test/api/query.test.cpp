@@ -1,4 +1,5 @@
 #include <mbgl/map/map.hpp>
+#include <mbgl/map/query.hpp>
 #include <mbgl/gl/headless_backend.hpp>
 #include <mbgl/gl/offscreen_view.hpp>
 #include <mbgl/util/default_thread_pool.hpp>
@@ -8,6 +9,7 @@
 #include <mbgl/util/image.hpp>
 #include <mbgl/util/io.hpp>
 #include <mbgl/util/run_loop.hpp>
+#include <mbgl/util/async_request.hpp>
 
 using namespace mbgl;
 
@@ -62,3 +64,84 @@ TEST(Query, QueryRenderedFeaturesFilterLayer) {
     auto features4 = test.map.queryRenderedFeatures(zz, {{ "foobar", "layer3" }});
     EXPECT_EQ(features4.size(), 1u);
 }
+
+TEST(Query, QueryRenderedFeaturesLazy) {
+    QueryTest test;
+
+    auto zz = test.map.pixelForLatLng({ 0, 0 });
+    auto expected = test.map.queryRenderedFeatures(zz);
+    auto features = test.map.queryRenderedFeaturesLazy(zz);
+    ASSERT_EQ(features.size(), expected.size());
+
+    for (std::size_t i = 0; i < features.size(); ++i) {
+        EXPECT_EQ(features[i].toFeature(), expected[i]);
+        EXPECT_EQ(features[i].getID(), expected[i].id);
+        EXPECT_EQ(features[i].getGeometry(), expected[i].geometry);
+        EXPECT_FALSE(features[i].getProperty("foobar"));
+        EXPECT_TRUE(features[i].getProperties({ "foobar" }).empty());
+    }
+
+    EXPECT_EQ(test.map.queryRenderedFeaturesLazy(zz, {{ "layer1" }}).size(), 1u);
+    EXPECT_EQ(test.map.queryRenderedFeaturesLazy(test.map.pixelForLatLng({ 9, 9 })).size(), 0u);
+}
+
+TEST(Query, QueryRenderedFeaturesAsync) {
+    QueryTest test;
+
+    auto zz = test.map.pixelForLatLng({ 0, 0 });
+    auto expected = test.map.queryRenderedFeatures(zz, {{ "layer1", "layer2", "layer3" }});
+    ASSERT_EQ(expected.size(), 3u);
+
+    auto request = test.map.queryRenderedFeatures(zz, {{ "layer1", "layer2", "layer3" }}, [&] (std::vector<Feature> features) {
+        EXPECT_EQ(features, expected);
+        test.loop.stop();
+    });
+
+    test.loop.run();
+}
+
+TEST(Query, QueryRenderedFeaturesAsyncCancel) {
+    QueryTest test;
+
+    auto zz = test.map.pixelForLatLng({ 0, 0 });
+
+    auto superseded = test.map.queryRenderedFeatures(zz, {}, [&] (std::vector<Feature>) {
+        FAIL() << "A cancelled query must not call back";
+    });
+
+    auto request = test.map.queryRenderedFeatures(zz, {{ "layer1" }}, [&] (std::vector<Feature> features) {
+        EXPECT_EQ(features.size(), 1u);
+        test.loop.stop();
+    });
+
+    superseded.reset();
+    test.loop.run();
+}
+
+TEST(Query, QuerySourceFeatures) {
+    QueryTest test;
+
+    auto query = [&] (const std::string& sourceID, const SourceQueryOptions& options) {
+        std::vector<Feature> result;
+        auto request = test.map.querySourceFeatures(sourceID, options, [&] (std::vector<Feature> features) {
+            result = std::move(features);
+            test.loop.stop();
+        });
+        test.loop.run();
+        return result;
+    };
+
+    SourceQueryOptions options;
+    EXPECT_EQ(query("source1", options).size(), 1u);
+    EXPECT_EQ(query("foobar", options).size(), 0u);
+
+    options.filter = style::EqualsFilter { "foo", std::string("bar") };
+    EXPECT_EQ(query("source1", options).size(), 0u);
+
+    options.filter = style::NullFilter();
+    options.bounds = LatLngBounds::hull({ -1, -1 }, { 1, 1 });
+    EXPECT_EQ(query("source1", options).size(), 1u);
+
+    options.bounds = LatLngBounds::hull({ 40, 40 }, { 50, 50 });
+    EXPECT_EQ(query("source1", options).size(), 0u);
+}
@@ -1,4 +1,5 @@
 #include <mbgl/test/util.hpp>
+#include <mbgl/test/stub_file_source.hpp>
 
 #include <mbgl/renderer/circle_bucket.hpp>
 #include <mbgl/renderer/fill_bucket.hpp>
@@ -6,6 +7,17 @@
 #include <mbgl/renderer/symbol_bucket.hpp>
 #include <mbgl/style/bucket_parameters.hpp>
 #include <mbgl/style/layers/symbol_layer_properties.hpp>
+#include <mbgl/style/layers/symbol_layer.hpp>
+#include <mbgl/layout/symbol_layout.hpp>
+#include <mbgl/annotation/annotation_tile.hpp>
+#include <mbgl/sprite/sprite_atlas.hpp>
+#include <mbgl/sprite/sprite_image.hpp>
+#include <mbgl/text/glyph_atlas.hpp>
+#include <mbgl/text/collision_tile.hpp>
+#include <mbgl/gl/headless_backend.hpp>
+#include <mbgl/gl/context.hpp>
+#include <mbgl/util/default_thread_pool.hpp>
+#include <mbgl/util/run_loop.hpp>
 
 #include <mbgl/map/mode.hpp>
 
@@ -36,3 +48,171 @@ TEST(Buckets, SymbolBucket) {
     ASSERT_FALSE(bucket.hasTextData());
     ASSERT_FALSE(bucket.hasCollisionBoxData());
 }
+
+namespace {
+
+// Lays out an icon for each point added to a tile.
+class SymbolLayoutTest {
+public:
+    util::RunLoop loop;
+    StubFileSource fileSource;
+    ThreadPool threadPool { 1 };
+    GlyphAtlas glyphAtlas { { 512, 512 }, fileSource, threadPool };
+    SpriteAtlas spriteAtlas { { 512, 512 }, 1 };
+    style::SymbolLayer layer { "symbol", "source" };
+    AnnotationTileLayer tileLayer { "layer" };
+
+    SymbolLayoutTest() {
+        spriteAtlas.load("", fileSource);
+        spriteAtlas.setSprite("marker", std::make_shared<SpriteImage>(PremultipliedImage({ 2, 2 }), 1.0));
+        layer.setSourceLayer("layer");
+        layer.setIconImage(std::string("marker"));
+    }
+
+    void addPoint(int16_t x, int16_t y) {
+        tileLayer.features.emplace_back(tileLayer.features.size(), FeatureType::Point,
+                                        GeometryCollection { { GeometryCoordinate(x, y) } });
+    }
+
+    std::unique_ptr<SymbolLayout> createLayout() {
+        auto symbolLayout = std::make_unique<SymbolLayout>(
+            style::BucketParameters { OverscaledTileID(0, 0, 0), MapMode::Continuous },
+            std::vector<const style::Layer*> { &layer }, tileLayer, 0, 0, spriteAtlas);
+        EXPECT_TRUE(symbolLayout->canPrepare(glyphAtlas));
+        symbolLayout->prepare(0, glyphAtlas);
+        return symbolLayout;
+    }
+};
+
+// Whether each quad of a buffer is shown by its placement. Hidden quads have a zero max zoom.
+std::vector<bool> shownQuads(const SymbolBucket::SymbolBuffer& buffer) {
+    std::vector<bool> result;
+    for (std::size_t i = 0; i < buffer.placementVertices.vertexSize(); i += 4) {
+        result.push_back(buffer.placementVertices.data()[i].a1[3] != 0);
+    }
+    return result;
+}
+
+// Checks that the triangles of a buffer address the vertices of shown quads only, and within
+// the segments they belong to.
+void checkTriangles(const SymbolBucket::SymbolBuffer& buffer) {
+    const std::vector<bool> shown = shownQuads(buffer);
+    std::size_t indexLength = 0;
+
+    for (const auto& segment : buffer.segments) {
+        EXPECT_EQ(0u, segment.vertexOffset % SymbolQuadVertices::segmentSize);
+        EXPECT_LE(segment.vertexLength, SymbolQuadVertices::segmentSize);
+        EXPECT_EQ(indexLength, segment.indexOffset);
+
+        for (std::size_t i = segment.indexOffset; i < segment.indexOffset + segment.indexLength; i++) {
+            const uint16_t index = buffer.triangles.data()[i];
+            ASSERT_LT(index, segment.vertexLength);
+            EXPECT_TRUE(shown[(segment.vertexOffset + index) / 4]);
+        }
+        indexLength += segment.indexLength;
+    }
+
+    EXPECT_EQ(buffer.triangles.indexSize(), indexLength);
+}
+
+} // namespace
+
+TEST(Buckets, SymbolPlacementVertices) {
+    SymbolLayoutTest test;
+
+    // The second icon collides with the first one, so it isn't shown.
+    test.addPoint(100, 100);
+    test.addPoint(100, 100);
+    test.addPoint(3000, 3000);
+    auto layout = test.createLayout();
+
+    CollisionTile collisionTile(PlacementConfig {});
+    auto bucket = layout->place(collisionTile);
+
+    // Every quad has a placement, whether it's shown or not.
+    ASSERT_TRUE(bucket->hasIconData());
+    ASSERT_EQ(12u, bucket->icon.quadVertices->vertices.vertexSize());
+    EXPECT_EQ(12u, bucket->icon.placementVertices.vertexSize());
+    EXPECT_EQ(bucket->text.quadVertices->vertices.vertexSize(), bucket->text.placementVertices.vertexSize());
+
+    // Only the shown quads have triangles.
+    EXPECT_EQ(std::vector<bool>({ true, false, true }), shownQuads(bucket->icon));
+    EXPECT_EQ(12u, bucket->icon.triangles.indexSize());
+    checkTriangles(bucket->icon);
+
+    // Placing the layout again, into a collision tile where every icon now collides, keeps the
+    // quad vertices and rebuilds only the placements and triangles.
+    auto replaced = layout->place(collisionTile);
+    EXPECT_EQ(bucket->icon.quadVertices, replaced->icon.quadVertices);
+    EXPECT_EQ(12u, replaced->icon.placementVertices.vertexSize());
+    EXPECT_EQ(std::vector<bool>({ false, false, false }), shownQuads(replaced->icon));
+    EXPECT_EQ(0u, replaced->icon.triangles.indexSize());
+    checkTriangles(replaced->icon);
+
+    // The earlier placement is unaffected.
+    EXPECT_EQ(std::vector<bool>({ true, false, true }), shownQuads(bucket->icon));
+}
+
+TEST(Buckets, SymbolQuadVertexBufferIsShared) {
+    SymbolLayoutTest test;
+    test.addPoint(100, 100);
+    auto layout = test.createLayout();
+
+    CollisionTile first(PlacementConfig {});
+    CollisionTile second(PlacementConfig { 1.0f, 0.0f });
+    auto a = layout->place(first);
+    auto b = layout->place(second);
+
+    HeadlessBackend backend { test::sharedDisplay() };
+    gl::Context& context = backend.getContext();
+
+    // The quad vertices are uploaded once, by the first bucket; each placement has its own.
+    a->upload(context);
+    b->upload(context);
+    ASSERT_TRUE(a->icon.vertexBuffer);
+    EXPECT_EQ(a->icon.vertexBuffer, b->icon.vertexBuffer);
+    EXPECT_TRUE(a->icon.placementVertexBuffer && b->icon.placementVertexBuffer);
+
+    // The buffer lives as long as a bucket uses it, and is created again after that.
+    auto quadVertices = a->icon.quadVertices;
+    a.reset();
+    EXPECT_FALSE(quadVertices->vertexBuffer.expired());
+    b.reset();
+    EXPECT_TRUE(quadVertices->vertexBuffer.expired());
+
+    CollisionTile third(PlacementConfig {});
+    auto c = layout->place(third);
+    c->upload(context);
+    EXPECT_TRUE(c->icon.vertexBuffer);
+    EXPECT_EQ(c->icon.vertexBuffer, quadVertices->vertexBuffer.lock());
+}
+
+TEST(Buckets, SymbolSegmentsSplitAtVertexLimit) {
+    SymbolLayoutTest test;
+    test.layer.setIconAllowOverlap(true);
+    test.layer.setIconIgnorePlacement(true);
+
+    // One quad more than fits in a segment. All icons are on one row, so they're drawn in the
+    // reverse of their vertex order, starting with the one in the second segment.
+    const std::size_t quadCount = SymbolQuadVertices::segmentSize / 4 + 1;
+    for (std::size_t i = 0; i < quadCount; i++) {
+        test.addPoint(i % util::EXTENT, 100);
+    }
+    auto layout = test.createLayout();
+
+    CollisionTile collisionTile(PlacementConfig {});
+    auto bucket = layout->place(collisionTile);
+
+    ASSERT_EQ(quadCount * 4, bucket->icon.quadVertices->vertices.vertexSize());
+    EXPECT_EQ(quadCount * 4, bucket->icon.placementVertices.vertexSize());
+    EXPECT_EQ(quadCount * 6, bucket->icon.triangles.indexSize());
+
+    ASSERT_EQ(2u, bucket->icon.segments.size());
+    EXPECT_EQ(SymbolQuadVertices::segmentSize, bucket->icon.segments[0].vertexOffset);
+    EXPECT_EQ(4u, bucket->icon.segments[0].vertexLength);
+    EXPECT_EQ(6u, bucket->icon.segments[0].indexLength);
+    EXPECT_EQ(0u, bucket->icon.segments[1].vertexOffset);
+    EXPECT_EQ(SymbolQuadVertices::segmentSize, bucket->icon.segments[1].vertexLength);
+    EXPECT_EQ((quadCount - 1) * 6, bucket->icon.segments[1].indexLength);
+    checkTriangles(bucket->icon);
+}
@@ -15,6 +15,7 @@
 #include <mbgl/util/io.hpp>
 #include <mbgl/util/run_loop.hpp>
 #include <mbgl/util/async_task.hpp>
+#include <mbgl/style/binary_style.hpp>
 #include <mbgl/style/layers/background_layer.hpp>
 #include <mbgl/util/color.hpp>
 
@@ -136,6 +137,36 @@ TEST(Map, DoubleStyleLoad) {
     map.setStyleJSON("");
 }
 
+TEST(Map, StyleBinary) {
+    MapTest test;
+
+    Map map(test.backend, test.view.size, 1, test.fileSource, test.threadPool, MapMode::Still);
+
+    unsigned loads = 0;
+    test.backend.setMapChangeCallback([&](MapChange change) {
+        if (change == mbgl::MapChangeWillStartLoadingMap) {
+            loads++;
+        }
+    });
+
+    const std::string json = util::read_file("test/fixtures/api/empty.json");
+    const std::string binary = style::encodeBinaryStyle(json);
+
+    // Like JSON styles, an unchanged binary style isn't loaded again.
+    map.setStyleBinary(binary);
+    map.setStyleBinary(binary);
+    EXPECT_EQ(1u, loads);
+    EXPECT_EQ("", map.getStyleURL());
+    EXPECT_EQ(style::decodeBinaryStyle(binary), map.getStyleJSON());
+
+    map.setStyleJSON(json);
+    EXPECT_EQ(2u, loads);
+    EXPECT_EQ(json, map.getStyleJSON());
+
+    map.setStyleBinary(binary);
+    EXPECT_EQ(3u, loads);
+}
+
 TEST(Map, StyleFresh) {
     // The map should not revalidate fresh styles.
 
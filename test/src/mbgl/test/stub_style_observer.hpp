@@ -10,6 +10,14 @@ using namespace mbgl::style;
  */
 class StubStyleObserver : public style::Observer {
 public:
+    void onStyleLoaded() override {
+        if (styleLoaded) styleLoaded();
+    }
+
+    void onStyleError() override {
+        if (styleError) styleError();
+    }
+
     void onGlyphsLoaded(const FontStack& fontStack, const GlyphRange& glyphRange) override {
         if (glyphsLoaded) glyphsLoaded(fontStack, glyphRange);
     }
@@ -55,6 +63,8 @@ public:
         if (resourceError) resourceError(error);
     };
 
+    std::function<void ()> styleLoaded;
+    std::function<void ()> styleError;
     std::function<void (const FontStack&, const GlyphRange&)> glyphsLoaded;
     std::function<void (const FontStack&, const GlyphRange&, std::exception_ptr)> glyphsError;
     std::function<void ()> spriteLoaded;
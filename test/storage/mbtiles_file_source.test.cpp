@@ -0,0 +1,186 @@
+#include <mbgl/storage/mbtiles_file_source.hpp>
+#include <mbgl/util/run_loop.hpp>
+#include <mbgl/util/tileset.hpp>
+
+#include <rapidjson/document.h>
+
+#include <set>
+#include <unistd.h>
+#include <limits.h>
+#include <gtest/gtest.h>
+
+namespace {
+
+std::string toAbsoluteURL(const std::string& fileName) {
+    char buff[PATH_MAX + 1];
+    char* cwd = getcwd( buff, PATH_MAX + 1 );
+    return "mbtiles://" + std::string(cwd) + "/test/fixtures/storage/mbtiles/" + fileName;
+}
+
+} // namespace
+
+using namespace mbgl;
+
+TEST(MBTilesFileSource, AcceptsURL) {
+    EXPECT_TRUE(MBTilesFileSource::acceptsURL("mbtiles:///tmp/file.mbtiles"));
+    EXPECT_FALSE(MBTilesFileSource::acceptsURL("file:///tmp/file.mbtiles"));
+    EXPECT_FALSE(MBTilesFileSource::acceptsURL("mbtiles:"));
+}
+
+TEST(MBTilesFileSource, TileJSON) {
+    util::RunLoop loop;
+
+    MBTilesFileSource fs;
+
+    const std::string url = toAbsoluteURL("sample.mbtiles");
+    std::unique_ptr<AsyncRequest> req = fs.request({ Resource::Source, url }, [&](Response res) {
+        req.reset();
+        EXPECT_EQ(nullptr, res.error);
+        ASSERT_TRUE(res.data.get());
+
+        rapidjson::GenericDocument<rapidjson::UTF8<>, rapidjson::CrtAllocator> doc;
+        doc.Parse<0>(res.data->c_str());
+        ASSERT_FALSE(doc.HasParseError());
+
+        EXPECT_EQ(std::string("tms"), doc["scheme"].GetString());
+        ASSERT_EQ(1u, doc["tiles"].Size());
+        EXPECT_EQ(url + "?z={z}&x={x}&y={y}", doc["tiles"][0].GetString());
+        EXPECT_EQ(0, doc["minzoom"].GetInt());
+        EXPECT_EQ(1, doc["maxzoom"].GetInt());
+        ASSERT_EQ(4u, doc["bounds"].Size());
+        EXPECT_DOUBLE_EQ(-180, doc["bounds"][0].GetDouble());
+        ASSERT_EQ(3u, doc["center"].Size());
+        EXPECT_EQ(std::string("test attribution"), doc["attribution"].GetString());
+        EXPECT_EQ(std::string("sample"), doc["name"].GetString());
+        ASSERT_TRUE(doc["vector_layers"].IsArray());
+        EXPECT_EQ(std::string("water"), doc["vector_layers"][0]["id"].GetString());
+        loop.stop();
+    });
+
+    loop.run();
+}
+
+TEST(MBTilesFileSource, TileJSONDuplicateKeys) {
+    util::RunLoop loop;
+
+    MBTilesFileSource fs;
+
+    // The "json" metadata row and other rows repeat keys that are already set.
+    const std::string url = toAbsoluteURL("duplicate_keys.mbtiles");
+    std::unique_ptr<AsyncRequest> req = fs.request({ Resource::Source, url }, [&](Response res) {
+        req.reset();
+        EXPECT_EQ(nullptr, res.error);
+        ASSERT_TRUE(res.data.get());
+
+        rapidjson::GenericDocument<rapidjson::UTF8<>, rapidjson::CrtAllocator> doc;
+        doc.Parse<0>(res.data->c_str());
+        ASSERT_FALSE(doc.HasParseError());
+
+        std::set<std::string> keys;
+        for (auto it = doc.MemberBegin(); it != doc.MemberEnd(); ++it) {
+            EXPECT_TRUE(keys.insert(it->name.GetString()).second) << it->name.GetString();
+        }
+
+        EXPECT_EQ(std::string("2.0.0"), doc["tilejson"].GetString());
+        EXPECT_EQ(std::string("tms"), doc["scheme"].GetString());
+        ASSERT_EQ(1u, doc["tiles"].Size());
+        EXPECT_EQ(url + "?z={z}&x={x}&y={y}", doc["tiles"][0].GetString());
+        EXPECT_EQ(0, doc["minzoom"].GetInt());
+        EXPECT_EQ(std::string("duplicate keys"), doc["name"].GetString());
+        ASSERT_TRUE(doc["vector_layers"].IsArray());
+        EXPECT_EQ(std::string("water"), doc["vector_layers"][0]["id"].GetString());
+        loop.stop();
+    });
+
+    loop.run();
+}
+
+TEST(MBTilesFileSource, GzippedTile) {
+    util::RunLoop loop;
+
+    MBTilesFileSource fs;
+
+    const std::string tiles = toAbsoluteURL("sample.mbtiles") + "?z={z}&x={x}&y={y}";
+    std::unique_ptr<AsyncRequest> req = fs.request(Resource::tile(tiles, 1.0, 0, 0, 0, Tileset::Scheme::TMS), [&](Response res) {
+        req.reset();
+        EXPECT_EQ(nullptr, res.error);
+        ASSERT_TRUE(res.data.get());
+        EXPECT_EQ("gzipped tile 0/0/0", *res.data);
+        loop.stop();
+    });
+
+    loop.run();
+}
+
+TEST(MBTilesFileSource, TMSTile) {
+    util::RunLoop loop;
+
+    MBTilesFileSource fs;
+
+    const std::string tiles = toAbsoluteURL("sample.mbtiles") + "?z={z}&x={x}&y={y}";
+    std::unique_ptr<AsyncRequest> req = fs.request(Resource::tile(tiles, 1.0, 0, 1, 1, Tileset::Scheme::TMS), [&](Response res) {
+        req.reset();
+        EXPECT_EQ(nullptr, res.error);
+        ASSERT_TRUE(res.data.get());
+        EXPECT_EQ("plain tile 1/0/1", *res.data);
+        loop.stop();
+    });
+
+    loop.run();
+}
+
+TEST(MBTilesFileSource, MissingTile) {
+    util::RunLoop loop;
+
+    MBTilesFileSource fs;
+
+    const std::string tiles = toAbsoluteURL("sample.mbtiles") + "?z={z}&x={x}&y={y}";
+    std::unique_ptr<AsyncRequest> req = fs.request(Resource::tile(tiles, 1.0, 1, 1, 1, Tileset::Scheme::TMS), [&](Response res) {
+        req.reset();
+        EXPECT_EQ(nullptr, res.error);
+        EXPECT_TRUE(res.noContent);
+        EXPECT_FALSE(res.data.get());
+        loop.stop();
+    });
+
+    loop.run();
+}
+
+TEST(MBTilesFileSource, NonExistentFile) {
+    util::RunLoop loop;
+
+    MBTilesFileSource fs;
+
+    std::unique_ptr<AsyncRequest> req = fs.request({ Resource::Source, toAbsoluteURL("does_not_exist.mbtiles") }, [&](Response res) {
+        req.reset();
+        ASSERT_NE(nullptr, res.error);
+        EXPECT_EQ(Response::Error::Reason::NotFound, res.error->reason);
+        EXPECT_FALSE(res.data.get());
+        loop.stop();
+    });
+
+    loop.run();
+}
+
+TEST(MBTilesFileSource, ConcurrentRequests) {
+    util::RunLoop loop;
+
+    MBTilesFileSource fs;
+
+    const std::string tiles = toAbsoluteURL("sample.mbtiles") + "?z={z}&x={x}&y={y}";
+    std::vector<std::unique_ptr<AsyncRequest>> requests;
+    std::size_t remaining = 16;
+
+    for (std::size_t i = 0; i < remaining; i++) {
+        requests.push_back(fs.request(Resource::tile(tiles, 1.0, 0, 0, 0, Tileset::Scheme::TMS), [&](Response res) {
+            EXPECT_EQ(nullptr, res.error);
+            ASSERT_TRUE(res.data.get());
+            EXPECT_EQ("gzipped tile 0/0/0", *res.data);
+            if (--remaining == 0) {
+                loop.stop();
+            }
+        }));
+    }
+
+    loop.run();
+}
@@ -52,3 +52,25 @@ TEST(OfflineTilePyramidRegionDefinition, TileCoverWrapped) {
     EXPECT_EQ((std::vector<CanonicalTileID>{ { 0, 0, 0 } }),
               region.tileCover(SourceType::Vector, 512, { 0, 22 }));
 }
+
+TEST(OfflineTilePyramidRegionDefinition, TileCount) {
+    OfflineTilePyramidRegionDefinition region("", sanFrancisco, 0, 22, 1.0);
+
+    // These numbers gauge the download size of offline regions, so they must match the
+    // tile cover exactly.
+    EXPECT_EQ(region.tileCover(SourceType::Vector, 512, { 0, 16 }).size(),
+              region.tileCount(SourceType::Vector, 512, { 0, 16 }));
+    EXPECT_EQ(region.tileCover(SourceType::Raster, 256, { 4, 12 }).size(),
+              region.tileCount(SourceType::Raster, 256, { 4, 12 }));
+    EXPECT_EQ(0u, region.tileCount(SourceType::Vector, 512, { 23, 24 }));
+
+    // Counting doesn't need to enumerate the tiles; at z22 alone there are millions.
+    EXPECT_LT(1000000u, region.tileCount(SourceType::Vector, 512, { 0, 22 }));
+}
+
+TEST(OfflineTilePyramidRegionDefinition, TileCoverInfiniteMaxZoom) {
+    OfflineTilePyramidRegionDefinition region("", sanFrancisco, 0, INFINITY, 1.0);
+
+    EXPECT_EQ(3u, region.tileCount(SourceType::Vector, 512, { 0, 2 }));
+    EXPECT_EQ(3u, region.tileCover(SourceType::Vector, 512, { 0, 2 }).size());
+}
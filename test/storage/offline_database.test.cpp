@@ -2,15 +2,18 @@
 #include <mbgl/test/fixture_log_observer.hpp>
 
 #include <mbgl/storage/offline_database.hpp>
+#include <mbgl/storage/offline_codec.hpp>
 #include <mbgl/storage/resource.hpp>
 #include <mbgl/storage/response.hpp>
 #include <mbgl/util/io.hpp>
+#include <mbgl/util/compression.hpp>
 #include <mbgl/util/string.hpp>
 
 #include <gtest/gtest.h>
 #include <sqlite3.hpp>
 #include <sqlite3.h>
 #include <thread>
+#include <unistd.h>
 #include <random>
 
 using namespace std::literals::string_literals;
@@ -219,6 +222,48 @@ TEST(OfflineDatabase, PutTile) {
     EXPECT_EQ("second", *updateGetResult->data);
 }
 
+TEST(OfflineDatabase, TEST_REQUIRES_WRITE(PutVectorTile)) {
+    using namespace mbgl;
+
+    createDir("test/fixtures/offline_database");
+    deleteFile("test/fixtures/offline_database/offline.db");
+
+    OfflineDatabase db("test/fixtures/offline_database/offline.db");
+
+    Resource resource { Resource::Tile, "http://example.com/" };
+    resource.tileData = Resource::TileData {
+        "http://example.com/",
+        1,
+        0,
+        0,
+        0
+    };
+    Response response;
+    response.data = std::make_shared<std::string>(util::read_file("test/fixtures/offline_download/0-0-0.vector.pbf"));
+
+    auto putResult = db.put(resource, response);
+    EXPECT_TRUE(putResult.first);
+    EXPECT_LE(putResult.second, util::compress(*response.data).size());
+
+    // Vector tiles are stored with the preset dictionary codec, and decode to the original tile.
+    {
+        mapbox::sqlite::Database sqlite("test/fixtures/offline_database/offline.db", mapbox::sqlite::ReadOnly);
+        mapbox::sqlite::Statement stmt = sqlite.prepare("SELECT compressed, data FROM tiles");
+        ASSERT_TRUE(stmt.run());
+
+        const auto codec = OfflineCodec(stmt.get<int>(0));
+        const auto data = stmt.get<std::string>(1);
+        EXPECT_EQ(OfflineCodec::ZlibVectorTileDictionary, codec);
+        EXPECT_EQ(putResult.second, data.size());
+        EXPECT_EQ(*response.data, decodeOfflineData(codec, data));
+        EXPECT_FALSE(stmt.run());
+    }
+
+    auto getResult = db.get(resource);
+    ASSERT_TRUE(getResult && getResult->data);
+    EXPECT_EQ(*response.data, *getResult->data);
+}
+
 TEST(OfflineDatabase, PutResourceNoContent) {
     using namespace mbgl;
 
@@ -386,6 +431,159 @@ TEST(OfflineDatabase, TEST_REQUIRES_WRITE(ConcurrentUse)) {
     thread2.join();
 }
 
+TEST(OfflineDatabase, TEST_REQUIRES_WRITE(ReadOnlyConnection)) {
+    using namespace mbgl;
+
+    createDir("test/fixtures/offline_database");
+    deleteFile("test/fixtures/offline_database/offline.db");
+
+    OfflineDatabase writer("test/fixtures/offline_database/offline.db");
+    auto reader = OfflineDatabase::openReadOnly("test/fixtures/offline_database/offline.db");
+
+    Resource resource { Resource::Style, "http://example.com/" };
+    EXPECT_FALSE(bool(reader->get(resource)));
+
+    Response response;
+    response.data = std::make_shared<std::string>("data");
+    writer.put(resource, response);
+
+    {
+        // Readers are not blocked by an open write transaction.
+        FileLock lock("test/fixtures/offline_database/offline.db");
+        auto res = reader->get(resource);
+        ASSERT_TRUE(res && res->data);
+        EXPECT_EQ("data", *res->data);
+    }
+
+    // Reads don't record access times; touching the resource on the writer does.
+    sqlite3* db = nullptr;
+    ASSERT_EQ(SQLITE_OK, sqlite3_open_v2("test/fixtures/offline_database/offline.db", &db, SQLITE_OPEN_READWRITE, nullptr));
+    ASSERT_EQ(SQLITE_OK, sqlite3_exec(db, "UPDATE resources SET accessed = 0", nullptr, nullptr, nullptr));
+
+    auto accessed = [&] {
+        sqlite3_stmt* stmt = nullptr;
+        sqlite3_prepare_v2(db, "SELECT accessed FROM resources WHERE url = 'http://example.com/'", -1, &stmt, nullptr);
+        EXPECT_EQ(SQLITE_ROW, sqlite3_step(stmt));
+        const int64_t result = sqlite3_column_int64(stmt, 0);
+        sqlite3_finalize(stmt);
+        return result;
+    };
+
+    ASSERT_TRUE(bool(reader->get(resource)));
+    EXPECT_EQ(0, accessed());
+
+    writer.touch(resource);
+    EXPECT_LT(0, accessed());
+
+    auto res = reader->get(resource);
+    ASSERT_TRUE(res && res->data);
+    EXPECT_EQ("data", *res->data);
+
+    sqlite3_close(db);
+}
+
+TEST(OfflineDatabase, TEST_REQUIRES_WRITE(ExportImportRegion)) {
+    using namespace mbgl;
+
+    createDir("test/fixtures/offline_database");
+    deleteFile("test/fixtures/offline_database/export.db");
+
+    Response response;
+    response.data = std::make_shared<std::string>("data");
+
+    OfflineDatabase source(":memory:");
+    OfflineRegionDefinition definition { "http://example.com/style", LatLngBounds::hull({1, 2}, {3, 4}), 5, 6, 2.0 };
+    OfflineRegion region = source.createRegion(definition, {{ 1, 2, 3 }});
+    OfflineRegion other = source.createRegion(definition, {});
+    source.putRegionResource(region.getID(), Resource::style("http://example.com/style"), response);
+    source.putRegionResource(region.getID(), Resource::tile("http://example.com/", 1.0, 0, 0, 0, Tileset::Scheme::XYZ), response);
+    source.putRegionResource(region.getID(), Resource::tile("http://example.com/", 1.0, 0, 0, 1, Tileset::Scheme::XYZ), response);
+    source.putRegionResource(other.getID(), Resource::tile("http://example.com/", 1.0, 1, 0, 1, Tileset::Scheme::XYZ), response);
+
+    source.exportRegion(region.getID(), "test/fixtures/offline_database/export.db");
+    EXPECT_THROW(source.exportRegion(-1, "test/fixtures/offline_database/export.db"), std::runtime_error);
+    source.exportRegion(region.getID(), "test/fixtures/offline_database/export.db");
+
+    // The destination already stores one of the tiles, with different data.
+    OfflineDatabase destination(":memory:");
+    Response existing;
+    existing.data = std::make_shared<std::string>("existing");
+    const Resource tile = Resource::tile("http://example.com/", 1.0, 0, 0, 0, Tileset::Scheme::XYZ);
+    destination.put(tile, existing);
+
+    std::vector<OfflineRegion> imported = destination.importRegions("test/fixtures/offline_database/export.db");
+    ASSERT_EQ(1u, imported.size());
+    EXPECT_EQ(definition.styleURL, imported[0].getDefinition().styleURL);
+    EXPECT_EQ((OfflineRegionMetadata {{ 1, 2, 3 }}), imported[0].getMetadata());
+
+    OfflineRegionStatus status = destination.getRegionCompletedStatus(imported[0].getID());
+    EXPECT_EQ(3u, status.completedResourceCount);
+    EXPECT_EQ(2u, status.completedTileCount);
+    EXPECT_EQ("existing", *destination.get(tile)->data);
+    EXPECT_FALSE(bool(destination.get(Resource::tile("http://example.com/", 1.0, 1, 0, 1, Tileset::Scheme::XYZ))));
+
+    // Importing again adds another region sharing the same rows.
+    std::vector<OfflineRegion> again = destination.importRegions("test/fixtures/offline_database/export.db");
+    ASSERT_EQ(1u, again.size());
+    EXPECT_NE(imported[0].getID(), again[0].getID());
+    EXPECT_EQ(2u, destination.listRegions().size());
+    EXPECT_EQ(3u, destination.getRegionCompletedStatus(again[0].getID()).completedResourceCount);
+
+    // Archives are not modified by importing them.
+    const std::string archive = util::read_file("test/fixtures/offline_database/export.db");
+    destination.importRegions("test/fixtures/offline_database/export.db");
+    EXPECT_EQ(archive, util::read_file("test/fixtures/offline_database/export.db"));
+}
+
+TEST(OfflineDatabase, TEST_REQUIRES_WRITE(ImportInvalidArchive)) {
+    using namespace mbgl;
+
+    createDir("test/fixtures/offline_database");
+    deleteFile("test/fixtures/offline_database/does_not_exist.db");
+    deleteFile("test/fixtures/offline_database/invalid.db");
+
+    OfflineDatabase db(":memory:");
+
+    // A missing archive is an error, and isn't created.
+    EXPECT_THROW(db.importRegions("test/fixtures/offline_database/does_not_exist.db"), std::runtime_error);
+    EXPECT_NE(0, access("test/fixtures/offline_database/does_not_exist.db", F_OK));
+
+    writeFile("test/fixtures/offline_database/invalid.db", "this is not a database");
+    EXPECT_THROW(db.importRegions("test/fixtures/offline_database/invalid.db"), std::runtime_error);
+
+    EXPECT_EQ(0u, db.listRegions().size());
+}
+
+TEST(OfflineDatabase, TEST_REQUIRES_WRITE(ImportRespectsMapboxTileCountLimit)) {
+    using namespace mbgl;
+
+    createDir("test/fixtures/offline_database");
+    deleteFile("test/fixtures/offline_database/export.db");
+
+    Response response;
+    response.data = std::make_shared<std::string>("data");
+
+    OfflineDatabase source(":memory:");
+    OfflineRegionDefinition definition { "mapbox://style", LatLngBounds::hull({1, 2}, {3, 4}), 5, 6, 2.0 };
+    OfflineRegion region = source.createRegion(definition, {});
+    source.putRegionResource(region.getID(), Resource::tile("mapbox://tiles/1", 1.0, 0, 0, 0, Tileset::Scheme::XYZ), response);
+    source.putRegionResource(region.getID(), Resource::tile("mapbox://tiles/1", 1.0, 0, 0, 1, Tileset::Scheme::XYZ), response);
+    source.exportRegion(region.getID(), "test/fixtures/offline_database/export.db");
+
+    OfflineDatabase destination(":memory:");
+    destination.setOfflineMapboxTileCountLimit(1);
+
+    // The import is rolled back entirely.
+    EXPECT_THROW(destination.importRegions("test/fixtures/offline_database/export.db"), std::runtime_error);
+    EXPECT_EQ(0u, destination.listRegions().size());
+    EXPECT_EQ(0u, destination.getOfflineMapboxTileCount());
+    EXPECT_FALSE(bool(destination.get(Resource::tile("mapbox://tiles/1", 1.0, 0, 0, 0, Tileset::Scheme::XYZ))));
+
+    destination.setOfflineMapboxTileCountLimit(2);
+    EXPECT_EQ(1u, destination.importRegions("test/fixtures/offline_database/export.db").size());
+    EXPECT_EQ(2u, destination.getOfflineMapboxTileCount());
+}
+
 static std::shared_ptr<std::string> randomString(size_t size) {
     auto result = std::make_shared<std::string>(size, 0);
     std::mt19937 random;
@@ -627,31 +825,24 @@ static std::string databaseJournalMode(const std::string& path) {
     return stmt.get<std::string>(0);
 }
 
-static int databaseSyncMode(const std::string& path) {
-    mapbox::sqlite::Database db(path, mapbox::sqlite::ReadOnly);
-    mapbox::sqlite::Statement stmt = db.prepare("pragma synchronous");
-    stmt.run();
-    return stmt.get<int>(0);
-}
-
 TEST(OfflineDatabase, MigrateFromV2Schema) {
     using namespace mbgl;
 
     // v2.db is a v2 database containing a single offline region with a small number of resources.
 
-    deleteFile("test/fixtures/offline_database/v5.db");
-    writeFile("test/fixtures/offline_database/v5.db", util::read_file("test/fixtures/offline_database/v2.db"));
+    deleteFile("test/fixtures/offline_database/v6.db");
+    writeFile("test/fixtures/offline_database/v6.db", util::read_file("test/fixtures/offline_database/v2.db"));
 
     {
-        OfflineDatabase db("test/fixtures/offline_database/v5.db", 0);
+        OfflineDatabase db("test/fixtures/offline_database/v6.db", 0);
         auto regions = db.listRegions();
         for (auto& region : regions) {
             db.deleteRegion(std::move(region));
         }
     }
 
-    EXPECT_EQ(5, databaseUserVersion("test/fixtures/offline_database/v5.db"));
-    EXPECT_LT(databasePageCount("test/fixtures/offline_database/v5.db"),
+    EXPECT_EQ(6, databaseUserVersion("test/fixtures/offline_database/v6.db"));
+    EXPECT_LT(databasePageCount("test/fixtures/offline_database/v6.db"),
               databasePageCount("test/fixtures/offline_database/v2.db"));
 }
 
@@ -660,41 +851,38 @@ TEST(OfflineDatabase, MigrateFromV3Schema) {
 
     // v3.db is a v3 database, migrated from v2.
 
-    deleteFile("test/fixtures/offline_database/v5.db");
-    writeFile("test/fixtures/offline_database/v5.db", util::read_file("test/fixtures/offline_database/v3.db"));
+    deleteFile("test/fixtures/offline_database/v6.db");
+    writeFile("test/fixtures/offline_database/v6.db", util::read_file("test/fixtures/offline_database/v3.db"));
 
     {
-        OfflineDatabase db("test/fixtures/offline_database/v5.db", 0);
+        OfflineDatabase db("test/fixtures/offline_database/v6.db", 0);
         auto regions = db.listRegions();
         for (auto& region : regions) {
             db.deleteRegion(std::move(region));
         }
     }
 
-    EXPECT_EQ(5, databaseUserVersion("test/fixtures/offline_database/v5.db"));
+    EXPECT_EQ(6, databaseUserVersion("test/fixtures/offline_database/v6.db"));
 }
 
 TEST(OfflineDatabase, MigrateFromV4Schema) {
     using namespace mbgl;
 
-    // v4.db is a v4 database, migrated from v2 & v3. This database used `journal_mode = WAL` and `synchronous = NORMAL`.
+    // v4.db is a v4 database, migrated from v2 & v3. This database used `journal_mode = WAL`, which v5 reverted and v6 restores.
 
-    deleteFile("test/fixtures/offline_database/v5.db");
-    writeFile("test/fixtures/offline_database/v5.db", util::read_file("test/fixtures/offline_database/v4.db"));
+    deleteFile("test/fixtures/offline_database/v6.db");
+    writeFile("test/fixtures/offline_database/v6.db", util::read_file("test/fixtures/offline_database/v4.db"));
 
     {
-        OfflineDatabase db("test/fixtures/offline_database/v5.db", 0);
+        OfflineDatabase db("test/fixtures/offline_database/v6.db", 0);
         auto regions = db.listRegions();
         for (auto& region : regions) {
             db.deleteRegion(std::move(region));
         }
     }
 
-    EXPECT_EQ(5, databaseUserVersion("test/fixtures/offline_database/v5.db"));
-
-    // Journal mode should be DELETE after migration to v5.
-    EXPECT_EQ("delete", databaseJournalMode("test/fixtures/offline_database/v5.db"));
+    EXPECT_EQ(6, databaseUserVersion("test/fixtures/offline_database/v6.db"));
 
-    // Synchronous setting should be FULL (2) after migration to v5.
-    EXPECT_EQ(2, databaseSyncMode("test/fixtures/offline_database/v5.db"));
+    // Journal mode should be WAL after migration to v6 and later.
+    EXPECT_EQ("wal", databaseJournalMode("test/fixtures/offline_database/v6.db"));
 }
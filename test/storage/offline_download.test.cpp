@@ -3,11 +3,11 @@
 
 #include <mbgl/storage/offline.hpp>
 #include <mbgl/storage/offline_database.hpp>
+#include <mbgl/storage/offline_codec.hpp>
 #include <mbgl/storage/offline_download.hpp>
 #include <mbgl/storage/http_file_source.hpp>
 #include <mbgl/util/run_loop.hpp>
 #include <mbgl/util/io.hpp>
-#include <mbgl/util/compression.hpp>
 #include <mbgl/util/string.hpp>
 
 #include <gtest/gtest.h>
@@ -51,9 +51,8 @@ public:
     Response response(const std::string& path) {
         Response result;
         result.data = std::make_shared<std::string>(util::read_file("test/fixtures/offline_download/"s + path));
-        size_t uncompressed = result.data->size();
-        size_t compressed = util::compress(*result.data).size();
-        size += std::min(uncompressed, compressed);
+        auto encoded = encodeOfflineData(*result.data);
+        size += encoded.first == OfflineCodec::None ? result.data->size() : encoded.second.size();
         return result;
     }
 };
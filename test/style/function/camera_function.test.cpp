@@ -77,3 +77,21 @@ TEST(CameraFunction, Stops) {
     EXPECT_TRUE(evaluate(discreteBool, 3));
     EXPECT_TRUE(evaluate(discreteBool, 4));
 }
+
+TEST(CameraFunction, CompiledStops) {
+    // Compiled stops must give bit-identical results to the stops they were compiled from.
+    auto expectIdentical = [] (const auto& stops) {
+        using T = std::decay_t<decltype(*stops.evaluate(Value(0.0)))>;
+        CompiledStops<T> compiled(stops);
+        for (float zoom = -1; zoom <= 24; zoom += 0.01f) {
+            EXPECT_EQ(*stops.evaluate(Value(double(zoom))), compiled.evaluate(zoom)) << "at zoom " << zoom;
+        }
+    };
+
+    expectIdentical(ExponentialStops<float> { { { 5, 0.5 }, { 10, 1 }, { 13, 2 }, { 16, 8 }, { 18, 24 }, { 20, 64 } }, 1.5 });
+    expectIdentical(ExponentialStops<float> { { { 0, 2 }, { 8, 10 } }, 1 });
+    expectIdentical(ExponentialStops<float> { { { 7, 3 } }, 1.2 });
+    expectIdentical(ExponentialStops<Color> { { { 10, Color::red() }, { 14, Color::blue() } }, 1.4 });
+    expectIdentical(IntervalStops<float> { { { 10, 0 }, { 12, 0.5 }, { 14, 1 } } });
+    expectIdentical(IntervalStops<std::string> { { { 3, "string0" }, { 6, "string1" }, { 9, "string2" } } });
+}
@@ -0,0 +1,104 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/style/sources/geojson_reader.hpp>
+#include <mbgl/util/feature.hpp>
+
+using namespace mbgl;
+using namespace mbgl::style;
+
+using Geometry = mapbox::geometry::geometry<double>;
+
+TEST(GeoJSONReader, Geometry) {
+    auto result = readGeoJSON(R"({"coordinates": [[[0, 0], [1, 0], [1, 1], [0, 0]], [[0.2, 0.2], [0.4, 0.2], [0.2, 0.4], [0.2, 0.2]]], "type": "Polygon"})");
+    ASSERT_TRUE(bool(result));
+    const GeoJSON& geoJSON = *result;
+    ASSERT_TRUE(geoJSON.is<Geometry>());
+
+    const auto& polygon = geoJSON.get<Geometry>().get<mapbox::geometry::polygon<double>>();
+    ASSERT_EQ(2u, polygon.size());
+    EXPECT_EQ(4u, polygon[0].size());
+    EXPECT_EQ(4u, polygon[1].size());
+    EXPECT_EQ(mapbox::geometry::point<double>(0.4, 0.2), polygon[1][1]);
+}
+
+TEST(GeoJSONReader, MultiPolygon) {
+    auto result = readGeoJSON(R"({"type": "MultiPolygon", "coordinates": [[[[0, 0], [1, 0], [0, 0]]], [[[2, 2], [3, 2], [2, 2]], [[4, 4], [5, 4, 100], [4, 4]]]]})");
+    ASSERT_TRUE(bool(result));
+    const GeoJSON& geoJSON = *result;
+
+    const auto& polygons = geoJSON.get<Geometry>().get<mapbox::geometry::multi_polygon<double>>();
+    ASSERT_EQ(2u, polygons.size());
+    EXPECT_EQ(1u, polygons[0].size());
+    ASSERT_EQ(2u, polygons[1].size());
+    EXPECT_EQ(mapbox::geometry::point<double>(5, 4), polygons[1][1][1]);
+}
+
+TEST(GeoJSONReader, FeatureCollection) {
+    auto result = readGeoJSON(R"({
+        "type": "FeatureCollection",
+        "bbox": [0, 0, 1, 1],
+        "features": [{
+            "properties": { "name": "a", "count": 2, "offset": -1, "ratio": 0.5, "flag": true, "none": null,
+                            "list": [1, "b"], "nested": { "type": "Point" } },
+            "geometry": { "type": "LineString", "coordinates": [[0, 0], [1, 1]] },
+            "id": 7,
+            "type": "Feature"
+        }, {
+            "type": "Feature",
+            "id": "second",
+            "geometry": null,
+            "properties": null
+        }, {
+            "type": "Feature",
+            "geometry": { "type": "GeometryCollection", "geometries": [
+                { "type": "Point", "coordinates": [1, 2] },
+                { "type": "MultiPoint", "coordinates": [[1, 2], [3, 4]] }
+            ] }
+        }]
+    })");
+    ASSERT_TRUE(bool(result));
+    const GeoJSON& geoJSON = *result;
+    ASSERT_TRUE(geoJSON.is<FeatureCollection>());
+
+    const auto& features = geoJSON.get<FeatureCollection>();
+    ASSERT_EQ(3u, features.size());
+
+    const Feature& first = features[0];
+    EXPECT_EQ(FeatureIdentifier(uint64_t(7)), *first.id);
+    EXPECT_EQ(2u, first.geometry.get<mapbox::geometry::line_string<double>>().size());
+    EXPECT_EQ(Value(std::string("a")), first.properties.at("name"));
+    EXPECT_EQ(Value(uint64_t(2)), first.properties.at("count"));
+    EXPECT_EQ(Value(int64_t(-1)), first.properties.at("offset"));
+    EXPECT_EQ(Value(0.5), first.properties.at("ratio"));
+    EXPECT_EQ(Value(true), first.properties.at("flag"));
+    EXPECT_EQ(Value(NullValue()), first.properties.at("none"));
+    EXPECT_EQ(Value(std::vector<Value>{ uint64_t(1), std::string("b") }), first.properties.at("list"));
+    EXPECT_EQ(Value(PropertyMap{ { "type", std::string("Point") } }), first.properties.at("nested"));
+
+    const Feature& second = features[1];
+    EXPECT_EQ(FeatureIdentifier(std::string("second")), *second.id);
+    EXPECT_TRUE(second.properties.empty());
+
+    const auto& collection = features[2].geometry.get<mapbox::geometry::geometry_collection<double>>();
+    ASSERT_EQ(2u, collection.size());
+    EXPECT_TRUE(collection[0].is<mapbox::geometry::point<double>>());
+    EXPECT_EQ(2u, collection[1].get<mapbox::geometry::multi_point<double>>().size());
+}
+
+TEST(GeoJSONReader, InvalidGeoJSON) {
+    EXPECT_FALSE(bool(readGeoJSON(R"([])")));
+    EXPECT_FALSE(bool(readGeoJSON(R"({"coordinates": [0, 0]})")));
+    EXPECT_FALSE(bool(readGeoJSON(R"({"type": "Circle", "coordinates": [0, 0]})")));
+    EXPECT_FALSE(bool(readGeoJSON(R"({"type": "Point"})")));
+    EXPECT_FALSE(bool(readGeoJSON(R"({"type": "Point", "coordinates": [[0, 0]]})")));
+    EXPECT_FALSE(bool(readGeoJSON(R"({"type": "LineString", "coordinates": [[0, 0], []]})")));
+    EXPECT_FALSE(bool(readGeoJSON(R"({"type": "Polygon", "coordinates": [[[0, 0], [[1, 1]]]]})")));
+    EXPECT_FALSE(bool(readGeoJSON(R"({"type": "Polygon", "coordinates": [[[[]]]]})")));
+    EXPECT_FALSE(bool(readGeoJSON(R"({"type": "MultiPolygon", "coordinates": [[[[]]]]})")));
+    EXPECT_FALSE(bool(readGeoJSON(R"({"type": "MultiPolygon", "coordinates": [[[[0, 0], [1, 0], [0, 0]], [[]]]]})")));
+    EXPECT_FALSE(bool(readGeoJSON(R"({"type": "FeatureCollection", "features": [{"type": "Point", "coordinates": [0, 0]}]})")));
+}
+
+TEST(GeoJSONReader, InvalidJSON) {
+    EXPECT_THROW(readGeoJSON(R"({"type": "Point", "coordinates": [0, 0])"), std::runtime_error);
+}
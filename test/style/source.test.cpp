@@ -3,6 +3,7 @@
 #include <mbgl/test/stub_style_observer.hpp>
 
 #include <mbgl/style/source_impl.hpp>
+#include <mbgl/style/source_query.hpp>
 #include <mbgl/style/sources/raster_source.hpp>
 #include <mbgl/style/sources/vector_source.hpp>
 #include <mbgl/style/sources/geojson_source.hpp>
@@ -22,6 +23,9 @@
 
 #include <mapbox/geojsonvt.hpp>
 
+#include <algorithm>
+#include <set>
+
 using namespace mbgl;
 
 class SourceTest {
@@ -33,7 +37,7 @@ public:
     TransformState transformState;
     ThreadPool threadPool { 1 };
     AnnotationManager annotationManager { 1.0 };
-    style::Style style { fileSource, 1.0 };
+    style::Style style { threadPool, fileSource, 1.0 };
 
     style::UpdateParameters updateParameters {
         1.0,
@@ -85,7 +89,7 @@ TEST(Source, LoadingFail) {
 
     VectorSource source("source", "url");
     source.baseImpl->setObserver(&test.observer);
-    source.baseImpl->loadDescription(test.fileSource);
+    source.baseImpl->loadDescription(test.fileSource, test.threadPool);
 
     test.run();
 }
@@ -108,7 +112,7 @@ TEST(Source, LoadingCorrupt) {
 
     VectorSource source("source", "url");
     source.baseImpl->setObserver(&test.observer);
-    source.baseImpl->loadDescription(test.fileSource);
+    source.baseImpl->loadDescription(test.fileSource, test.threadPool);
 
     test.run();
 }
@@ -136,7 +140,7 @@ TEST(Source, RasterTileEmpty) {
 
     RasterSource source("source", tileset, 512);
     source.baseImpl->setObserver(&test.observer);
-    source.baseImpl->loadDescription(test.fileSource);
+    source.baseImpl->loadDescription(test.fileSource, test.threadPool);
     source.baseImpl->updateTiles(test.updateParameters);
 
     test.run();
@@ -165,7 +169,7 @@ TEST(Source, VectorTileEmpty) {
 
     VectorSource source("source", tileset);
     source.baseImpl->setObserver(&test.observer);
-    source.baseImpl->loadDescription(test.fileSource);
+    source.baseImpl->loadDescription(test.fileSource, test.threadPool);
     source.baseImpl->updateTiles(test.updateParameters);
 
     test.run();
@@ -194,7 +198,7 @@ TEST(Source, RasterTileFail) {
 
     RasterSource source("source", tileset, 512);
     source.baseImpl->setObserver(&test.observer);
-    source.baseImpl->loadDescription(test.fileSource);
+    source.baseImpl->loadDescription(test.fileSource, test.threadPool);
     source.baseImpl->updateTiles(test.updateParameters);
 
     test.run();
@@ -223,7 +227,7 @@ TEST(Source, VectorTileFail) {
 
     VectorSource source("source", tileset);
     source.baseImpl->setObserver(&test.observer);
-    source.baseImpl->loadDescription(test.fileSource);
+    source.baseImpl->loadDescription(test.fileSource, test.threadPool);
     source.baseImpl->updateTiles(test.updateParameters);
 
     test.run();
@@ -251,7 +255,7 @@ TEST(Source, RasterTileCorrupt) {
 
     RasterSource source("source", tileset, 512);
     source.baseImpl->setObserver(&test.observer);
-    source.baseImpl->loadDescription(test.fileSource);
+    source.baseImpl->loadDescription(test.fileSource, test.threadPool);
     source.baseImpl->updateTiles(test.updateParameters);
 
     test.run();
@@ -283,7 +287,7 @@ TEST(Source, VectorTileCorrupt) {
 
     VectorSource source("source", tileset);
     source.baseImpl->setObserver(&test.observer);
-    source.baseImpl->loadDescription(test.fileSource);
+    source.baseImpl->loadDescription(test.fileSource, test.threadPool);
     source.baseImpl->updateTiles(test.updateParameters);
 
     test.run();
@@ -310,7 +314,7 @@ TEST(Source, RasterTileCancel) {
 
     RasterSource source("source", tileset, 512);
     source.baseImpl->setObserver(&test.observer);
-    source.baseImpl->loadDescription(test.fileSource);
+    source.baseImpl->loadDescription(test.fileSource, test.threadPool);
     source.baseImpl->updateTiles(test.updateParameters);
 
     test.run();
@@ -337,7 +341,7 @@ TEST(Source, VectorTileCancel) {
 
     VectorSource source("source", tileset);
     source.baseImpl->setObserver(&test.observer);
-    source.baseImpl->loadDescription(test.fileSource);
+    source.baseImpl->loadDescription(test.fileSource, test.threadPool);
     source.baseImpl->updateTiles(test.updateParameters);
 
     test.run();
@@ -376,7 +380,7 @@ TEST(Source, RasterTileAttribution) {
 
     RasterSource source("source", "url", 512);
     source.baseImpl->setObserver(&test.observer);
-    source.baseImpl->loadDescription(test.fileSource);
+    source.baseImpl->loadDescription(test.fileSource, test.threadPool);
     source.baseImpl->updateTiles(test.updateParameters);
 
     test.run();
@@ -405,7 +409,7 @@ TEST(Source, GeoJSonSourceUrlUpdate) {
     source.baseImpl->setObserver(&test.observer);
 
     // Load initial, so the source state will be loaded=true
-    source.baseImpl->loadDescription(test.fileSource);
+    source.baseImpl->loadDescription(test.fileSource, test.threadPool);
 
     // Schedule an update
     test.loop.invoke([&] () {
@@ -415,3 +419,212 @@ TEST(Source, GeoJSonSourceUrlUpdate) {
 
     test.run();
 }
+
+TEST(Source, GeoJSONSourceIndexedOnWorker) {
+    SourceTest test;
+
+    GeoJSONSource source("source");
+    source.baseImpl->setObserver(&test.observer);
+
+    test.observer.sourceLoaded = [&] (Source&) {
+        EXPECT_TRUE(source.baseImpl->isLoaded());
+        test.end();
+    };
+
+    source.setGeoJSON(mapbox::geojson::geometry{ mapbox::geometry::point<double>{ 0, 0 } });
+    source.baseImpl->loadDescription(test.fileSource, test.threadPool);
+
+    // Indexing happens on the worker; the source isn't loaded until it replies.
+    EXPECT_FALSE(source.baseImpl->isLoaded());
+
+    test.run();
+}
+
+TEST(Source, GeoJSONSourceLoadDescriptionWhileIndexing) {
+    SourceTest test;
+
+    GeoJSONSource source("source");
+    source.baseImpl->setObserver(&test.observer);
+
+    test.observer.sourceLoaded = [&] (Source&) {
+        EXPECT_TRUE(source.baseImpl->isLoaded());
+        test.end();
+    };
+
+    source.setGeoJSON(mapbox::geojson::geometry{ mapbox::geometry::point<double>{ 0, 0 } });
+    source.baseImpl->loadDescription(test.fileSource, test.threadPool);
+
+    // Loading again before the worker replies must not mark the source loaded without data.
+    source.baseImpl->loadDescription(test.fileSource, test.threadPool);
+    EXPECT_FALSE(source.baseImpl->isLoaded());
+
+    test.run();
+}
+
+namespace {
+
+// The ids of the features in a tile of a source, as last laid out.
+std::vector<FeatureIdentifier> tileFeatureIDs(Source& source, const CanonicalTileID& tileID) {
+    std::vector<style::SourceTileQuery> tiles;
+    source.baseImpl->snapshotSourceTiles({}, tiles);
+
+    std::vector<FeatureIdentifier> result;
+    for (const auto& tile : tiles) {
+        if (tile.id == tileID) {
+            auto layer = tile.data->getLayer(source.getID());
+            for (std::size_t i = 0; i < layer->featureCount(); i++) {
+                result.push_back(*layer->getFeature(i)->getID());
+            }
+        }
+    }
+
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+std::vector<FeatureIdentifier> ids(std::initializer_list<uint64_t> values) {
+    std::vector<FeatureIdentifier> result;
+    for (uint64_t value : values) {
+        result.emplace_back(value);
+    }
+    return result;
+}
+
+Feature pointFeature(double lon, double lat, uint64_t id) {
+    return Feature{ mapbox::geometry::point<double>{ lon, lat }, {}, FeatureIdentifier{ id } };
+}
+
+// The four tiles at zoom level 1 each hold one of these points, and none of the others
+// within their buffers.
+const CanonicalTileID northwest { 1, 0, 0 };
+const CanonicalTileID northeast { 1, 1, 0 };
+const CanonicalTileID southwest { 1, 0, 1 };
+const CanonicalTileID southeast { 1, 1, 1 };
+
+} // namespace
+
+TEST(Source, GeoJSONSourceFeatureUpdates) {
+    SourceTest test;
+    test.transform.setLatLngZoom({ 0, 0 }, 1);
+    test.transformState = test.transform.getState();
+
+    GeoJSONSource source("source");
+    source.baseImpl->setObserver(&test.observer);
+
+    test.observer.sourceError = [&] (Source&, std::exception_ptr error) {
+        FAIL() << util::toString(error);
+    };
+
+    test.observer.sourceLoaded = [&] (Source&) {
+        source.baseImpl->updateTiles(test.updateParameters);
+    };
+
+    // Tiles that changed since the last step, and the steps to take once all tiles are
+    // complete again.
+    std::set<CanonicalTileID> changed;
+    std::vector<std::function<void ()>> steps;
+
+    test.observer.tileChanged = [&] (Source&, const OverscaledTileID& tileID) {
+        changed.insert(tileID.canonical);
+        if (!source.baseImpl->isLoaded() || steps.empty()) {
+            return;
+        }
+        auto step = std::move(steps.front());
+        steps.erase(steps.begin());
+        step();
+        changed.clear();
+    };
+
+    steps.push_back([&] {
+        // Updates made before the source was loaded are applied on top of its data.
+        EXPECT_EQ(4u, changed.size());
+        EXPECT_EQ(ids({}), tileFeatureIDs(source, northwest));
+        EXPECT_EQ(ids({ 1 }), tileFeatureIDs(source, northeast));
+        EXPECT_EQ(ids({ 2 }), tileFeatureIDs(source, southwest));
+        EXPECT_EQ(ids({ 3 }), tileFeatureIDs(source, southeast));
+
+        // Incremental updates on a loaded source don't reload it.
+        test.observer.sourceLoaded = [&] (Source&) {
+            FAIL() << "Should never be called";
+        };
+
+        source.updateFeatures({ pointFeature(120, 70, 1), pointFeature(110, 65, 4) });
+    });
+
+    steps.push_back([&] {
+        // Only the tile holding the updated features was given new data.
+        EXPECT_EQ(std::set<CanonicalTileID>({ northeast }), changed);
+        EXPECT_EQ(ids({ 1, 4 }), tileFeatureIDs(source, northeast));
+
+        source.removeFeatures({ FeatureIdentifier{ uint64_t(2) } });
+    });
+
+    steps.push_back([&] {
+        EXPECT_EQ(std::set<CanonicalTileID>({ southwest }), changed);
+        EXPECT_EQ(ids({}), tileFeatureIDs(source, southwest));
+        EXPECT_EQ(ids({ 1, 4 }), tileFeatureIDs(source, northeast));
+        EXPECT_EQ(ids({ 3 }), tileFeatureIDs(source, southeast));
+
+        test.end();
+    });
+
+    FeatureCollection features;
+    features.push_back(pointFeature(100, 60, 1));
+    features.push_back(pointFeature(-100, -60, 2));
+    source.setGeoJSON(features);
+    source.updateFeatures({ pointFeature(100, -60, 3) });
+
+    source.baseImpl->loadDescription(test.fileSource, test.threadPool);
+
+    test.run();
+
+    EXPECT_TRUE(steps.empty());
+}
+
+TEST(Source, GeoJSONSourceFeatureUpdatesWhileFetching) {
+    SourceTest test;
+    test.transform.setLatLngZoom({ 0, 0 }, 1);
+    test.transformState = test.transform.getState();
+
+    test.fileSource.sourceResponse = [&] (const Resource& resource) {
+        EXPECT_EQ("url", resource.url);
+        Response response;
+        response.data = std::make_unique<std::string>(R"JSON({ "type": "FeatureCollection", "features": [
+            { "type": "Feature", "id": 1, "properties": {}, "geometry": { "type": "Point", "coordinates": [100, 60] } }
+        ] })JSON");
+        return response;
+    };
+
+    GeoJSONSource source("source");
+    source.baseImpl->setObserver(&test.observer);
+
+    test.observer.sourceError = [&] (Source&, std::exception_ptr error) {
+        FAIL() << util::toString(error);
+    };
+
+    test.observer.sourceLoaded = [&] (Source&) {
+        source.baseImpl->updateTiles(test.updateParameters);
+    };
+
+    test.observer.tileChanged = [&] (Source&, const OverscaledTileID&) {
+        if (!source.baseImpl->isLoaded()) {
+            return;
+        }
+
+        // Updates made while the data was being fetched are applied on top of it, and updates
+        // made before the URL changed are dropped.
+        EXPECT_EQ(ids({ 1 }), tileFeatureIDs(source, northeast));
+        EXPECT_EQ(ids({ 2 }), tileFeatureIDs(source, southwest));
+        EXPECT_EQ(ids({}), tileFeatureIDs(source, southeast));
+        test.end();
+    };
+
+    source.setURL("previous");
+    source.updateFeatures({ pointFeature(100, -60, 3) });
+    source.setURL("url");
+
+    source.baseImpl->loadDescription(test.fileSource, test.threadPool);
+    source.updateFeatures({ pointFeature(-100, -60, 2) });
+
+    test.run();
+}
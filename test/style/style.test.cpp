@@ -1,12 +1,17 @@
 #include <mbgl/test/util.hpp>
 #include <mbgl/test/stub_file_source.hpp>
+#include <mbgl/test/stub_style_observer.hpp>
 
 #include <mbgl/style/style.hpp>
 #include <mbgl/style/source_impl.hpp>
 #include <mbgl/style/sources/vector_source.hpp>
+#include <mbgl/style/sources/geojson_source.hpp>
 #include <mbgl/style/layer.hpp>
+#include <mbgl/style/layers/fill_layer.hpp>
+#include <mbgl/style/layers/fill_layer_impl.hpp>
 #include <mbgl/util/io.hpp>
 #include <mbgl/util/run_loop.hpp>
+#include <mbgl/util/default_thread_pool.hpp>
 
 #include <memory>
 
@@ -17,7 +22,8 @@ TEST(Style, UnusedSource) {
     util::RunLoop loop;
 
     StubFileSource fileSource;
-    Style style { fileSource, 1.0 };
+    ThreadPool threadPool { 1 };
+    Style style { threadPool, fileSource, 1.0 };
 
     auto now = Clock::now();
 
@@ -54,7 +60,8 @@ TEST(Style, UnusedSourceActiveViaClassUpdate) {
     util::RunLoop loop;
 
     StubFileSource fileSource;
-    Style style { fileSource, 1.0 };
+    ThreadPool threadPool { 1 };
+    Style style { threadPool, fileSource, 1.0 };
 
     style.setJSON(util::read_file("test/fixtures/resources/style-unused-sources.json"));
     EXPECT_TRUE(style.addClass("visible"));
@@ -87,7 +94,8 @@ TEST(Style, Properties) {
     util::RunLoop loop;
 
     StubFileSource fileSource;
-    Style style { fileSource, 1.0 };
+    ThreadPool threadPool { 1 };
+    Style style { threadPool, fileSource, 1.0 };
 
     style.setJSON(R"STYLE({"name": "Test"})STYLE");
     ASSERT_EQ("Test", style.getName());
@@ -117,11 +125,200 @@ TEST(Style, Properties) {
     ASSERT_EQ(0, style.getDefaultPitch());
 }
 
+TEST(Style, ReplaceKeepsUnchangedSourcesAndLayers) {
+    util::RunLoop loop;
+
+    StubFileSource fileSource;
+    ThreadPool threadPool { 1 };
+    Style style { threadPool, fileSource, 1.0 };
+
+    style.setJSON(R"STYLE({
+        "sources": {
+            "streets": { "type": "vector", "tiles": [ "http://example.com/{z}-{x}-{y}.vector.pbf" ] },
+            "terrain": { "type": "vector", "tiles": [ "http://example.com/terrain/{z}-{x}-{y}.vector.pbf" ] }
+        },
+        "layers": [
+            { "id": "water", "type": "fill", "source": "streets", "source-layer": "water", "paint": { "fill-color": "blue" } },
+            { "id": "parks", "type": "fill", "source": "streets", "source-layer": "parks" },
+            { "id": "hills", "type": "fill", "source": "terrain", "source-layer": "hills" },
+            { "id": "roads", "type": "line", "source": "streets", "source-layer": "roads" }
+        ]
+    })STYLE");
+
+    Source* streets = style.getSource("streets");
+    Source* terrain = style.getSource("terrain");
+    Layer* water = style.getLayer("water");
+    Layer* parks = style.getLayer("parks");
+    Layer* hills = style.getLayer("hills");
+
+    style.setJSON(R"STYLE({
+        "sources": {
+            "streets": { "type": "vector", "tiles": [ "http://example.com/{z}-{x}-{y}.vector.pbf" ] },
+            "terrain": { "type": "vector", "tiles": [ "http://example.com/terrain-v2/{z}-{x}-{y}.vector.pbf" ] }
+        },
+        "layers": [
+            { "id": "water", "type": "fill", "source": "streets", "source-layer": "water", "paint": { "fill-color": "black" } },
+            { "id": "parks", "type": "fill", "source": "streets", "source-layer": "parks", "filter": ["==", "kind", "park"] },
+            { "id": "hills", "type": "fill", "source": "terrain", "source-layer": "hills" }
+        ]
+    })STYLE");
+
+    // Sources with identical definitions survive; changed ones are replaced.
+    EXPECT_EQ(streets, style.getSource("streets"));
+    EXPECT_NE(terrain, style.getSource("terrain"));
+
+    // Paint-only changes are applied to the existing layer.
+    ASSERT_EQ(water, style.getLayer("water"));
+    EXPECT_EQ(DataDrivenPropertyValue<Color>(Color::black()), water->as<FillLayer>()->getFillColor());
+
+    // Layers that lay out differently are replaced; unchanged ones are kept.
+    EXPECT_NE(parks, style.getLayer("parks"));
+    EXPECT_EQ(hills, style.getLayer("hills"));
+    EXPECT_FALSE(style.getLayer("roads"));
+    EXPECT_EQ(3u, style.getLayers().size());
+}
+
+TEST(Style, ReplaceReloadsChangedSources) {
+    util::RunLoop loop;
+
+    StubFileSource fileSource;
+    ThreadPool threadPool { 1 };
+    Style style { threadPool, fileSource, 1.0 };
+
+    const std::string json = R"STYLE({
+        "sources": {
+            "data": { "type": "geojson", "data": { "type": "FeatureCollection", "features": [] } },
+            "url": { "type": "geojson", "data": "http://example.com/url.geojson" },
+            "updated": { "type": "geojson", "data": { "type": "FeatureCollection", "features": [] } },
+            "unchanged": { "type": "geojson", "data": { "type": "FeatureCollection", "features": [] } }
+        },
+        "layers": []
+    })STYLE";
+
+    style.setJSON(json);
+
+    Source* data = style.getSource("data");
+    Source* url = style.getSource("url");
+    Source* updated = style.getSource("updated");
+    Source* unchanged = style.getSource("unchanged");
+
+    data->as<GeoJSONSource>()->setGeoJSON(mapbox::geometry::point<double>(1, 2));
+    url->as<GeoJSONSource>()->setURL("http://example.com/other.geojson");
+    updated->as<GeoJSONSource>()->updateFeatures({ mapbox::geometry::feature<double> { mapbox::geometry::point<double>(1, 2) } });
+
+    // Sources changed at runtime no longer hold what the style declares, so they're replaced.
+    style.setJSON(json);
+
+    EXPECT_NE(data, style.getSource("data"));
+    ASSERT_NE(url, style.getSource("url"));
+    EXPECT_EQ(std::string("http://example.com/url.geojson"), *style.getSource("url")->as<GeoJSONSource>()->getURL());
+    EXPECT_NE(updated, style.getSource("updated"));
+    EXPECT_EQ(unchanged, style.getSource("unchanged"));
+
+    // The replacements are reused again as long as they aren't changed.
+    data = style.getSource("data");
+    style.setJSON(json);
+    EXPECT_EQ(data, style.getSource("data"));
+}
+
+TEST(Style, SetJSONAsync) {
+    util::RunLoop loop;
+
+    StubFileSource fileSource;
+    ThreadPool threadPool { 1 };
+    Style style { threadPool, fileSource, 1.0 };
+
+    StubStyleObserver observer;
+    observer.styleLoaded = [&] {
+        // The superseded parse must never be applied.
+        EXPECT_EQ("Second", style.getName());
+        EXPECT_TRUE(style.getSource("vectorsource"));
+        EXPECT_TRUE(style.getLayer("background"));
+        loop.stop();
+    };
+    style.setObserver(&observer);
+
+    style.setJSONAsync(R"STYLE({"name": "First", "sources": {}, "layers": []})STYLE");
+    style.setJSONAsync(R"STYLE({
+        "name": "Second",
+        "sources": { "vectorsource": { "type": "vector", "tiles": [ "http://example.com/{z}-{x}-{y}.vector.pbf" ] } },
+        "layers": [ { "id": "background", "type": "background" } ]
+    })STYLE");
+
+    // Nothing is applied until the worker hands back the parsed style.
+    EXPECT_FALSE(style.getLayer("background"));
+
+    loop.run();
+}
+
+TEST(Style, SetJSONAsyncError) {
+    util::RunLoop loop;
+
+    StubFileSource fileSource;
+    ThreadPool threadPool { 1 };
+    Style style { threadPool, fileSource, 1.0 };
+
+    StubStyleObserver observer;
+    observer.styleError = [&] {
+        EXPECT_TRUE(style.getLayers().empty());
+        loop.stop();
+    };
+    style.setObserver(&observer);
+
+    style.setJSONAsync("invalid");
+
+    loop.run();
+}
+
+TEST(Style, RecalculateSkipsCurrentLayers) {
+    util::RunLoop loop;
+
+    StubFileSource fileSource;
+    ThreadPool threadPool { 1 };
+    Style style { threadPool, fileSource, 1.0 };
+
+    style.setJSON(R"STYLE({
+        "layers": [
+            { "id": "constant", "type": "fill", "paint": { "fill-color": "red" } },
+            { "id": "zoomed", "type": "fill", "paint": { "fill-color": { "stops": [[0, "red"], [10, "blue"]] } } }
+        ]
+    })STYLE");
+
+    auto now = Clock::now();
+    style.cascade(now, MapMode::Still);
+    style.recalculate(1, now, MapMode::Still);
+
+    auto& constant = style.getLayer("constant")->as<FillLayer>()->impl->paint.evaluated.get<FillColor>();
+    auto& zoomed = style.getLayer("zoomed")->as<FillLayer>()->impl->paint.evaluated.get<FillColor>();
+    EXPECT_EQ(Color::red(), constant.constantOr(Color()));
+
+    // Overwrite the evaluated values to observe which layers are evaluated again.
+    constant = PossiblyEvaluatedPropertyValue<Color>(Color::black());
+    zoomed = PossiblyEvaluatedPropertyValue<Color>(Color::black());
+
+    // Only zoom-dependent layers are re-evaluated when the zoom changes...
+    style.recalculate(2, now, MapMode::Still);
+    EXPECT_EQ(Color::black(), constant.constantOr(Color()));
+    EXPECT_NE(Color::black(), zoomed.constantOr(Color()));
+
+    // ...and nothing is re-evaluated when it doesn't.
+    zoomed = PossiblyEvaluatedPropertyValue<Color>(Color::black());
+    style.recalculate(2, now, MapMode::Still);
+    EXPECT_EQ(Color::black(), zoomed.constantOr(Color()));
+
+    // Cascading makes every layer current again.
+    style.cascade(now, MapMode::Still);
+    style.recalculate(2, now, MapMode::Still);
+    EXPECT_EQ(Color::red(), constant.constantOr(Color()));
+    EXPECT_NE(Color::black(), zoomed.constantOr(Color()));
+}
+
 TEST(Style, DuplicateSource) {
     util::RunLoop loop;
 
     StubFileSource fileSource;
-    Style style { fileSource, 1.0 };
+    ThreadPool threadPool { 1 };
+    Style style { threadPool, fileSource, 1.0 };
 
     style.setJSON(util::read_file("test/fixtures/resources/style-unused-sources.json"));
 
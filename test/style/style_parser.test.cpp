@@ -2,7 +2,9 @@
 #include <mbgl/test/fixture_log_observer.hpp>
 
 #include <mbgl/style/parser.hpp>
+#include <mbgl/style/binary_style.hpp>
 #include <mbgl/util/io.hpp>
+#include <mbgl/util/rapidjson.hpp>
 #include <mbgl/util/enum.hpp>
 #include <mbgl/util/string.hpp>
 #include <mbgl/util/tileset.hpp>
@@ -11,6 +13,7 @@
 
 #include <iostream>
 #include <fstream>
+#include <functional>
 
 #include <dirent.h>
 
@@ -21,8 +24,8 @@ typedef std::vector<Message> Messages;
 
 class StyleParserTest : public ::testing::TestWithParam<std::string> {};
 
-TEST_P(StyleParserTest, ParseStyle) {
-    const std::string base = std::string("test/fixtures/style_parser/") + GetParam();
+// Parses a fixture's style and checks that exactly the expected messages are logged.
+void checkFixture(const std::string& base, std::function<style::StyleParseResult (style::Parser&, const std::string&)> parse) {
 
     rapidjson::GenericDocument<rapidjson::UTF8<>, rapidjson::CrtAllocator> infoDoc;
     infoDoc.Parse<0>(util::read_file(base + ".info.json").c_str());
@@ -33,7 +36,7 @@ TEST_P(StyleParserTest, ParseStyle) {
     Log::setObserver(std::unique_ptr<Log::Observer>(observer));
 
     style::Parser parser;
-    auto error = parser.parse(util::read_file(base + ".style.json"));
+    auto error = parse(parser, util::read_file(base + ".style.json"));
 
     if (error) {
         Log::Error(Event::ParseStyle, "Failed to parse style: %s", util::toString(error).c_str());
@@ -73,6 +76,27 @@ TEST_P(StyleParserTest, ParseStyle) {
     }
 }
 
+TEST_P(StyleParserTest, ParseStyle) {
+    checkFixture(std::string("test/fixtures/style_parser/") + GetParam(), [] (style::Parser& parser, const std::string& json) {
+        return parser.parse(json);
+    });
+}
+
+TEST_P(StyleParserTest, ParseBinaryStyle) {
+    const std::string base = std::string("test/fixtures/style_parser/") + GetParam();
+
+    try {
+        style::encodeBinaryStyle(util::read_file(base + ".style.json"));
+    } catch (const std::runtime_error&) {
+        // Malformed JSON can't be encoded; ParseStyle covers how it's reported.
+        return;
+    }
+
+    checkFixture(base, [] (style::Parser& parser, const std::string& json) {
+        return parser.parseBinary(style::encodeBinaryStyle(json));
+    });
+}
+
 INSTANTIATE_TEST_CASE_P(StyleParser, StyleParserTest, ::testing::ValuesIn([] {
     std::vector<std::string> names;
     const std::string ending = ".info.json";
@@ -102,3 +126,32 @@ TEST(StyleParser, FontStacks) {
     ASSERT_EQ(FontStack({"a", "b"}), result[1]);
     ASSERT_EQ(FontStack({"a", "b", "c"}), result[2]);
 }
+
+TEST(StyleParser, BinaryStyleRoundTrip) {
+    const std::string json = util::read_file("test/fixtures/style_parser/font_stacks.json");
+    const std::string binary = style::encodeBinaryStyle(json);
+
+    JSDocument original;
+    original.Parse<0>(json.c_str());
+    JSDocument decoded;
+    decoded.Parse<0>(style::decodeBinaryStyle(binary).c_str());
+    ASSERT_FALSE(decoded.HasParseError());
+    EXPECT_TRUE(original == decoded);
+
+    style::Parser jsonParser;
+    jsonParser.parse(json);
+    style::Parser binaryParser;
+    EXPECT_EQ(nullptr, binaryParser.parseBinary(binary));
+    EXPECT_EQ(jsonParser.fontStacks(), binaryParser.fontStacks());
+}
+
+TEST(StyleParser, BinaryStyleErrors) {
+    EXPECT_THROW(style::encodeBinaryStyle("{ \"version\": "), std::runtime_error);
+    EXPECT_THROW(style::decodeBinaryStyle("{}"), std::runtime_error);
+
+    const std::string binary = style::encodeBinaryStyle(R"({ "version": 8, "sources": {}, "layers": [] })");
+    style::Parser parser;
+    EXPECT_NE(nullptr, parser.parseBinary(binary.substr(0, binary.size() - 1)));
+    EXPECT_NE(nullptr, parser.parseBinary(binary + '\0'));
+    EXPECT_NE(nullptr, parser.parseBinary("MBSB"));
+}
@@ -0,0 +1,84 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/text/collision_grid.hpp>
+
+#include <algorithm>
+#include <random>
+
+using namespace mbgl;
+
+namespace {
+
+bool intersects(const CollisionGrid::Bounds& a, const CollisionGrid::Bounds& b) {
+    return a.x1 <= b.x2 && a.y1 <= b.y2 && a.x2 >= b.x1 && a.y2 >= b.y1;
+}
+
+CollisionGrid::Bounds boundsAtScale(const CollisionBox& box, float scale) {
+    return { box.anchor.x + box.x1 / scale, box.anchor.y + box.y1 / scale,
+             box.anchor.x + box.x2 / scale, box.anchor.y + box.y2 / scale };
+}
+
+} // namespace
+
+TEST(CollisionGrid, MatchesExhaustiveSearch) {
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> position(-2000, 10000);
+    std::uniform_real_distribution<float> offset(-300, 300);
+    std::uniform_real_distribution<float> scales(0.5, 2);
+
+    CollisionGrid grid({ 0, 0, 8192, 8192 }, 256);
+    std::vector<CollisionBox> boxes;
+
+    for (uint32_t i = 0; i < 2000; i++) {
+        const float x1 = offset(rng), x2 = offset(rng), y1 = offset(rng), y2 = offset(rng);
+        boxes.emplace_back(Point<float>(position(rng), position(rng)),
+                           std::min(x1, x2), std::min(y1, y2), std::max(x1, x2), std::max(y1, y2), 2);
+        grid.insert(boxes.back(), boxes.back().anchor, boundsAtScale(boxes.back(), 1), i);
+    }
+
+    for (int i = 0; i < 200; i++) {
+        const float x = position(rng), y = position(rng);
+        const CollisionGrid::Bounds query { x, y, x + 500, y + 200 };
+
+        std::vector<uint32_t> found;
+        grid.query(query, [&] (const CollisionGrid::Entry& entry) {
+            found.push_back(entry.featureID);
+            return true;
+        });
+        std::sort(found.begin(), found.end());
+
+        std::vector<uint32_t> expected;
+        for (uint32_t j = 0; j < boxes.size(); j++) {
+            if (intersects(boundsAtScale(boxes[j], 1), query)) {
+                expected.push_back(j);
+            }
+        }
+        EXPECT_EQ(expected, found);
+
+        // Queries at other scales may return extra boxes, but never miss one.
+        const float scale = scales(rng);
+        std::vector<uint32_t> candidates;
+        for (const auto* entry : grid.queryAtScale(query, scale)) {
+            candidates.push_back(entry->featureID);
+        }
+        EXPECT_TRUE(std::is_sorted(candidates.begin(), candidates.end()));
+        for (uint32_t j = 0; j < boxes.size(); j++) {
+            if (intersects(boundsAtScale(boxes[j], scale), query)) {
+                EXPECT_TRUE(std::binary_search(candidates.begin(), candidates.end(), j));
+            }
+        }
+    }
+}
+
+TEST(CollisionGrid, QueryStopsEarly) {
+    CollisionGrid grid({ 0, 0, 8192, 8192 }, 256);
+    for (uint32_t i = 0; i < 10; i++) {
+        grid.insert(CollisionBox({ 100, 100 }, -10, -10, 10, 10, 2), { 100, 100 }, { 90, 90, 110, 110 }, i);
+    }
+
+    std::size_t visited = 0;
+    grid.query({ 0, 0, 200, 200 }, [&] (const CollisionGrid::Entry&) {
+        return ++visited < 3;
+    });
+    EXPECT_EQ(3u, visited);
+}
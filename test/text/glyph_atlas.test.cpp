@@ -8,6 +8,9 @@
 #include <mbgl/util/string.hpp>
 #include <mbgl/util/io.hpp>
 #include <mbgl/util/logging.hpp>
+#include <mbgl/util/default_thread_pool.hpp>
+
+#include <future>
 
 using namespace mbgl;
 
@@ -16,7 +19,8 @@ public:
     util::RunLoop loop;
     StubFileSource fileSource;
     StubStyleObserver observer;
-    GlyphAtlas glyphAtlas{ { 32, 32 }, fileSource };
+    ThreadPool threadPool { 1 };
+    GlyphAtlas glyphAtlas{ { 32, 32 }, fileSource, threadPool };
 
     void run(const std::string& url, const FontStack& fontStack, const GlyphRangeSet& glyphRanges) {
         // Squelch logging.
@@ -182,3 +186,53 @@ TEST(GlyphAtlas, InvalidSDFGlyph) {
     ASSERT_EQ((Rect<uint16_t>{ 0, 0, 0, 0 }), positions[67].rect);
 
 }
+
+TEST(GlyphAtlas, EvictsUnusedGlyphs) {
+    Log::setObserver(std::make_unique<Log::NullObserver>());
+
+    // Each glyph is packed into a 20x20 rect, so the 32x32 test atlas holds only one.
+    GlyphSet glyphSet;
+    glyphSet.insert(65, SDFGlyph{ 65 /* ASCII 'A' */, std::string(16 * 16, 'a'), { 10, 10, 0, 0, 10 } });
+    glyphSet.insert(66, SDFGlyph{ 66 /* ASCII 'B' */, std::string(16 * 16, 'b'), { 10, 10, 0, 0, 10 } });
+
+    const FontStack fontStack{ "Mock Font" };
+
+    GlyphAtlasTest test;
+
+    GlyphPositions first;
+    test.glyphAtlas.addGlyphs(1, u"A", fontStack, glyphSet, first);
+    ASSERT_EQ((Rect<uint16_t>{ 0, 0, 20, 20 }), first.at(65).rect);
+
+    // 'B' doesn't fit while tile 1 still uses 'A'.
+    GlyphPositions second;
+    test.glyphAtlas.addGlyphs(2, u"B", fontStack, glyphSet, second);
+    ASSERT_EQ((Rect<uint16_t>{ 0, 0, 0, 0 }), second.at(66).rect);
+
+    // Unused glyphs stay in the atlas and are reused by the next tile that needs them.
+    test.glyphAtlas.removeGlyphs(1);
+    GlyphPositions third;
+    test.glyphAtlas.addGlyphs(3, u"A", fontStack, glyphSet, third);
+    ASSERT_EQ((Rect<uint16_t>{ 0, 0, 20, 20 }), third.at(65).rect);
+
+    // Once 'A' is unused again, it is evicted to make room for 'B'.
+    test.glyphAtlas.removeGlyphs(3);
+    GlyphPositions fourth;
+    test.glyphAtlas.addGlyphs(4, u"B", fontStack, glyphSet, fourth);
+    ASSERT_EQ((Rect<uint16_t>{ 0, 0, 20, 20 }), fourth.at(66).rect);
+}
+
+TEST(GlyphAtlas, LocksOnlyRequestedFontStack) {
+    GlyphAtlasTest test;
+
+    auto held = test.glyphAtlas.getGlyphSet({{"Held Stack"}});
+
+    // Another thread can add glyphs for a different font stack while this one is held.
+    std::async(std::launch::async, [&] {
+        std::vector<SDFGlyph> glyphs;
+        glyphs.push_back(SDFGlyph{ 65 /* ASCII 'A' */, "", { 0, 0, 0, 0, 20 } });
+        test.glyphAtlas.insertGlyphs({{"Other Stack"}}, std::move(glyphs));
+    }).get();
+
+    EXPECT_TRUE(held->getSDFs().empty());
+    EXPECT_EQ(1u, test.glyphAtlas.getGlyphSet({{"Other Stack"}})->getSDFs().size());
+}
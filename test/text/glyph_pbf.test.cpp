@@ -6,6 +6,7 @@
 #include <mbgl/text/glyph_pbf.hpp>
 #include <mbgl/storage/default_file_source.hpp>
 #include <mbgl/util/run_loop.hpp>
+#include <mbgl/util/default_thread_pool.hpp>
 #include <mbgl/util/string.hpp>
 
 #include <future>
@@ -34,7 +35,8 @@ public:
 TEST(GlyphPBF, Parsing) {
     util::RunLoop loop;
     DefaultFileSource fileSource{ ":memory:", "." };
-    GlyphAtlas glyphAtlas{ { 1024, 1024 }, fileSource };
+    ThreadPool threadPool{ 1 };
+    GlyphAtlas glyphAtlas{ { 1024, 1024 }, fileSource, threadPool };
     FontStack fontStack{ "fake_glyphs" };
     GlyphRange glyphRange{ 0, 255 };
 
@@ -65,7 +67,7 @@ TEST(GlyphPBF, Parsing) {
         FAIL() << util::toString(error);
     };
 
-    GlyphPBF pbf(&glyphAtlas, fontStack, glyphRange, &glyphAtlasObserver, fileSource);
+    GlyphPBF pbf(&glyphAtlas, fontStack, glyphRange, &glyphAtlasObserver, fileSource, threadPool);
 
     loop.run();
 }
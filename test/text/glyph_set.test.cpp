@@ -0,0 +1,69 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/text/bidi.hpp>
+#include <mbgl/text/glyph_set.hpp>
+
+#include <map>
+
+using namespace mbgl;
+
+namespace {
+
+GlyphSet ideographs() {
+    GlyphSet glyphSet;
+    for (char16_t id = u'一'; id < u'一' + 32; id++) {
+        glyphSet.insert(id, SDFGlyph{ id, "", { 0, 0, 0, 0, 24 /* advance */ } });
+    }
+    return glyphSet;
+}
+
+// Returns the number of glyphs on each line, top to bottom.
+std::vector<std::size_t> lineLengths(const Shaping& shaping) {
+    std::map<float, std::size_t> lines;
+    for (const auto& glyph : shaping.positionedGlyphs) {
+        lines[glyph.y]++;
+    }
+
+    std::vector<std::size_t> result;
+    for (const auto& line : lines) {
+        result.push_back(line.second);
+    }
+    return result;
+}
+
+Shaping shape(const GlyphSet& glyphSet, const std::u16string& text, float maxWidth) {
+    BiDi bidi;
+    return glyphSet.getShaping(text, maxWidth, 24 /* lineHeight */, 0.5, 0.5, 0.5, 0 /* spacing */,
+                               { 0, 0 }, bidi);
+}
+
+} // namespace
+
+TEST(GlyphSet, BalancesIdeographicLines) {
+    const GlyphSet glyphSet = ideographs();
+
+    // Ten glyphs that don't fit in five glyphs' width are split evenly, not five, five and none.
+    EXPECT_EQ((std::vector<std::size_t>{ 5, 5 }), lineLengths(shape(glyphSet, u"一丁丂七丄丅丆万丈三", 5 * 24)));
+
+    // Nine glyphs in four glyphs' width: three lines of three.
+    EXPECT_EQ((std::vector<std::size_t>{ 3, 3, 3 }), lineLengths(shape(glyphSet, u"一丁丂七丄丅丆万丈", 4 * 24)));
+
+    // Without a maximum width, text isn't broken.
+    EXPECT_EQ((std::vector<std::size_t>{ 9 }), lineLengths(shape(glyphSet, u"一丁丂七丄丅丆万丈", 0)));
+}
+
+TEST(GlyphSet, LongLabelLineBreaks) {
+    const GlyphSet glyphSet = ideographs();
+
+    // A long label without spaces is broken into lines that fill the maximum width.
+    std::u16string text;
+    for (std::size_t i = 0; i < 200; i++) {
+        text.push_back(u'一' + i % 32);
+    }
+
+    const std::vector<std::size_t> lengths = lineLengths(shape(glyphSet, text, 10 * 24));
+    ASSERT_EQ(20u, lengths.size());
+    for (std::size_t length : lengths) {
+        EXPECT_EQ(10u, length);
+    }
+}
@@ -0,0 +1,62 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/text/shaping_cache.hpp>
+
+using namespace mbgl;
+
+namespace {
+
+ShapingKey key(std::u16string text, FontStack fontStack = { "Test Stack" }) {
+    return { std::move(text), std::move(fontStack), 240, 28.8f, 0.5f, 0.5f, 0.5f, 0, { 0, 0 } };
+}
+
+Shaping shaping(std::u16string text) {
+    Shaping result(0, 0, text);
+    result.positionedGlyphs.emplace_back(text.front(), 0, 0);
+    return result;
+}
+
+} // namespace
+
+TEST(ShapingCache, HitsAndMisses) {
+    ShapingCache cache;
+
+    EXPECT_FALSE(cache.get(key(u"Main Street")));
+    cache.add(key(u"Main Street"), shaping(u"Main Street"));
+
+    auto cached = cache.get(key(u"Main Street"));
+    ASSERT_TRUE(bool(cached));
+    EXPECT_EQ(u"Main Street", cached->text);
+
+    // Any difference in the shaping parameters is a different entry.
+    ShapingKey wider = key(u"Main Street");
+    wider.maxWidth = 480;
+    EXPECT_FALSE(cache.get(wider));
+
+    EXPECT_EQ(1u, cache.getStats().hits);
+    EXPECT_EQ(2u, cache.getStats().misses);
+}
+
+TEST(ShapingCache, EvictsLeastRecentlyUsed) {
+    ShapingCache cache(2);
+
+    cache.add(key(u"A"), shaping(u"A"));
+    cache.add(key(u"B"), shaping(u"B"));
+    EXPECT_TRUE(bool(cache.get(key(u"A"))));
+
+    cache.add(key(u"C"), shaping(u"C"));
+    EXPECT_TRUE(bool(cache.get(key(u"A"))));
+    EXPECT_FALSE(cache.get(key(u"B")));
+    EXPECT_TRUE(bool(cache.get(key(u"C"))));
+}
+
+TEST(ShapingCache, InvalidateFontStack) {
+    ShapingCache cache;
+
+    cache.add(key(u"A", { "Regular" }), shaping(u"A"));
+    cache.add(key(u"A", { "Bold" }), shaping(u"A"));
+
+    cache.invalidate({ "Regular" });
+    EXPECT_FALSE(cache.get(key(u"A", { "Regular" })));
+    EXPECT_TRUE(bool(cache.get(key(u"A", { "Bold" }))));
+}
@@ -9,8 +9,10 @@
 #include <mbgl/map/transform.hpp>
 #include <mbgl/style/style.hpp>
 #include <mbgl/style/update_parameters.hpp>
+#include <mbgl/style/source_impl.hpp>
 #include <mbgl/style/layers/circle_layer.hpp>
 #include <mbgl/annotation/annotation_manager.hpp>
+#include <mbgl/text/collision_tile.hpp>
 
 #include <memory>
 
@@ -24,7 +26,7 @@ public:
     util::RunLoop loop;
     ThreadPool threadPool { 1 };
     AnnotationManager annotationManager { 1.0 };
-    style::Style style { fileSource, 1.0 };
+    style::Style style { threadPool, fileSource, 1.0 };
     Tileset tileset { { "https://example.com" }, { 0, 22 }, "none" };
 
     style::UpdateParameters updateParameters {
@@ -70,3 +72,76 @@ TEST(GeoJSONTile, Issue7648) {
         test.loop.runOnce();
     }
 }
+
+TEST(GeoJSONTile, ReusesPlacement) {
+    GeoJSONTileTest test;
+    GeoJSONTile tile(OverscaledTileID(0, 0, 0), "source", test.updateParameters);
+
+    test.style.addLayer(std::make_unique<CircleLayer>("circle", "source"));
+
+    mapbox::geometry::feature_collection<int16_t> features;
+    features.push_back(mapbox::geometry::feature<int16_t> {
+        mapbox::geometry::point<int16_t>(0, 0)
+    });
+
+    tile.setPlacementConfig({});
+    tile.updateData(features);
+    while (!tile.isComplete()) {
+        test.loop.runOnce();
+    }
+
+    tile.setPlacementConfig({ 1.0f, 0.0f });
+    EXPECT_FALSE(tile.isComplete());
+    while (!tile.isComplete()) {
+        test.loop.runOnce();
+    }
+
+    // Returning to a config that was placed before doesn't wait for the worker.
+    tile.setPlacementConfig({});
+    EXPECT_TRUE(tile.isComplete());
+
+    // New data invalidates the placements made for the previous layout.
+    tile.updateData(features);
+    while (!tile.isComplete()) {
+        test.loop.runOnce();
+    }
+
+    tile.setPlacementConfig({ 1.0f, 0.0f });
+    EXPECT_FALSE(tile.isComplete());
+    while (!tile.isComplete()) {
+        test.loop.runOnce();
+    }
+
+    // While the camera moves, nearby angles and pitches share a placement.
+    Transform transform;
+    transform.resize({ 512, 512 });
+    transform.setGestureInProgress(true);
+    transform.setAngle(0.01);
+    transform.setPitch(0.3);
+    const PlacementConfig moving = Source::Impl::placementConfig(transform.getState(), MapMode::Continuous, MapDebugOptions::NoDebug);
+    transform.setAngle(0.011);
+    transform.setPitch(0.301);
+    EXPECT_EQ(moving, Source::Impl::placementConfig(transform.getState(), MapMode::Continuous, MapDebugOptions::NoDebug));
+
+    // Once the camera is at rest, symbols are placed for its exact angle and pitch.
+    transform.setGestureInProgress(false);
+    const TransformState& state = transform.getState();
+    const PlacementConfig atRest = Source::Impl::placementConfig(state, MapMode::Continuous, MapDebugOptions::NoDebug);
+    EXPECT_EQ(PlacementConfig(state.getAngle(), state.getPitch()), atRest);
+    EXPECT_NE(moving, atRest);
+
+    tile.setPlacementConfig(moving);
+    while (!tile.isComplete()) {
+        test.loop.runOnce();
+    }
+
+    tile.setPlacementConfig(atRest);
+    EXPECT_FALSE(tile.isComplete());
+    while (!tile.isComplete()) {
+        test.loop.runOnce();
+    }
+
+    auto snapshot = tile.snapshotFeatureIndex();
+    ASSERT_TRUE(snapshot && snapshot->collisionTile);
+    EXPECT_EQ(atRest, snapshot->collisionTile->config);
+}
@@ -83,3 +83,37 @@ TEST(TileCover, SanFranciscoZ0Wrapped) {
     EXPECT_EQ((std::vector<UnwrappedTileID>{ { 0, 1, 0 } }),
               util::tileCover(sanFranciscoWrapped, 0));
 }
+
+TEST(TileCount, MatchesTileCover) {
+    for (int32_t z = 0; z <= 12; z++) {
+        EXPECT_EQ(util::tileCover(sanFrancisco, z).size(), util::tileCount(sanFrancisco, z));
+        EXPECT_EQ(util::tileCover(sanFranciscoWrapped, z).size(), util::tileCount(sanFranciscoWrapped, z));
+        EXPECT_EQ(util::tileCover(LatLngBounds::world(), z).size(), util::tileCount(LatLngBounds::world(), z));
+    }
+
+    EXPECT_EQ(0u, util::tileCount(LatLngBounds::empty(), 0));
+    EXPECT_EQ(0u, util::tileCount(LatLngBounds::singleton({ 0, 0 }), 1));
+    EXPECT_EQ(0u, util::tileCount(LatLngBounds::hull({ 86, -180 }, { 90, 180 }), 3));
+}
+
+TEST(BoundsTileCover, SanFrancisco) {
+    util::BoundsTileCover cover(sanFrancisco, { 9, 10 });
+
+    std::vector<UnwrappedTileID> result;
+    while (auto tile = cover.next()) {
+        result.push_back(*tile);
+    }
+
+    EXPECT_TRUE(cover.done());
+    EXPECT_EQ((std::vector<UnwrappedTileID>{
+                  { 9, 81, 197 }, { 9, 81, 198 }, { 9, 82, 197 }, { 9, 82, 198 },
+                  { 10, 163, 395 }, { 10, 163, 396 }, { 10, 164, 395 }, { 10, 164, 396 },
+              }),
+              result);
+}
+
+TEST(BoundsTileCover, SkipsEmptyZoomLevels) {
+    util::BoundsTileCover cover(LatLngBounds::empty(), { 0, 10 });
+    EXPECT_TRUE(cover.done());
+    EXPECT_FALSE(bool(cover.next()));
+}